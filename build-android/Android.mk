@@ -33,13 +33,36 @@ LOCAL_MODULE := ImportAsset
 LOCAL_SRC_FILES := \
 	$(LOCAL_PATH)/../source/import_asset_file_input_stream.cpp \
 	$(LOCAL_PATH)/../source/import_asset_memory_input_stream.cpp \
+	$(LOCAL_PATH)/../source/import_asset_mmap_input_stream.cpp \
+	$(LOCAL_PATH)/../source/import_asset_shared_file_input_stream.cpp \
+	$(LOCAL_PATH)/../source/import_asset_archive_input_stream.cpp \
+	$(LOCAL_PATH)/../source/import_asset_compressed_input_stream.cpp \
+	$(LOCAL_PATH)/../source/import_asset_buffered_input_stream.cpp \
 	$(LOCAL_PATH)/../source/import_dds_image_asset.cpp \
 	$(LOCAL_PATH)/../source/import_pvr_image_asset.cpp \
+	$(LOCAL_PATH)/../source/internal_import_image_subresource.cpp \
+	$(LOCAL_PATH)/../source/import_ktx2_image_asset.cpp \
+	$(LOCAL_PATH)/../source/internal_import_image_block_compression.cpp \
+	$(LOCAL_PATH)/../source/internal_import_image_mip.cpp \
+	$(LOCAL_PATH)/../source/internal_import_image_resize.cpp \
 	$(LOCAL_PATH)/../source/import_gltf_scene_asset.cpp \
 	$(LOCAL_PATH)/../source/import_gltf_scene_asset_cgltf.cpp \
+	$(LOCAL_PATH)/../source/internal_import_gltf_accessor.cpp \
 	$(LOCAL_PATH)/../thirdparty/DirectXMesh/DirectXMesh/DirectXMeshNormals.cpp \
 	$(LOCAL_PATH)/../thirdparty/DirectXMesh/DirectXMesh/DirectXMeshTangentFrame.cpp \
-	$(LOCAL_PATH)/../thirdparty/McRT-Malloc/source/mcrt_malloc.cpp
+	$(LOCAL_PATH)/../thirdparty/McRT-Malloc/source/mcrt_malloc.cpp \
+	$(LOCAL_PATH)/../thirdparty/zstd/lib/common/debug.c \
+	$(LOCAL_PATH)/../thirdparty/zstd/lib/common/entropy_common.c \
+	$(LOCAL_PATH)/../thirdparty/zstd/lib/common/error_private.c \
+	$(LOCAL_PATH)/../thirdparty/zstd/lib/common/fse_decompress.c \
+	$(LOCAL_PATH)/../thirdparty/zstd/lib/common/pool.c \
+	$(LOCAL_PATH)/../thirdparty/zstd/lib/common/threading.c \
+	$(LOCAL_PATH)/../thirdparty/zstd/lib/common/xxhash.c \
+	$(LOCAL_PATH)/../thirdparty/zstd/lib/common/zstd_common.c \
+	$(LOCAL_PATH)/../thirdparty/zstd/lib/decompress/huf_decompress.c \
+	$(LOCAL_PATH)/../thirdparty/zstd/lib/decompress/zstd_ddict.c \
+	$(LOCAL_PATH)/../thirdparty/zstd/lib/decompress/zstd_decompress.c \
+	$(LOCAL_PATH)/../thirdparty/zstd/lib/decompress/zstd_decompress_block.c
 
 LOCAL_CFLAGS :=
 LOCAL_CFLAGS += -Wall
@@ -52,6 +75,7 @@ ifeq (x86_64,$(TARGET_ARCH_ABI))
 LOCAL_CFLAGS += -mbmi2
 endif
 LOCAL_CFLAGS += -DPAL_STDCPP_COMPAT=1
+LOCAL_CFLAGS += -DZSTD_DISABLE_ASM
 
 LOCAL_CPPFLAGS :=
 
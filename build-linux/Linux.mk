@@ -48,6 +48,22 @@ C_FLAGS += -I$(THIRD_PARTY_DIR)/DirectXMath/Inc
 C_FLAGS += -std=c++17
 C_FLAGS += -mbmi2
 
+# the upstream zstd is C (rather than C++)
+ZSTD_CC := clang
+
+ZSTD_C_FLAGS := 
+ZSTD_C_FLAGS += -Wall 
+ZSTD_C_FLAGS += -fPIC
+ZSTD_C_FLAGS += -pthread
+ifeq (true, $(APP_DEBUG))
+	ZSTD_C_FLAGS += -g -O0 -UNDEBUG
+else
+	ZSTD_C_FLAGS += -O2 -DNDEBUG
+endif
+ZSTD_C_FLAGS += -fvisibility=hidden
+ZSTD_C_FLAGS += -DZSTD_DISABLE_ASM
+ZSTD_C_FLAGS += -mbmi2
+
 AR_FLAGS := 
 AR_FLAGS += crsD
 
@@ -58,25 +74,71 @@ all :  \
 $(BIN_DIR)/libImportAsset.a: \
 	$(OBJ_DIR)/ImportAsset-import_asset_file_input_stream.o \
 	$(OBJ_DIR)/ImportAsset-import_asset_memory_input_stream.o \
+	$(OBJ_DIR)/ImportAsset-import_asset_mmap_input_stream.o \
+	$(OBJ_DIR)/ImportAsset-import_asset_shared_file_input_stream.o \
+	$(OBJ_DIR)/ImportAsset-import_asset_archive_input_stream.o \
+	$(OBJ_DIR)/ImportAsset-import_asset_compressed_input_stream.o \
+	$(OBJ_DIR)/ImportAsset-import_asset_buffered_input_stream.o \
 	$(OBJ_DIR)/ImportAsset-import_dds_image_asset.o \
 	$(OBJ_DIR)/ImportAsset-import_pvr_image_asset.o \
+	$(OBJ_DIR)/ImportAsset-internal_import_image_subresource.o \
+	$(OBJ_DIR)/ImportAsset-import_ktx2_image_asset.o \
+	$(OBJ_DIR)/ImportAsset-internal_import_image_block_compression.o \
+	$(OBJ_DIR)/ImportAsset-internal_import_image_mip.o \
+	$(OBJ_DIR)/ImportAsset-internal_import_image_resize.o \
 	$(OBJ_DIR)/ImportAsset-import_gltf_scene_asset.o \
 	$(OBJ_DIR)/ImportAsset-import_gltf_scene_asset_cgltf.o \
+	$(OBJ_DIR)/ImportAsset-internal_import_gltf_accessor.o \
 	$(OBJ_DIR)/ImportAsset-thirdparty-DirectXMesh-DirectXMeshNormals.o \
 	$(OBJ_DIR)/ImportAsset-thirdparty-DirectXMesh-DirectXMeshTangentFrame.o \
-	$(OBJ_DIR)/ImportAsset-thirdparty-McRT-Malloc-mcrt_malloc.o
+	$(OBJ_DIR)/ImportAsset-thirdparty-McRT-Malloc-mcrt_malloc.o \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-debug.o \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-entropy_common.o \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-error_private.o \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-fse_decompress.o \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-pool.o \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-threading.o \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-xxhash.o \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-zstd_common.o \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-huf_decompress.o \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_ddict.o \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress.o \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress_block.o
 	$(HIDE) mkdir -p $(BIN_DIR)
 	$(HIDE) $(AR) $(AR_FLAGS) \
 		$(BIN_DIR)/libImportAsset.a \
 		$(OBJ_DIR)/ImportAsset-import_asset_file_input_stream.o \
 		$(OBJ_DIR)/ImportAsset-import_asset_memory_input_stream.o \
+		$(OBJ_DIR)/ImportAsset-import_asset_mmap_input_stream.o \
+		$(OBJ_DIR)/ImportAsset-import_asset_shared_file_input_stream.o \
+		$(OBJ_DIR)/ImportAsset-import_asset_archive_input_stream.o \
+		$(OBJ_DIR)/ImportAsset-import_asset_compressed_input_stream.o \
+		$(OBJ_DIR)/ImportAsset-import_asset_buffered_input_stream.o \
 		$(OBJ_DIR)/ImportAsset-import_dds_image_asset.o \
 		$(OBJ_DIR)/ImportAsset-import_pvr_image_asset.o \
+		$(OBJ_DIR)/ImportAsset-internal_import_image_subresource.o \
+		$(OBJ_DIR)/ImportAsset-import_ktx2_image_asset.o \
+		$(OBJ_DIR)/ImportAsset-internal_import_image_block_compression.o \
+		$(OBJ_DIR)/ImportAsset-internal_import_image_mip.o \
+		$(OBJ_DIR)/ImportAsset-internal_import_image_resize.o \
 		$(OBJ_DIR)/ImportAsset-import_gltf_scene_asset.o \
 		$(OBJ_DIR)/ImportAsset-import_gltf_scene_asset_cgltf.o \
+		$(OBJ_DIR)/ImportAsset-internal_import_gltf_accessor.o \
 		$(OBJ_DIR)/ImportAsset-thirdparty-DirectXMesh-DirectXMeshNormals.o \
 		$(OBJ_DIR)/ImportAsset-thirdparty-DirectXMesh-DirectXMeshTangentFrame.o \
-		$(OBJ_DIR)/ImportAsset-thirdparty-McRT-Malloc-mcrt_malloc.o
+		$(OBJ_DIR)/ImportAsset-thirdparty-McRT-Malloc-mcrt_malloc.o \
+		$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-debug.o \
+		$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-entropy_common.o \
+		$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-error_private.o \
+		$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-fse_decompress.o \
+		$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-pool.o \
+		$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-threading.o \
+		$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-xxhash.o \
+		$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-zstd_common.o \
+		$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-huf_decompress.o \
+		$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_ddict.o \
+		$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress.o \
+		$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress_block.o
 
 # Compile
 $(OBJ_DIR)/ImportAsset-import_asset_file_input_stream.o: $(SOURCE_DIR)/import_asset_file_input_stream.cpp
@@ -87,6 +149,26 @@ $(OBJ_DIR)/ImportAsset-import_asset_memory_input_stream.o: $(SOURCE_DIR)/import_
 	$(HIDE) mkdir -p $(OBJ_DIR)
 	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/import_asset_memory_input_stream.cpp -MD -MF $(OBJ_DIR)/ImportAsset-import_asset_memory_input_stream.d -o $(OBJ_DIR)/ImportAsset-import_asset_memory_input_stream.o
 
+$(OBJ_DIR)/ImportAsset-import_asset_mmap_input_stream.o: $(SOURCE_DIR)/import_asset_mmap_input_stream.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/import_asset_mmap_input_stream.cpp -MD -MF $(OBJ_DIR)/ImportAsset-import_asset_mmap_input_stream.d -o $(OBJ_DIR)/ImportAsset-import_asset_mmap_input_stream.o
+
+$(OBJ_DIR)/ImportAsset-import_asset_shared_file_input_stream.o: $(SOURCE_DIR)/import_asset_shared_file_input_stream.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/import_asset_shared_file_input_stream.cpp -MD -MF $(OBJ_DIR)/ImportAsset-import_asset_shared_file_input_stream.d -o $(OBJ_DIR)/ImportAsset-import_asset_shared_file_input_stream.o
+
+$(OBJ_DIR)/ImportAsset-import_asset_archive_input_stream.o: $(SOURCE_DIR)/import_asset_archive_input_stream.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/import_asset_archive_input_stream.cpp -MD -MF $(OBJ_DIR)/ImportAsset-import_asset_archive_input_stream.d -o $(OBJ_DIR)/ImportAsset-import_asset_archive_input_stream.o
+
+$(OBJ_DIR)/ImportAsset-import_asset_compressed_input_stream.o: $(SOURCE_DIR)/import_asset_compressed_input_stream.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/import_asset_compressed_input_stream.cpp -MD -MF $(OBJ_DIR)/ImportAsset-import_asset_compressed_input_stream.d -o $(OBJ_DIR)/ImportAsset-import_asset_compressed_input_stream.o
+
+$(OBJ_DIR)/ImportAsset-import_asset_buffered_input_stream.o: $(SOURCE_DIR)/import_asset_buffered_input_stream.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/import_asset_buffered_input_stream.cpp -MD -MF $(OBJ_DIR)/ImportAsset-import_asset_buffered_input_stream.d -o $(OBJ_DIR)/ImportAsset-import_asset_buffered_input_stream.o
+
 $(OBJ_DIR)/ImportAsset-import_dds_image_asset.o: $(SOURCE_DIR)/import_dds_image_asset.cpp
 	$(HIDE) mkdir -p $(OBJ_DIR)
 	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/import_dds_image_asset.cpp -MD -MF $(OBJ_DIR)/ImportAsset-import_dds_image_asset.d -o $(OBJ_DIR)/ImportAsset-import_dds_image_asset.o
@@ -95,6 +177,26 @@ $(OBJ_DIR)/ImportAsset-import_pvr_image_asset.o: $(SOURCE_DIR)/import_pvr_image_
 	$(HIDE) mkdir -p $(OBJ_DIR)
 	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/import_pvr_image_asset.cpp -MD -MF $(OBJ_DIR)/ImportAsset-import_pvr_image_asset.d -o $(OBJ_DIR)/ImportAsset-import_pvr_image_asset.o
 
+$(OBJ_DIR)/ImportAsset-internal_import_image_subresource.o: $(SOURCE_DIR)/internal_import_image_subresource.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/internal_import_image_subresource.cpp -MD -MF $(OBJ_DIR)/ImportAsset-internal_import_image_subresource.d -o $(OBJ_DIR)/ImportAsset-internal_import_image_subresource.o
+
+$(OBJ_DIR)/ImportAsset-import_ktx2_image_asset.o: $(SOURCE_DIR)/import_ktx2_image_asset.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/import_ktx2_image_asset.cpp -MD -MF $(OBJ_DIR)/ImportAsset-import_ktx2_image_asset.d -o $(OBJ_DIR)/ImportAsset-import_ktx2_image_asset.o
+
+$(OBJ_DIR)/ImportAsset-internal_import_image_block_compression.o: $(SOURCE_DIR)/internal_import_image_block_compression.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/internal_import_image_block_compression.cpp -MD -MF $(OBJ_DIR)/ImportAsset-internal_import_image_block_compression.d -o $(OBJ_DIR)/ImportAsset-internal_import_image_block_compression.o
+
+$(OBJ_DIR)/ImportAsset-internal_import_image_mip.o: $(SOURCE_DIR)/internal_import_image_mip.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/internal_import_image_mip.cpp -MD -MF $(OBJ_DIR)/ImportAsset-internal_import_image_mip.d -o $(OBJ_DIR)/ImportAsset-internal_import_image_mip.o
+
+$(OBJ_DIR)/ImportAsset-internal_import_image_resize.o: $(SOURCE_DIR)/internal_import_image_resize.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/internal_import_image_resize.cpp -MD -MF $(OBJ_DIR)/ImportAsset-internal_import_image_resize.d -o $(OBJ_DIR)/ImportAsset-internal_import_image_resize.o
+
 $(OBJ_DIR)/ImportAsset-import_gltf_scene_asset.o: $(SOURCE_DIR)/import_gltf_scene_asset.cpp
 	$(HIDE) mkdir -p $(OBJ_DIR)
 	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/import_gltf_scene_asset.cpp -MD -MF $(OBJ_DIR)/ImportAsset-import_gltf_scene_asset.d -o $(OBJ_DIR)/ImportAsset-import_gltf_scene_asset.o
@@ -103,6 +205,10 @@ $(OBJ_DIR)/ImportAsset-import_gltf_scene_asset_cgltf.o: $(SOURCE_DIR)/import_glt
 	$(HIDE) mkdir -p $(OBJ_DIR)
 	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/import_gltf_scene_asset_cgltf.cpp -MD -MF $(OBJ_DIR)/ImportAsset-import_gltf_scene_asset_cgltf.d -o $(OBJ_DIR)/ImportAsset-import_gltf_scene_asset_cgltf.o
 
+$(OBJ_DIR)/ImportAsset-internal_import_gltf_accessor.o: $(SOURCE_DIR)/internal_import_gltf_accessor.cpp
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(CC) -c $(C_FLAGS) $(SOURCE_DIR)/internal_import_gltf_accessor.cpp -MD -MF $(OBJ_DIR)/ImportAsset-internal_import_gltf_accessor.d -o $(OBJ_DIR)/ImportAsset-internal_import_gltf_accessor.o
+
 $(OBJ_DIR)/ImportAsset-thirdparty-DirectXMesh-DirectXMeshNormals.o: $(THIRD_PARTY_DIR)/DirectXMesh/DirectXMesh/DirectXMeshNormals.cpp
 	$(HIDE) mkdir -p $(OBJ_DIR)
 	$(HIDE) $(CC) -c $(C_FLAGS) $(THIRD_PARTY_DIR)/DirectXMesh/DirectXMesh/DirectXMeshNormals.cpp -MD -MF $(OBJ_DIR)/ImportAsset-thirdparty-DirectXMesh-DirectXMeshNormals.d -o $(OBJ_DIR)/ImportAsset-thirdparty-DirectXMesh-DirectXMeshNormals.o
@@ -115,37 +221,154 @@ $(OBJ_DIR)/ImportAsset-thirdparty-McRT-Malloc-mcrt_malloc.o: $(THIRD_PARTY_DIR)/
 	$(HIDE) mkdir -p $(OBJ_DIR)
 	$(HIDE) $(CC) -c $(C_FLAGS) $(THIRD_PARTY_DIR)/McRT-Malloc/source/mcrt_malloc.cpp -MD -MF $(OBJ_DIR)/ImportAsset-thirdparty-McRT-Malloc-mcrt_malloc.d -o $(OBJ_DIR)/ImportAsset-thirdparty-McRT-Malloc-mcrt_malloc.o
 
+$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-debug.o: $(THIRD_PARTY_DIR)/zstd/lib/common/debug.c
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(ZSTD_CC) -c $(ZSTD_C_FLAGS) $(THIRD_PARTY_DIR)/zstd/lib/common/debug.c -MD -MF $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-debug.d -o $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-debug.o
+
+$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-entropy_common.o: $(THIRD_PARTY_DIR)/zstd/lib/common/entropy_common.c
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(ZSTD_CC) -c $(ZSTD_C_FLAGS) $(THIRD_PARTY_DIR)/zstd/lib/common/entropy_common.c -MD -MF $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-entropy_common.d -o $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-entropy_common.o
+
+$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-error_private.o: $(THIRD_PARTY_DIR)/zstd/lib/common/error_private.c
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(ZSTD_CC) -c $(ZSTD_C_FLAGS) $(THIRD_PARTY_DIR)/zstd/lib/common/error_private.c -MD -MF $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-error_private.d -o $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-error_private.o
+
+$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-fse_decompress.o: $(THIRD_PARTY_DIR)/zstd/lib/common/fse_decompress.c
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(ZSTD_CC) -c $(ZSTD_C_FLAGS) $(THIRD_PARTY_DIR)/zstd/lib/common/fse_decompress.c -MD -MF $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-fse_decompress.d -o $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-fse_decompress.o
+
+$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-pool.o: $(THIRD_PARTY_DIR)/zstd/lib/common/pool.c
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(ZSTD_CC) -c $(ZSTD_C_FLAGS) $(THIRD_PARTY_DIR)/zstd/lib/common/pool.c -MD -MF $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-pool.d -o $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-pool.o
+
+$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-threading.o: $(THIRD_PARTY_DIR)/zstd/lib/common/threading.c
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(ZSTD_CC) -c $(ZSTD_C_FLAGS) $(THIRD_PARTY_DIR)/zstd/lib/common/threading.c -MD -MF $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-threading.d -o $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-threading.o
+
+$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-xxhash.o: $(THIRD_PARTY_DIR)/zstd/lib/common/xxhash.c
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(ZSTD_CC) -c $(ZSTD_C_FLAGS) $(THIRD_PARTY_DIR)/zstd/lib/common/xxhash.c -MD -MF $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-xxhash.d -o $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-xxhash.o
+
+$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-zstd_common.o: $(THIRD_PARTY_DIR)/zstd/lib/common/zstd_common.c
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(ZSTD_CC) -c $(ZSTD_C_FLAGS) $(THIRD_PARTY_DIR)/zstd/lib/common/zstd_common.c -MD -MF $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-zstd_common.d -o $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-zstd_common.o
+
+$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-huf_decompress.o: $(THIRD_PARTY_DIR)/zstd/lib/decompress/huf_decompress.c
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(ZSTD_CC) -c $(ZSTD_C_FLAGS) $(THIRD_PARTY_DIR)/zstd/lib/decompress/huf_decompress.c -MD -MF $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-huf_decompress.d -o $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-huf_decompress.o
+
+$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_ddict.o: $(THIRD_PARTY_DIR)/zstd/lib/decompress/zstd_ddict.c
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(ZSTD_CC) -c $(ZSTD_C_FLAGS) $(THIRD_PARTY_DIR)/zstd/lib/decompress/zstd_ddict.c -MD -MF $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_ddict.d -o $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_ddict.o
+
+$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress.o: $(THIRD_PARTY_DIR)/zstd/lib/decompress/zstd_decompress.c
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(ZSTD_CC) -c $(ZSTD_C_FLAGS) $(THIRD_PARTY_DIR)/zstd/lib/decompress/zstd_decompress.c -MD -MF $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress.d -o $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress.o
+
+$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress_block.o: $(THIRD_PARTY_DIR)/zstd/lib/decompress/zstd_decompress_block.c
+	$(HIDE) mkdir -p $(OBJ_DIR)
+	$(HIDE) $(ZSTD_CC) -c $(ZSTD_C_FLAGS) $(THIRD_PARTY_DIR)/zstd/lib/decompress/zstd_decompress_block.c -MD -MF $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress_block.d -o $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress_block.o
+
 -include \
 	$(OBJ_DIR)/ImportAsset-import_asset_file_input_stream.d \
 	$(OBJ_DIR)/ImportAsset-import_asset_memory_input_stream.d \
+	$(OBJ_DIR)/ImportAsset-import_asset_mmap_input_stream.d \
+	$(OBJ_DIR)/ImportAsset-import_asset_shared_file_input_stream.d \
+	$(OBJ_DIR)/ImportAsset-import_asset_archive_input_stream.d \
+	$(OBJ_DIR)/ImportAsset-import_asset_compressed_input_stream.d \
+	$(OBJ_DIR)/ImportAsset-import_asset_buffered_input_stream.d \
 	$(OBJ_DIR)/ImportAsset-import_dds_image_asset.d \
 	$(OBJ_DIR)/ImportAsset-import_pvr_image_asset.d \
+	$(OBJ_DIR)/ImportAsset-internal_import_image_subresource.d \
+	$(OBJ_DIR)/ImportAsset-import_ktx2_image_asset.d \
+	$(OBJ_DIR)/ImportAsset-internal_import_image_block_compression.d \
+	$(OBJ_DIR)/ImportAsset-internal_import_image_mip.d \
+	$(OBJ_DIR)/ImportAsset-internal_import_image_resize.d \
 	$(OBJ_DIR)/ImportAsset-import_gltf_scene_asset.d \
 	$(OBJ_DIR)/ImportAsset-import_gltf_scene_asset_cgltf.d \
+	$(OBJ_DIR)/ImportAsset-internal_import_gltf_accessor.d \
 	$(OBJ_DIR)/ImportAsset-thirdparty-DirectXMesh-DirectXMeshNormals.d \
 	$(OBJ_DIR)/ImportAsset-thirdparty-DirectXMesh-DirectXMeshTangentFrame.d \
-	$(OBJ_DIR)/ImportAsset-thirdparty-McRT-Malloc-mcrt_malloc.d
+	$(OBJ_DIR)/ImportAsset-thirdparty-McRT-Malloc-mcrt_malloc.d \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-debug.d \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-entropy_common.d \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-error_private.d \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-fse_decompress.d \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-pool.d \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-threading.d \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-xxhash.d \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-zstd_common.d \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-huf_decompress.d \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_ddict.d \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress.d \
+	$(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress_block.d
 
 clean:
 	$(HIDE) rm -f $(BIN_DIR)/libImportAsset.a
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_asset_file_input_stream.o
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_asset_memory_input_stream.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_asset_mmap_input_stream.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_asset_shared_file_input_stream.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_asset_archive_input_stream.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_asset_compressed_input_stream.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_asset_buffered_input_stream.o
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_dds_image_asset.o
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_pvr_image_asset.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-internal_import_image_subresource.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_ktx2_image_asset.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-internal_import_image_block_compression.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-internal_import_image_mip.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-internal_import_image_resize.o
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_gltf_scene_asset_cgltf.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-internal_import_gltf_accessor.o
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_gltf_scene_asset.o
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-DirectXMesh-DirectXMeshNormals.o
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-DirectXMesh-DirectXMeshTangentFrame.o
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-McRT-Malloc-mcrt_malloc.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-debug.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-entropy_common.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-error_private.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-fse_decompress.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-pool.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-threading.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-xxhash.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-zstd_common.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-huf_decompress.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_ddict.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress.o
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress_block.o
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_asset_file_input_stream.d
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_asset_memory_input_stream.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_asset_mmap_input_stream.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_asset_shared_file_input_stream.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_asset_archive_input_stream.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_asset_compressed_input_stream.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_asset_buffered_input_stream.d
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_dds_image_asset.d
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_pvr_image_asset.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-internal_import_image_subresource.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_ktx2_image_asset.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-internal_import_image_block_compression.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-internal_import_image_mip.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-internal_import_image_resize.d
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_gltf_scene_asset_cgltf.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-internal_import_gltf_accessor.d
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-import_gltf_scene_asset.d
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-DirectXMesh-DirectXMeshNormals.d
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-DirectXMesh-DirectXMeshTangentFrame.d
 	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-McRT-Malloc-mcrt_malloc.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-debug.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-entropy_common.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-error_private.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-fse_decompress.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-pool.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-threading.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-xxhash.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-common-zstd_common.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-huf_decompress.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_ddict.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress.d
+	$(HIDE) rm -f $(OBJ_DIR)/ImportAsset-thirdparty-zstd-lib-decompress-zstd_decompress_block.d
 
 .PHONY : \
 	all \
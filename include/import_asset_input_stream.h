@@ -31,6 +31,15 @@ enum
 	IMPORT_ASSET_INPUT_STREAM_SEEK_END = 2
 };
 
+struct IMPORT_ASSET_INPUT_STREAM_READ_REQUEST
+{
+	int64_t offset;
+	size_t size;
+	void *data;
+	// the number of bytes read (or -1 on failure) which is valid after the request is completed
+	intptr_t result;
+};
+
 extern import_asset_input_stream_factory *import_asset_init_file_input_stream_factory();
 
 extern void import_asset_destroy_file_input_stream_factory(import_asset_input_stream_factory *input_stream_factory);
@@ -39,6 +48,38 @@ extern import_asset_input_stream_factory *import_asset_init_memory_input_stream_
 
 extern void import_asset_destroy_memory_input_stream_factory(import_asset_input_stream_factory *input_stream_factory);
 
+extern import_asset_input_stream_factory *import_asset_init_mmap_input_stream_factory();
+
+extern void import_asset_destroy_mmap_input_stream_factory(import_asset_input_stream_factory *input_stream_factory);
+
+// share one file descriptor per path among the input streams (closed when the last input stream of the path is destroyed) and the input streams are the cheap handles which are based on the positional reads
+extern import_asset_input_stream_factory *import_asset_init_shared_file_input_stream_factory();
+
+extern void import_asset_destroy_shared_file_input_stream_factory(import_asset_input_stream_factory *input_stream_factory);
+
+// the packed archive (a single file with the hashed directory) is opened by the "archive_input_stream_factory" (which should outlive this factory) and the input streams are the sub-ranges of it
+// return NULL if the archive is NOT valid
+extern import_asset_input_stream_factory *import_asset_init_archive_input_stream_factory(import_asset_input_stream_factory *archive_input_stream_factory, char const *archive_file_name);
+
+extern void import_asset_destroy_archive_input_stream_factory(import_asset_input_stream_factory *input_stream_factory);
+
+// pack the files into the archive which can be opened by the "import_asset_init_archive_input_stream_factory"
+// the blobs are stored as they are and aligned to "data_alignment" (power of 2, or 0 for no alignment) and the compressed files should be packed as the block-compressed containers (opened by the "import_asset_init_compressed_input_stream_factory" on top of the archive factory)
+// the required size is returned if "archive_data" is NULL, otherwise the archive is written into "archive_data" and the written size is returned
+// return 0 if the file names are duplicated, the "data_alignment" is NOT valid or the "archive_size" is too small
+extern size_t import_asset_pack_archive(size_t file_count, char const *const *file_names, void const *const *file_data_bases, size_t const *file_data_sizes, uint32_t data_alignment, void *archive_data, size_t archive_size);
+
+// the block-compressed container (the independent blocks with the index) opened by the "underlying_input_stream_factory" (which should outlive this factory) is decompressed transparently and the other files are passed through
+extern import_asset_input_stream_factory *import_asset_init_compressed_input_stream_factory(import_asset_input_stream_factory *underlying_input_stream_factory);
+
+extern void import_asset_destroy_compressed_input_stream_factory(import_asset_input_stream_factory *input_stream_factory);
+
+// the small reads are coalesced by reading ahead "block_size" (64 KiB if 0) bytes from the input stream opened by the "underlying_input_stream_factory" (which should outlive this factory)
+// the following "read_ahead_block_count" blocks (0 for no read-ahead) are submitted asynchronously by "read_submit" of the underlying input stream when the block is read
+extern import_asset_input_stream_factory *import_asset_init_buffered_input_stream_factory(import_asset_input_stream_factory *underlying_input_stream_factory, size_t block_size, size_t read_ahead_block_count);
+
+extern void import_asset_destroy_buffered_input_stream_factory(import_asset_input_stream_factory *input_stream_factory);
+
 class import_asset_input_stream_factory
 {
 public:
@@ -52,6 +93,58 @@ public:
 	virtual int stat_size(int64_t *size) = 0;
 	virtual intptr_t read(void *data, size_t size) = 0;
 	virtual int64_t seek(int64_t offset, int whence) = 0;
+	// positional read which does NOT change the position used by "read" and "seek"
+	// the default implementation is based on "seek" and "read" and is NOT safe to be called concurrently (the input streams which override it with the concurrent positional reads should also override "is_read_at_thread_safe")
+	virtual intptr_t read_at(int64_t offset, void *data, size_t size)
+	{
+		int64_t const position = this->seek(0, IMPORT_ASSET_INPUT_STREAM_SEEK_CUR);
+		if ((-1 == position) || (-1 == this->seek(offset, IMPORT_ASSET_INPUT_STREAM_SEEK_SET)))
+		{
+			return -1;
+		}
+
+		intptr_t const read_size = this->read(data, size);
+
+		if (-1 == this->seek(position, IMPORT_ASSET_INPUT_STREAM_SEEK_SET))
+		{
+			return -1;
+		}
+
+		return read_size;
+	}
+	// return true if "read_at" is safe to be called concurrently (otherwise the parallel loaders copy serially on the calling thread)
+	virtual bool is_read_at_thread_safe() const
+	{
+		return false;
+	}
+	// zero-copy view of [offset, offset + size) which remains valid until the input stream is destroyed
+	// return -1 if the input stream is NOT able to provide the view (the caller should fall back to "read")
+	virtual int map_range(int64_t, size_t, void const **)
+	{
+		return -1;
+	}
+	// the requests are read asynchronously and should be kept alive until completed
+	// the asynchronous reads are positional and do NOT change the position used by "read" and "seek"
+	// the default implementation is synchronous: the requests have been completed by "read_at" before "read_submit" returns
+	virtual int read_submit(size_t request_count, IMPORT_ASSET_INPUT_STREAM_READ_REQUEST *requests)
+	{
+		for (size_t request_index = 0U; request_index < request_count; ++request_index)
+		{
+			requests[request_index].result = this->read_at(requests[request_index].offset, requests[request_index].data, requests[request_index].size);
+		}
+
+		return 0;
+	}
+	// return the number of the submitted requests which are NOT completed yet (or -1 on failure)
+	virtual intptr_t read_poll()
+	{
+		return 0;
+	}
+	// wait until all the submitted requests are completed
+	virtual int read_wait()
+	{
+		return 0;
+	}
 };
 
 #endif
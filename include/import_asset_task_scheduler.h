@@ -0,0 +1,36 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _IMPORT_ASSET_TASK_SCHEDULER_H_
+#define _IMPORT_ASSET_TASK_SCHEDULER_H_ 1
+
+#include <stddef.h>
+#include <stdint.h>
+
+class import_asset_task_scheduler;
+
+typedef void (*import_asset_task_function)(uint32_t task_index, void *user_data);
+
+class import_asset_task_scheduler
+{
+public:
+	// the "task_function" is called once for each index in [0, task_count) and may be called concurrently on the worker threads of the caller
+	// return after all tasks are completed (the calling thread may execute the tasks as well)
+	virtual void parallel_for(uint32_t task_count, import_asset_task_function task_function, void *user_data) = 0;
+};
+
+#endif
@@ -21,6 +21,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "import_asset_input_stream.h"
+#include "import_asset_task_scheduler.h"
 #include "../../Brioche/include/brx_sampled_asset_image_format.h"
 
 enum IMPORT_ASSET_IMAGE_TYPE
@@ -42,12 +43,86 @@ struct IMPORT_ASSET_IMAGE_HEADER
     uint32_t array_layers;
 };
 
+// the supercompression scheme of the KTX2 image (the BasisLZ and the ZLIB supercompression are NOT supported)
+enum IMPORT_ASSET_KTX2_SUPERCOMPRESSION_SCHEME
+{
+    IMPORT_ASSET_KTX2_SUPERCOMPRESSION_SCHEME_NONE = 0,
+    IMPORT_ASSET_KTX2_SUPERCOMPRESSION_SCHEME_ZSTD = 2
+};
+
+// the layout of one subresource in the input stream (the array is indexed by the same subresource index as "BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST")
+struct IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT
+{
+    uint64_t offset;
+    uint32_t row_size;
+    uint32_t row_count;
+    uint32_t slice_size;
+    uint32_t slice_count;
+};
+
+// the metadata of the PVR image (the default values are used if the corresponding metadata block is NOT present)
+struct IMPORT_ASSET_PVR_IMAGE_METADATA
+{
+    // by default the data is stored as X = right, Y = down and Z = in (the caller may flip the texture coordinates instead of flipping the data)
+    bool orientation_left;
+    bool orientation_up;
+    bool orientation_out;
+    // the face stored at the "i"-th position is the face "cube_map_face_order[i]" in the order of +X -X +Y -Y +Z -Z
+    uint32_t cube_map_face_order[6];
+    // the number of the border texels on each side which are included by the width, height and depth
+    uint32_t border_width;
+    uint32_t border_height;
+    uint32_t border_depth;
+    // the total size of the padding metadata blocks (inserted by the tool to align the data)
+    uint32_t padding_size;
+    // the array of the float coordinates is located at the offset of the input stream (NOT copied)
+    uint64_t texture_atlas_coords_offset;
+    uint32_t texture_atlas_coords_count;
+};
+
 extern bool import_dds_image_asset_header_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER *image_asset_header, size_t *image_asset_data_offset);
 
 extern bool import_dds_image_asset_data_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests);
 
+// only the mip levels [first_mip_level, first_mip_level + mip_level_count) of all array layers are loaded into the corresponding "subresource_memcpy_dests" (the other entries are ignored)
+extern bool import_dds_image_asset_mip_range_data_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, uint32_t first_mip_level, uint32_t mip_level_count, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests);
+
+// the subresources are copied in parallel on the "task_scheduler" by the positional reads (or from the mapping if the input stream supports "map_range")
+// the subresources are copied serially on the calling thread if the "task_scheduler" is NULL or the "is_read_at_thread_safe" of the input stream returns false
+extern bool import_dds_image_asset_data_from_input_stream_parallel(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests, import_asset_task_scheduler *task_scheduler);
+
+// computed from the header only (without touching the pixel data) and the "subresource_count" should match the header
+extern bool import_dds_image_asset_subresource_layouts(IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, size_t subresource_count, IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT *subresource_layouts);
+
 extern bool import_pvr_image_asset_header_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER *image_asset_header, size_t *image_asset_data_offset);
 
+// the metadata section is read by one single read and the keys which are known are parsed
+extern bool import_pvr_image_asset_header_and_metadata_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER *image_asset_header, IMPORT_ASSET_PVR_IMAGE_METADATA *image_asset_metadata, size_t *image_asset_data_offset);
+
 extern bool import_pvr_image_asset_data_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests);
 
+extern bool import_pvr_image_asset_mip_range_data_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, uint32_t first_mip_level, uint32_t mip_level_count, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests);
+
+extern bool import_pvr_image_asset_data_from_input_stream_parallel(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests, import_asset_task_scheduler *task_scheduler);
+
+extern bool import_pvr_image_asset_subresource_layouts(IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, size_t subresource_count, IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT *subresource_layouts);
+
+// the KTX2 without supercompression or with the Zstandard supercompression is supported (the BasisLZ and the ZLIB supercompression are NOT supported)
+// the Basis Universal (ETC1S with the BasisLZ supercompression and the UASTC) is NOT transcoded (the header import fails) since the Basis Universal transcoder is NOT vendored
+// the level index is verified against the layout computed from the header and the data offset is the offset of the smallest level
+// each Zstandard supercompressed mip level is decompressed into the private memory (one task per mip level)
+extern bool import_ktx2_image_asset_header_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER *image_asset_header, size_t *image_asset_data_offset);
+
+// the supercompression scheme is also returned (which is required by the "import_ktx2_image_asset_subresource_layouts")
+extern bool import_ktx2_image_asset_header_and_supercompression_scheme_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER *image_asset_header, IMPORT_ASSET_KTX2_SUPERCOMPRESSION_SCHEME *supercompression_scheme, size_t *image_asset_data_offset);
+
+extern bool import_ktx2_image_asset_data_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests);
+
+extern bool import_ktx2_image_asset_mip_range_data_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, uint32_t first_mip_level, uint32_t mip_level_count, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests);
+
+extern bool import_ktx2_image_asset_data_from_input_stream_parallel(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests, import_asset_task_scheduler *task_scheduler);
+
+// the supercompressed mip levels can NOT be read by the layouts and false is returned unless the "supercompression_scheme" is "NONE"
+extern bool import_ktx2_image_asset_subresource_layouts(IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, IMPORT_ASSET_KTX2_SUPERCOMPRESSION_SCHEME supercompression_scheme, size_t image_asset_data_offset, size_t subresource_count, IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT *subresource_layouts);
+
 #endif
@@ -29,6 +29,7 @@
 #pragma GCC diagnostic pop
 #endif
 #include "import_asset_input_stream.h"
+#include "import_asset_task_scheduler.h"
 #include "../../McRT-Malloc/include/mcrt_vector.h"
 #include "../../McRT-Malloc/include/mcrt_string.h"
 
@@ -213,6 +214,10 @@ struct scene_mesh_data
 
 extern bool import_gltf_scene_asset(mcrt_vector<scene_mesh_data> &out_total_mesh_data, float frame_rate, import_asset_input_stream_factory *input_stream_factory, char const *path);
 
+// the meshes are imported in parallel on the "task_scheduler" (or on the calling thread if the "task_scheduler" is NULL)
+// the "out_total_mesh_data" is indexed by the same mesh index as the glTF file regardless of the order in which the tasks are completed
+extern bool import_gltf_scene_asset_parallel(mcrt_vector<scene_mesh_data> &out_total_mesh_data, float frame_rate, import_asset_input_stream_factory *input_stream_factory, char const *path, import_asset_task_scheduler *task_scheduler);
+
 // Khronos ANARI (Analytic Rendering Interface) API
 
 // The importer will merge the meshes  
@@ -0,0 +1,437 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "import_asset_archive_input_stream.h"
+#include "../../McRT-Malloc/include/mcrt_malloc.h"
+#include <new>
+#include <cstring>
+#include <utility>
+#include <assert.h>
+
+static inline uint64_t import_asset_archive_name_hash(char const *name);
+
+extern import_asset_input_stream_factory *import_asset_init_archive_input_stream_factory(import_asset_input_stream_factory *archive_input_stream_factory, char const *archive_file_name)
+{
+	void *new_unwrapped_input_stream_factory_base = mcrt_malloc(sizeof(import_asset_archive_input_stream_factory), alignof(import_asset_archive_input_stream_factory));
+	assert(NULL != new_unwrapped_input_stream_factory_base);
+
+	import_asset_archive_input_stream_factory *new_unwrapped_input_stream_factory = new (new_unwrapped_input_stream_factory_base) import_asset_archive_input_stream_factory{};
+	if (!new_unwrapped_input_stream_factory->init(archive_input_stream_factory, archive_file_name))
+	{
+		new_unwrapped_input_stream_factory->~import_asset_archive_input_stream_factory();
+		mcrt_free(new_unwrapped_input_stream_factory);
+		return NULL;
+	}
+
+	return new_unwrapped_input_stream_factory;
+}
+
+extern void import_asset_destroy_archive_input_stream_factory(import_asset_input_stream_factory *wrapped_input_stream_factory)
+{
+	assert(NULL != wrapped_input_stream_factory);
+	import_asset_archive_input_stream_factory *delete_unwrapped_input_stream_factory = static_cast<import_asset_archive_input_stream_factory *>(wrapped_input_stream_factory);
+
+	delete_unwrapped_input_stream_factory->uninit();
+
+	delete_unwrapped_input_stream_factory->~import_asset_archive_input_stream_factory();
+	mcrt_free(delete_unwrapped_input_stream_factory);
+}
+
+extern size_t import_asset_pack_archive(size_t file_count, char const *const *file_names, void const *const *file_data_bases, size_t const *file_data_sizes, uint32_t data_alignment, void *archive_data, size_t archive_size)
+{
+	if ((0U != (data_alignment & (data_alignment - 1U))) || (file_count >= (static_cast<size_t>(1U) << 30U)))
+	{
+		return 0U;
+	}
+
+	// the load factor is at most 1/2 such that the probing is short and there is always an empty bucket to terminate the probing
+	uint32_t bucket_count = 1U;
+	while (bucket_count < (2U * file_count))
+	{
+		bucket_count <<= 1U;
+	}
+
+	mcrt_vector<IMPORT_ASSET_ARCHIVE_ENTRY> buckets(static_cast<size_t>(bucket_count));
+	for (IMPORT_ASSET_ARCHIVE_ENTRY &bucket : buckets)
+	{
+		bucket.name_hash = 0U;
+		bucket.data_offset = 0U;
+		bucket.data_size = 0U;
+		bucket.uncompressed_size = 0U;
+		bucket.name_offset = IMPORT_ASSET_ARCHIVE_EMPTY_NAME_OFFSET;
+		bucket.compression = IMPORT_ASSET_ARCHIVE_COMPRESSION_NONE;
+	}
+
+	mcrt_vector<char> names;
+	for (size_t file_index = 0U; file_index < file_count; ++file_index)
+	{
+		names.insert(names.end(), file_names[file_index], file_names[file_index] + (std::strlen(file_names[file_index]) + 1U));
+	}
+
+	// the names are NOT empty even if there is no file since the last name should be null-terminated
+	if (names.empty())
+	{
+		names.push_back('\0');
+	}
+
+	if (names.size() >= static_cast<size_t>(IMPORT_ASSET_ARCHIVE_EMPTY_NAME_OFFSET))
+	{
+		return 0U;
+	}
+
+	uint64_t const buckets_offset = sizeof(IMPORT_ASSET_ARCHIVE_HEADER);
+	uint64_t const names_offset = buckets_offset + sizeof(IMPORT_ASSET_ARCHIVE_ENTRY) * static_cast<uint64_t>(bucket_count);
+
+	// the data offsets are relative to the beginning of the archive
+	uint64_t const alignment = (0U != data_alignment) ? static_cast<uint64_t>(data_alignment) : static_cast<uint64_t>(1U);
+	mcrt_vector<uint64_t> data_offsets(file_count);
+	uint64_t data_end = names_offset + names.size();
+	uint32_t name_offset = 0U;
+	for (size_t file_index = 0U; file_index < file_count; ++file_index)
+	{
+		char const *const file_name = names.data() + name_offset;
+		uint64_t const name_hash = import_asset_archive_name_hash(file_name);
+
+		uint32_t bucket_index = static_cast<uint32_t>(name_hash) & (bucket_count - 1U);
+		while (IMPORT_ASSET_ARCHIVE_EMPTY_NAME_OFFSET != buckets[bucket_index].name_offset)
+		{
+			if ((name_hash == buckets[bucket_index].name_hash) && (0 == std::strcmp(names.data() + buckets[bucket_index].name_offset, file_name)))
+			{
+				return 0U;
+			}
+
+			bucket_index = (bucket_index + 1U) & (bucket_count - 1U);
+		}
+
+		uint64_t const data_offset = ((data_end + (alignment - 1U)) / alignment) * alignment;
+
+		IMPORT_ASSET_ARCHIVE_ENTRY &bucket = buckets[bucket_index];
+		bucket.name_hash = name_hash;
+		bucket.data_offset = data_offset;
+		bucket.data_size = file_data_sizes[file_index];
+		bucket.uncompressed_size = file_data_sizes[file_index];
+		bucket.name_offset = name_offset;
+		bucket.compression = IMPORT_ASSET_ARCHIVE_COMPRESSION_NONE;
+
+		data_offsets[file_index] = data_offset;
+		data_end = data_offset + file_data_sizes[file_index];
+		name_offset += static_cast<uint32_t>(std::strlen(file_name) + 1U);
+	}
+
+	if (data_end > static_cast<uint64_t>(SIZE_MAX))
+	{
+		return 0U;
+	}
+
+	size_t const required_size = static_cast<size_t>(data_end);
+	if (NULL == archive_data)
+	{
+		return required_size;
+	}
+
+	if (archive_size < required_size)
+	{
+		return 0U;
+	}
+
+	IMPORT_ASSET_ARCHIVE_HEADER header;
+	header.magic = IMPORT_ASSET_ARCHIVE_MAGIC;
+	header.version = IMPORT_ASSET_ARCHIVE_VERSION;
+	header.entry_count = static_cast<uint32_t>(file_count);
+	header.bucket_count = bucket_count;
+	header.data_alignment = data_alignment;
+	header.reserved = 0U;
+	header.buckets_offset = buckets_offset;
+	header.names_offset = names_offset;
+	header.names_size = names.size();
+
+	// the padding between the blobs is zero
+	uint8_t *const archive_base = static_cast<uint8_t *>(archive_data);
+	std::memset(archive_base, 0, required_size);
+	std::memcpy(archive_base, &header, sizeof(IMPORT_ASSET_ARCHIVE_HEADER));
+	std::memcpy(archive_base + buckets_offset, buckets.data(), sizeof(IMPORT_ASSET_ARCHIVE_ENTRY) * buckets.size());
+	std::memcpy(archive_base + names_offset, names.data(), names.size());
+
+	for (size_t file_index = 0U; file_index < file_count; ++file_index)
+	{
+		if (file_data_sizes[file_index] > 0U)
+		{
+			std::memcpy(archive_base + data_offsets[file_index], file_data_bases[file_index], file_data_sizes[file_index]);
+		}
+	}
+
+	return required_size;
+}
+
+import_asset_archive_input_stream_factory::import_asset_archive_input_stream_factory() : m_archive_input_stream_factory(NULL), m_archive_input_stream(NULL), m_bucket_mask(0U)
+{
+}
+
+bool import_asset_archive_input_stream_factory::init(import_asset_input_stream_factory *archive_input_stream_factory, char const *archive_file_name)
+{
+	assert(NULL == this->m_archive_input_stream_factory);
+	assert(NULL == this->m_archive_input_stream);
+
+	import_asset_input_stream *archive_input_stream = archive_input_stream_factory->create_instance(archive_file_name);
+	if (NULL == archive_input_stream)
+	{
+		return false;
+	}
+
+	int64_t archive_size;
+	IMPORT_ASSET_ARCHIVE_HEADER header;
+	if ((-1 == archive_input_stream->stat_size(&archive_size)) || (sizeof(IMPORT_ASSET_ARCHIVE_HEADER) != archive_input_stream->read_at(0, &header, sizeof(IMPORT_ASSET_ARCHIVE_HEADER))))
+	{
+		archive_input_stream_factory->destory_instance(archive_input_stream);
+		return false;
+	}
+
+	// the bucket count should be power of 2 and there should be at least one empty bucket to terminate the probing
+	if ((IMPORT_ASSET_ARCHIVE_MAGIC != header.magic) || (IMPORT_ASSET_ARCHIVE_VERSION != header.version) || (0U == header.bucket_count) || (0U != (header.bucket_count & (header.bucket_count - 1U))) || (header.entry_count >= header.bucket_count) || (0U == header.names_size) || (archive_size < 0) || (header.buckets_offset > static_cast<uint64_t>(archive_size)) || ((sizeof(IMPORT_ASSET_ARCHIVE_ENTRY) * header.bucket_count) > (static_cast<uint64_t>(archive_size) - header.buckets_offset)) || (header.names_offset > static_cast<uint64_t>(archive_size)) || (header.names_size > (static_cast<uint64_t>(archive_size) - header.names_offset)))
+	{
+		archive_input_stream_factory->destory_instance(archive_input_stream);
+		return false;
+	}
+
+	mcrt_vector<IMPORT_ASSET_ARCHIVE_ENTRY> buckets(static_cast<size_t>(header.bucket_count));
+	mcrt_vector<char> names(static_cast<size_t>(header.names_size));
+	if ((static_cast<intptr_t>(sizeof(IMPORT_ASSET_ARCHIVE_ENTRY) * buckets.size()) != archive_input_stream->read_at(header.buckets_offset, buckets.data(), sizeof(IMPORT_ASSET_ARCHIVE_ENTRY) * buckets.size())) || (static_cast<intptr_t>(names.size()) != archive_input_stream->read_at(header.names_offset, names.data(), names.size())) || ('\0' != names.back()))
+	{
+		archive_input_stream_factory->destory_instance(archive_input_stream);
+		return false;
+	}
+
+	// the directory is validated once here such that the lookup can trust the buckets
+	uint32_t occupied_bucket_count = 0U;
+	for (IMPORT_ASSET_ARCHIVE_ENTRY const &bucket : buckets)
+	{
+		if (IMPORT_ASSET_ARCHIVE_EMPTY_NAME_OFFSET != bucket.name_offset)
+		{
+			++occupied_bucket_count;
+
+			// only the uncompressed entries are supported (the compressed files can be packed as the block-compressed containers and opened by the compressed input stream factory on top of this factory)
+			if ((bucket.name_offset >= names.size()) || (import_asset_archive_name_hash(names.data() + bucket.name_offset) != bucket.name_hash) || ((0U != header.data_alignment) && (0U != (bucket.data_offset % header.data_alignment))) || (bucket.data_offset > static_cast<uint64_t>(archive_size)) || (bucket.data_size > (static_cast<uint64_t>(archive_size) - bucket.data_offset)) || (IMPORT_ASSET_ARCHIVE_COMPRESSION_NONE != bucket.compression) || (bucket.uncompressed_size != bucket.data_size))
+			{
+				archive_input_stream_factory->destory_instance(archive_input_stream);
+				return false;
+			}
+		}
+	}
+
+	if (occupied_bucket_count != header.entry_count)
+	{
+		archive_input_stream_factory->destory_instance(archive_input_stream);
+		return false;
+	}
+
+	this->m_archive_input_stream_factory = archive_input_stream_factory;
+	this->m_archive_input_stream = archive_input_stream;
+	this->m_bucket_mask = header.bucket_count - 1U;
+	this->m_buckets = std::move(buckets);
+	this->m_names = std::move(names);
+	return true;
+}
+
+void import_asset_archive_input_stream_factory::uninit()
+{
+	assert(NULL != this->m_archive_input_stream_factory);
+	assert(NULL != this->m_archive_input_stream);
+
+	this->m_archive_input_stream_factory->destory_instance(this->m_archive_input_stream);
+	this->m_archive_input_stream = NULL;
+	this->m_archive_input_stream_factory = NULL;
+
+	this->m_bucket_mask = 0U;
+	this->m_buckets.clear();
+	this->m_names.clear();
+}
+
+import_asset_archive_input_stream_factory::~import_asset_archive_input_stream_factory()
+{
+	assert(NULL == this->m_archive_input_stream_factory);
+	assert(NULL == this->m_archive_input_stream);
+}
+
+import_asset_input_stream *import_asset_archive_input_stream_factory::create_instance(char const *file_name)
+{
+	// NOTE: no allocation for the lookup (the directory is read-only after "init" and the lookup is thread-safe)
+
+	uint64_t const name_hash = import_asset_archive_name_hash(file_name);
+
+	for (uint32_t probe_index = 0U; probe_index <= this->m_bucket_mask; ++probe_index)
+	{
+		IMPORT_ASSET_ARCHIVE_ENTRY const &bucket = this->m_buckets[(static_cast<uint32_t>(name_hash) + probe_index) & this->m_bucket_mask];
+
+		if (IMPORT_ASSET_ARCHIVE_EMPTY_NAME_OFFSET == bucket.name_offset)
+		{
+			return NULL;
+		}
+
+		if ((name_hash == bucket.name_hash) && (0 == std::strcmp(this->m_names.data() + bucket.name_offset, file_name)))
+		{
+			assert(IMPORT_ASSET_ARCHIVE_COMPRESSION_NONE == bucket.compression);
+			assert(bucket.uncompressed_size == bucket.data_size);
+
+			void *new_unwrapped_input_stream_base = mcrt_malloc(sizeof(import_asset_archive_input_stream), alignof(import_asset_archive_input_stream));
+			assert(NULL != new_unwrapped_input_stream_base);
+
+			import_asset_archive_input_stream *new_unwrapped_input_stream = new (new_unwrapped_input_stream_base) import_asset_archive_input_stream{};
+			new_unwrapped_input_stream->init(this->m_archive_input_stream, static_cast<int64_t>(bucket.data_offset), static_cast<int64_t>(bucket.data_size));
+			return new_unwrapped_input_stream;
+		}
+	}
+
+	return NULL;
+}
+
+void import_asset_archive_input_stream_factory::destory_instance(import_asset_input_stream *wrapped_input_stream)
+{
+	assert(NULL != wrapped_input_stream);
+	import_asset_archive_input_stream *delete_unwrapped_input_stream = static_cast<import_asset_archive_input_stream *>(wrapped_input_stream);
+
+	delete_unwrapped_input_stream->uninit();
+
+	delete_unwrapped_input_stream->~import_asset_archive_input_stream();
+	mcrt_free(delete_unwrapped_input_stream);
+}
+
+import_asset_archive_input_stream::import_asset_archive_input_stream() : m_archive_input_stream(NULL), m_entry_offset(0), m_entry_size(0), m_offset(0)
+{
+}
+
+void import_asset_archive_input_stream::init(import_asset_input_stream *archive_input_stream, int64_t entry_offset, int64_t entry_size)
+{
+	assert(NULL == this->m_archive_input_stream);
+	this->m_archive_input_stream = archive_input_stream;
+
+	assert(0 == this->m_entry_offset);
+	this->m_entry_offset = entry_offset;
+
+	assert(0 == this->m_entry_size);
+	this->m_entry_size = entry_size;
+
+	assert(0 == this->m_offset);
+}
+
+void import_asset_archive_input_stream::uninit()
+{
+	assert(NULL != this->m_archive_input_stream);
+	this->m_archive_input_stream = NULL;
+
+	this->m_entry_offset = 0;
+	this->m_entry_size = 0;
+	this->m_offset = 0;
+}
+
+import_asset_archive_input_stream::~import_asset_archive_input_stream()
+{
+	assert(NULL == this->m_archive_input_stream);
+	assert(0 == this->m_entry_offset);
+	assert(0 == this->m_entry_size);
+	assert(0 == this->m_offset);
+}
+
+int import_asset_archive_input_stream::stat_size(int64_t *size)
+{
+	(*size) = this->m_entry_size;
+	return 0;
+}
+
+intptr_t import_asset_archive_input_stream::read(void *data, size_t size)
+{
+	intptr_t read_size = this->read_at(this->m_offset, data, size);
+	if (read_size > 0)
+	{
+		this->m_offset += read_size;
+	}
+
+	return read_size;
+}
+
+int64_t import_asset_archive_input_stream::seek(int64_t offset, int whence)
+{
+	int64_t new_offset;
+	switch (whence)
+	{
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_SET:
+		new_offset = offset;
+		break;
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_CUR:
+		new_offset = this->m_offset + offset;
+		break;
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_END:
+		new_offset = this->m_entry_size + offset;
+		break;
+	default:
+		assert(false);
+		new_offset = -1;
+	}
+
+	if (new_offset < 0)
+	{
+		return -1;
+	}
+
+	this->m_offset = new_offset;
+	return this->m_offset;
+}
+
+intptr_t import_asset_archive_input_stream::read_at(int64_t offset, void *data, size_t size)
+{
+	if (offset < 0)
+	{
+		return -1;
+	}
+
+	// clamp to the sub-range of the entry
+	size_t const clamped_size = ((offset + static_cast<int64_t>(size)) <= this->m_entry_size) ? size : ((offset < this->m_entry_size) ? static_cast<size_t>(this->m_entry_size - offset) : 0U);
+	if (0U == clamped_size)
+	{
+		return 0;
+	}
+
+	return this->m_archive_input_stream->read_at(this->m_entry_offset + offset, data, clamped_size);
+}
+
+bool import_asset_archive_input_stream::is_read_at_thread_safe() const
+{
+	return this->m_archive_input_stream->is_read_at_thread_safe();
+}
+
+int import_asset_archive_input_stream::map_range(int64_t offset, size_t size, void const **data)
+{
+	if ((offset >= 0) && (offset <= this->m_entry_size) && (static_cast<int64_t>(size) <= (this->m_entry_size - offset)))
+	{
+		return this->m_archive_input_stream->map_range(this->m_entry_offset + offset, size, data);
+	}
+	else
+	{
+		return -1;
+	}
+}
+
+static inline uint64_t import_asset_archive_name_hash(char const *name)
+{
+	// FNV-1a 64
+	uint64_t hash = 0XCBF29CE484222325ULL;
+	for (char const *c = name; '\0' != (*c); ++c)
+	{
+		hash ^= static_cast<uint64_t>(static_cast<uint8_t>(*c));
+		hash *= 0X100000001B3ULL;
+	}
+	return hash;
+}
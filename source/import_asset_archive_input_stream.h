@@ -0,0 +1,107 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _IMPORT_ASSET_ARCHIVE_INPUT_STREAM_H_
+#define _IMPORT_ASSET_ARCHIVE_INPUT_STREAM_H_ 1
+
+#include "../include/import_asset_input_stream.h"
+#include "../../McRT-Malloc/include/mcrt_vector.h"
+
+// Archive Layout (Little Endian)
+// [IMPORT_ASSET_ARCHIVE_HEADER]
+// [IMPORT_ASSET_ARCHIVE_ENTRY] * bucket_count (open addressing with linear probing, indexed by "name_hash & (bucket_count - 1)")
+// [Names] (null-terminated UTF-8 strings referenced by "name_offset", used to resolve the hash collisions)
+// [Data] (each blob is aligned to "data_alignment" to be copied into the staging upload buffer directly)
+
+static constexpr uint32_t const IMPORT_ASSET_ARCHIVE_MAGIC = 0X4B504149U; // "IAPK"
+static constexpr uint32_t const IMPORT_ASSET_ARCHIVE_VERSION = 1U;
+static constexpr uint32_t const IMPORT_ASSET_ARCHIVE_EMPTY_NAME_OFFSET = 0XFFFFFFFFU;
+
+enum
+{
+	IMPORT_ASSET_ARCHIVE_COMPRESSION_NONE = 0
+};
+
+struct IMPORT_ASSET_ARCHIVE_HEADER
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t entry_count;
+	// power of 2 and greater than the entry count
+	uint32_t bucket_count;
+	uint32_t data_alignment;
+	uint32_t reserved;
+	uint64_t buckets_offset;
+	uint64_t names_offset;
+	uint64_t names_size;
+};
+static_assert(sizeof(IMPORT_ASSET_ARCHIVE_HEADER) == 48U, "");
+
+struct IMPORT_ASSET_ARCHIVE_ENTRY
+{
+	// FNV-1a 64
+	uint64_t name_hash;
+	uint64_t data_offset;
+	uint64_t data_size;
+	uint64_t uncompressed_size;
+	// "IMPORT_ASSET_ARCHIVE_EMPTY_NAME_OFFSET" for the empty bucket
+	uint32_t name_offset;
+	uint32_t compression;
+};
+static_assert(sizeof(IMPORT_ASSET_ARCHIVE_ENTRY) == 40U, "");
+
+class import_asset_archive_input_stream_factory final : public import_asset_input_stream_factory
+{
+	import_asset_input_stream_factory *m_archive_input_stream_factory;
+	import_asset_input_stream *m_archive_input_stream;
+	uint32_t m_bucket_mask;
+	mcrt_vector<IMPORT_ASSET_ARCHIVE_ENTRY> m_buckets;
+	mcrt_vector<char> m_names;
+
+public:
+	import_asset_archive_input_stream_factory();
+	bool init(import_asset_input_stream_factory *archive_input_stream_factory, char const *archive_file_name);
+	void uninit();
+	~import_asset_archive_input_stream_factory();
+
+private:
+	virtual import_asset_input_stream *create_instance(char const *file_name) override;
+	virtual void destory_instance(import_asset_input_stream *input_stream) override;
+};
+
+class import_asset_archive_input_stream final : public import_asset_input_stream
+{
+	// NOTE: the archive input stream is shared by all instances and only the positional reads are used
+	import_asset_input_stream *m_archive_input_stream;
+	int64_t m_entry_offset;
+	int64_t m_entry_size;
+	int64_t m_offset;
+
+public:
+	import_asset_archive_input_stream();
+	void init(import_asset_input_stream *archive_input_stream, int64_t entry_offset, int64_t entry_size);
+	void uninit();
+	~import_asset_archive_input_stream();
+	int stat_size(int64_t *size) override;
+	intptr_t read(void *data, size_t size) override;
+	int64_t seek(int64_t offset, int whence) override;
+	intptr_t read_at(int64_t offset, void *data, size_t size) override;
+	bool is_read_at_thread_safe() const override;
+	int map_range(int64_t offset, size_t size, void const **data) override;
+};
+
+#endif
@@ -0,0 +1,443 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "import_asset_buffered_input_stream.h"
+#include "../../McRT-Malloc/include/mcrt_malloc.h"
+#include <new>
+#include <cstring>
+#include <algorithm>
+#include <assert.h>
+
+static constexpr size_t const DEFAULT_BLOCK_SIZE = 64U * 1024U;
+
+extern import_asset_input_stream_factory *import_asset_init_buffered_input_stream_factory(import_asset_input_stream_factory *underlying_input_stream_factory, size_t block_size, size_t read_ahead_block_count)
+{
+	void *new_unwrapped_input_stream_factory_base = mcrt_malloc(sizeof(import_asset_buffered_input_stream_factory), alignof(import_asset_buffered_input_stream_factory));
+	assert(NULL != new_unwrapped_input_stream_factory_base);
+
+	import_asset_buffered_input_stream_factory *new_unwrapped_input_stream_factory = new (new_unwrapped_input_stream_factory_base) import_asset_buffered_input_stream_factory{};
+	new_unwrapped_input_stream_factory->init(underlying_input_stream_factory, (0U != block_size) ? block_size : DEFAULT_BLOCK_SIZE, read_ahead_block_count);
+	return new_unwrapped_input_stream_factory;
+}
+
+extern void import_asset_destroy_buffered_input_stream_factory(import_asset_input_stream_factory *wrapped_input_stream_factory)
+{
+	assert(NULL != wrapped_input_stream_factory);
+	import_asset_buffered_input_stream_factory *delete_unwrapped_input_stream_factory = static_cast<import_asset_buffered_input_stream_factory *>(wrapped_input_stream_factory);
+
+	delete_unwrapped_input_stream_factory->uninit();
+
+	delete_unwrapped_input_stream_factory->~import_asset_buffered_input_stream_factory();
+	mcrt_free(delete_unwrapped_input_stream_factory);
+}
+
+import_asset_buffered_input_stream_factory::import_asset_buffered_input_stream_factory() : m_underlying_input_stream_factory(NULL), m_block_size(0U), m_read_ahead_block_count(0U)
+{
+}
+
+void import_asset_buffered_input_stream_factory::init(import_asset_input_stream_factory *underlying_input_stream_factory, size_t block_size, size_t read_ahead_block_count)
+{
+	assert(NULL == this->m_underlying_input_stream_factory);
+	this->m_underlying_input_stream_factory = underlying_input_stream_factory;
+
+	assert(0U == this->m_block_size);
+	assert(0U != block_size);
+	this->m_block_size = block_size;
+
+	assert(0U == this->m_read_ahead_block_count);
+	this->m_read_ahead_block_count = read_ahead_block_count;
+}
+
+void import_asset_buffered_input_stream_factory::uninit()
+{
+	assert(NULL != this->m_underlying_input_stream_factory);
+	this->m_underlying_input_stream_factory = NULL;
+
+	this->m_block_size = 0U;
+
+	this->m_read_ahead_block_count = 0U;
+}
+
+import_asset_buffered_input_stream_factory::~import_asset_buffered_input_stream_factory()
+{
+	assert(NULL == this->m_underlying_input_stream_factory);
+	assert(0U == this->m_block_size);
+	assert(0U == this->m_read_ahead_block_count);
+}
+
+import_asset_input_stream *import_asset_buffered_input_stream_factory::create_instance(char const *file_name)
+{
+	import_asset_input_stream *underlying_input_stream = this->m_underlying_input_stream_factory->create_instance(file_name);
+	if (NULL == underlying_input_stream)
+	{
+		return NULL;
+	}
+
+	void *new_unwrapped_input_stream_base = mcrt_malloc(sizeof(import_asset_buffered_input_stream), alignof(import_asset_buffered_input_stream));
+	assert(NULL != new_unwrapped_input_stream_base);
+
+	import_asset_buffered_input_stream *new_unwrapped_input_stream = new (new_unwrapped_input_stream_base) import_asset_buffered_input_stream{};
+	new_unwrapped_input_stream->init(underlying_input_stream, this->m_block_size, this->m_read_ahead_block_count);
+	return new_unwrapped_input_stream;
+}
+
+void import_asset_buffered_input_stream_factory::destory_instance(import_asset_input_stream *wrapped_input_stream)
+{
+	assert(NULL != wrapped_input_stream);
+	import_asset_buffered_input_stream *delete_unwrapped_input_stream = static_cast<import_asset_buffered_input_stream *>(wrapped_input_stream);
+
+	import_asset_input_stream *underlying_input_stream = delete_unwrapped_input_stream->uninit();
+
+	delete_unwrapped_input_stream->~import_asset_buffered_input_stream();
+	mcrt_free(delete_unwrapped_input_stream);
+
+	this->m_underlying_input_stream_factory->destory_instance(underlying_input_stream);
+}
+
+import_asset_buffered_input_stream::import_asset_buffered_input_stream() : m_underlying_input_stream(NULL), m_buffer(NULL), m_block_size(0U), m_read_ahead_block_count(0U), m_read_ahead_pending(false), m_buffer_block(NULL), m_buffer_offset(0), m_buffer_size(0U), m_offset(0), m_size(-1)
+{
+}
+
+void import_asset_buffered_input_stream::init(import_asset_input_stream *underlying_input_stream, size_t block_size, size_t read_ahead_block_count)
+{
+	assert(NULL == this->m_underlying_input_stream);
+	this->m_underlying_input_stream = underlying_input_stream;
+
+	// the buffer is allocated lazily since the stream may be only used by the positional reads
+	assert(NULL == this->m_buffer);
+
+	assert(0U == this->m_block_size);
+	this->m_block_size = block_size;
+
+	assert(0U == this->m_read_ahead_block_count);
+	this->m_read_ahead_block_count = read_ahead_block_count;
+
+	assert(this->m_block_read_requests.empty());
+	assert(!this->m_read_ahead_pending);
+	assert(NULL == this->m_buffer_block);
+	assert(0 == this->m_buffer_offset);
+	assert(0U == this->m_buffer_size);
+	assert(0 == this->m_offset);
+	assert(-1 == this->m_size);
+}
+
+import_asset_input_stream *import_asset_buffered_input_stream::uninit()
+{
+	assert(NULL != this->m_underlying_input_stream);
+	import_asset_input_stream *underlying_input_stream = this->m_underlying_input_stream;
+	this->m_underlying_input_stream = NULL;
+
+	// the read-ahead requests may be still writing into the buffer
+	if (this->m_read_ahead_pending)
+	{
+		int const status = underlying_input_stream->read_wait();
+		assert(0 == status);
+		(void)status;
+		this->m_read_ahead_pending = false;
+	}
+
+	if (NULL != this->m_buffer)
+	{
+		mcrt_free(this->m_buffer);
+		this->m_buffer = NULL;
+	}
+
+	this->m_block_size = 0U;
+	this->m_read_ahead_block_count = 0U;
+	this->m_block_read_requests.clear();
+	this->m_buffer_block = NULL;
+	this->m_buffer_offset = 0;
+	this->m_buffer_size = 0U;
+	this->m_offset = 0;
+	this->m_size = -1;
+
+	return underlying_input_stream;
+}
+
+import_asset_buffered_input_stream::~import_asset_buffered_input_stream()
+{
+	assert(NULL == this->m_underlying_input_stream);
+	assert(NULL == this->m_buffer);
+	assert(0U == this->m_block_size);
+	assert(0U == this->m_read_ahead_block_count);
+	assert(!this->m_read_ahead_pending);
+}
+
+int import_asset_buffered_input_stream::stat_size(int64_t *size)
+{
+	if (-1 == this->m_size)
+	{
+		int64_t underlying_size;
+		if (-1 == this->m_underlying_input_stream->stat_size(&underlying_size))
+		{
+			return -1;
+		}
+		this->m_size = underlying_size;
+	}
+
+	(*size) = this->m_size;
+	return 0;
+}
+
+intptr_t import_asset_buffered_input_stream::read(void *data, size_t size)
+{
+	if (this->m_offset < 0)
+	{
+		return -1;
+	}
+
+	size_t read_offset = 0U;
+	while (read_offset < size)
+	{
+		// hit
+		if ((this->m_offset >= this->m_buffer_offset) && (this->m_offset < (this->m_buffer_offset + static_cast<int64_t>(this->m_buffer_size))))
+		{
+			size_t const copy_size = std::min(size - read_offset, static_cast<size_t>((this->m_buffer_offset + static_cast<int64_t>(this->m_buffer_size)) - this->m_offset));
+			std::memcpy(static_cast<uint8_t *>(data) + read_offset, static_cast<uint8_t const *>(this->m_buffer_block) + (this->m_offset - this->m_buffer_offset), copy_size);
+			this->m_offset += copy_size;
+			read_offset += copy_size;
+			continue;
+		}
+
+		// the large read bypasses the buffer and is read into the caller memory directly
+		if ((size - read_offset) >= this->m_block_size)
+		{
+			intptr_t const direct_read_size = this->m_underlying_input_stream->read_at(this->m_offset, static_cast<uint8_t *>(data) + read_offset, size - read_offset);
+			if (-1 == direct_read_size)
+			{
+				return (read_offset > 0U) ? static_cast<intptr_t>(read_offset) : -1;
+			}
+
+			this->m_offset += direct_read_size;
+			read_offset += direct_read_size;
+			break;
+		}
+
+		// miss: read the whole block (aligned to the block size to make the small backward seeks hit as well)
+		size_t const slot_count = this->m_read_ahead_block_count + 1U;
+		if (NULL == this->m_buffer)
+		{
+			this->m_buffer = mcrt_malloc(this->m_block_size * slot_count, 64U);
+			assert(NULL != this->m_buffer);
+
+			this->m_block_read_requests.resize(slot_count);
+			for (size_t slot_index = 0U; slot_index < slot_count; ++slot_index)
+			{
+				this->m_block_read_requests[slot_index].offset = -1;
+				this->m_block_read_requests[slot_index].size = this->m_block_size;
+				this->m_block_read_requests[slot_index].data = static_cast<uint8_t *>(this->m_buffer) + this->m_block_size * slot_index;
+				this->m_block_read_requests[slot_index].result = -1;
+			}
+		}
+
+		int64_t const block_offset = this->m_offset - (this->m_offset % static_cast<int64_t>(this->m_block_size));
+
+		IMPORT_ASSET_INPUT_STREAM_READ_REQUEST &block_read_request = this->m_block_read_requests[static_cast<size_t>((block_offset / static_cast<int64_t>(this->m_block_size)) % static_cast<int64_t>(slot_count))];
+
+		// the slot may be still being written by the read-ahead (no matter whether the block is the one read ahead)
+		if (!this->wait_read_ahead())
+		{
+			this->m_buffer_block = NULL;
+			this->m_buffer_offset = 0;
+			this->m_buffer_size = 0U;
+			return (read_offset > 0U) ? static_cast<intptr_t>(read_offset) : -1;
+		}
+
+		// the failed read-ahead is retried synchronously
+		if ((block_offset != block_read_request.offset) || (-1 == block_read_request.result))
+		{
+			block_read_request.offset = block_offset;
+			block_read_request.result = this->m_underlying_input_stream->read_at(block_offset, block_read_request.data, this->m_block_size);
+		}
+
+		if (-1 == block_read_request.result)
+		{
+			block_read_request.offset = -1;
+			this->m_buffer_block = NULL;
+			this->m_buffer_offset = 0;
+			this->m_buffer_size = 0U;
+			return (read_offset > 0U) ? static_cast<intptr_t>(read_offset) : -1;
+		}
+
+		this->m_buffer_block = block_read_request.data;
+		this->m_buffer_offset = block_offset;
+		this->m_buffer_size = static_cast<size_t>(block_read_request.result);
+
+		// NOTE: the following blocks are read ahead only if the end of file is NOT reached
+		if (this->m_buffer_size == this->m_block_size)
+		{
+			this->read_ahead(block_offset);
+		}
+
+		// end of file
+		if (this->m_offset >= (this->m_buffer_offset + static_cast<int64_t>(this->m_buffer_size)))
+		{
+			break;
+		}
+	}
+
+	return static_cast<intptr_t>(read_offset);
+}
+
+int64_t import_asset_buffered_input_stream::seek(int64_t offset, int whence)
+{
+	// NOTE: no I/O here (except the first "SEEK_END") and the seek within the buffer is free
+	int64_t new_offset;
+	switch (whence)
+	{
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_SET:
+		new_offset = offset;
+		break;
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_CUR:
+		new_offset = this->m_offset + offset;
+		break;
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_END:
+	{
+		int64_t size;
+		if (-1 == this->stat_size(&size))
+		{
+			return -1;
+		}
+		new_offset = size + offset;
+	}
+	break;
+	default:
+		assert(false);
+		new_offset = -1;
+	}
+
+	if (new_offset < 0)
+	{
+		return -1;
+	}
+
+	this->m_offset = new_offset;
+	return this->m_offset;
+}
+
+intptr_t import_asset_buffered_input_stream::read_at(int64_t offset, void *data, size_t size)
+{
+	// the buffer is owned by "read" and can NOT be used here since "read_at" should be safe to be called concurrently
+	return this->m_underlying_input_stream->read_at(offset, data, size);
+}
+
+bool import_asset_buffered_input_stream::is_read_at_thread_safe() const
+{
+	return this->m_underlying_input_stream->is_read_at_thread_safe();
+}
+
+int import_asset_buffered_input_stream::map_range(int64_t offset, size_t size, void const **data)
+{
+	return this->m_underlying_input_stream->map_range(offset, size, data);
+}
+
+int import_asset_buffered_input_stream::read_submit(size_t request_count, IMPORT_ASSET_INPUT_STREAM_READ_REQUEST *requests)
+{
+	return this->m_underlying_input_stream->read_submit(request_count, requests);
+}
+
+intptr_t import_asset_buffered_input_stream::read_poll()
+{
+	return this->m_underlying_input_stream->read_poll();
+}
+
+int import_asset_buffered_input_stream::read_wait()
+{
+	return this->m_underlying_input_stream->read_wait();
+}
+
+bool import_asset_buffered_input_stream::wait_read_ahead()
+{
+	if (this->m_read_ahead_pending)
+	{
+		// NOTE: "read_wait" of the underlying input stream waits for the requests submitted by the caller as well
+		intptr_t const pending_request_count = this->m_underlying_input_stream->read_poll();
+		if ((0 != pending_request_count) && (0 != this->m_underlying_input_stream->read_wait()))
+		{
+			return false;
+		}
+
+		this->m_read_ahead_pending = false;
+	}
+
+	return true;
+}
+
+void import_asset_buffered_input_stream::read_ahead(int64_t block_offset)
+{
+	size_t const slot_count = this->m_read_ahead_block_count + 1U;
+	size_t const block_slot_index = static_cast<size_t>((block_offset / static_cast<int64_t>(this->m_block_size)) % static_cast<int64_t>(slot_count));
+
+	// the slots of the following blocks are distinct from the slot of the current block
+	size_t read_ahead_block_count = 0U;
+	bool slot_reused = false;
+	for (size_t read_ahead_block_index = 1U; read_ahead_block_index <= this->m_read_ahead_block_count; ++read_ahead_block_index)
+	{
+		int64_t const read_ahead_block_offset = block_offset + static_cast<int64_t>(this->m_block_size * read_ahead_block_index);
+		if ((-1 != this->m_size) && (read_ahead_block_offset >= this->m_size))
+		{
+			break;
+		}
+
+		++read_ahead_block_count;
+		slot_reused = slot_reused || (read_ahead_block_offset != this->m_block_read_requests[(block_slot_index + read_ahead_block_index) % slot_count].offset);
+	}
+
+	// the reused slots may be still being written by the previous read-ahead
+	if ((!slot_reused) || (!this->wait_read_ahead()))
+	{
+		return;
+	}
+
+	// the requests of the contiguous slots are submitted together
+	size_t submit_slot_index = 0U;
+	size_t submit_slot_count = 0U;
+	for (size_t read_ahead_block_index = 1U; read_ahead_block_index <= (read_ahead_block_count + 1U); ++read_ahead_block_index)
+	{
+		size_t const read_ahead_slot_index = (block_slot_index + read_ahead_block_index) % slot_count;
+		int64_t const read_ahead_block_offset = block_offset + static_cast<int64_t>(this->m_block_size * read_ahead_block_index);
+
+		bool const submit = (read_ahead_block_index <= read_ahead_block_count) && (read_ahead_block_offset != this->m_block_read_requests[read_ahead_slot_index].offset);
+
+		if ((submit_slot_count > 0U) && ((!submit) || (0U == read_ahead_slot_index)))
+		{
+			if (-1 == this->m_underlying_input_stream->read_submit(submit_slot_count, &this->m_block_read_requests[submit_slot_index]))
+			{
+				// the failed slots are dropped (the requests may be still pending and are waited before the slots are reused)
+				for (size_t slot_index = submit_slot_index; slot_index < (submit_slot_index + submit_slot_count); ++slot_index)
+				{
+					this->m_block_read_requests[slot_index].offset = -1;
+				}
+			}
+
+			this->m_read_ahead_pending = true;
+			submit_slot_count = 0U;
+		}
+
+		if (submit)
+		{
+			if (0U == submit_slot_count)
+			{
+				submit_slot_index = read_ahead_slot_index;
+			}
+
+			this->m_block_read_requests[read_ahead_slot_index].offset = read_ahead_block_offset;
+			this->m_block_read_requests[read_ahead_slot_index].result = -1;
+			++submit_slot_count;
+		}
+	}
+}
@@ -0,0 +1,81 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _IMPORT_ASSET_BUFFERED_INPUT_STREAM_H_
+#define _IMPORT_ASSET_BUFFERED_INPUT_STREAM_H_ 1
+
+#include "../include/import_asset_input_stream.h"
+#include "../../McRT-Malloc/include/mcrt_vector.h"
+
+class import_asset_buffered_input_stream_factory final : public import_asset_input_stream_factory
+{
+	import_asset_input_stream_factory *m_underlying_input_stream_factory;
+	size_t m_block_size;
+	size_t m_read_ahead_block_count;
+
+public:
+	import_asset_buffered_input_stream_factory();
+	void init(import_asset_input_stream_factory *underlying_input_stream_factory, size_t block_size, size_t read_ahead_block_count);
+	void uninit();
+	~import_asset_buffered_input_stream_factory();
+
+private:
+	virtual import_asset_input_stream *create_instance(char const *file_name) override;
+	virtual void destory_instance(import_asset_input_stream *input_stream) override;
+};
+
+class import_asset_buffered_input_stream final : public import_asset_input_stream
+{
+	// NOTE: the underlying input stream is only accessed by the positional reads and the position is tracked here
+	import_asset_input_stream *m_underlying_input_stream;
+	// the buffer is divided into "1 + m_read_ahead_block_count" slots and the block is always in the slot "(block offset / m_block_size) % (1 + m_read_ahead_block_count)"
+	void *m_buffer;
+	size_t m_block_size;
+	size_t m_read_ahead_block_count;
+	// the read requests of the slots ("offset" is -1 if the slot is empty) which are kept alive while they are submitted to the underlying input stream
+	mcrt_vector<IMPORT_ASSET_INPUT_STREAM_READ_REQUEST> m_block_read_requests;
+	// the read-ahead requests may be NOT completed until "read_wait" of the underlying input stream is called
+	bool m_read_ahead_pending;
+	// [m_buffer_offset, m_buffer_offset + m_buffer_size) of the underlying input stream is in "m_buffer_block"
+	void const *m_buffer_block;
+	int64_t m_buffer_offset;
+	size_t m_buffer_size;
+	int64_t m_offset;
+	// -1 until "stat_size" of the underlying input stream is called
+	int64_t m_size;
+
+public:
+	import_asset_buffered_input_stream();
+	void init(import_asset_input_stream *underlying_input_stream, size_t block_size, size_t read_ahead_block_count);
+	import_asset_input_stream *uninit();
+	~import_asset_buffered_input_stream();
+	int stat_size(int64_t *size) override;
+	intptr_t read(void *data, size_t size) override;
+	int64_t seek(int64_t offset, int whence) override;
+	intptr_t read_at(int64_t offset, void *data, size_t size) override;
+	bool is_read_at_thread_safe() const override;
+	int map_range(int64_t offset, size_t size, void const **data) override;
+	int read_submit(size_t request_count, IMPORT_ASSET_INPUT_STREAM_READ_REQUEST *requests) override;
+	intptr_t read_poll() override;
+	int read_wait() override;
+
+private:
+	bool wait_read_ahead();
+	void read_ahead(int64_t block_offset);
+};
+
+#endif
@@ -0,0 +1,598 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "import_asset_compressed_input_stream.h"
+#include "../../McRT-Malloc/include/mcrt_malloc.h"
+#include <new>
+#include <cstring>
+#include <algorithm>
+#include <utility>
+#include <assert.h>
+
+static constexpr uint32_t const INVALID_BLOCK_INDEX = static_cast<uint32_t>(~static_cast<uint32_t>(0U));
+
+static inline intptr_t import_asset_lz4_decompress_block(void const *source, size_t source_size, void *destination, size_t destination_capacity);
+
+extern import_asset_input_stream_factory *import_asset_init_compressed_input_stream_factory(import_asset_input_stream_factory *underlying_input_stream_factory)
+{
+	void *new_unwrapped_input_stream_factory_base = mcrt_malloc(sizeof(import_asset_compressed_input_stream_factory), alignof(import_asset_compressed_input_stream_factory));
+	assert(NULL != new_unwrapped_input_stream_factory_base);
+
+	import_asset_compressed_input_stream_factory *new_unwrapped_input_stream_factory = new (new_unwrapped_input_stream_factory_base) import_asset_compressed_input_stream_factory{};
+	new_unwrapped_input_stream_factory->init(underlying_input_stream_factory);
+	return new_unwrapped_input_stream_factory;
+}
+
+extern void import_asset_destroy_compressed_input_stream_factory(import_asset_input_stream_factory *wrapped_input_stream_factory)
+{
+	assert(NULL != wrapped_input_stream_factory);
+	import_asset_compressed_input_stream_factory *delete_unwrapped_input_stream_factory = static_cast<import_asset_compressed_input_stream_factory *>(wrapped_input_stream_factory);
+
+	delete_unwrapped_input_stream_factory->uninit();
+
+	delete_unwrapped_input_stream_factory->~import_asset_compressed_input_stream_factory();
+	mcrt_free(delete_unwrapped_input_stream_factory);
+}
+
+import_asset_compressed_input_stream_factory::import_asset_compressed_input_stream_factory() : m_underlying_input_stream_factory(NULL)
+{
+}
+
+void import_asset_compressed_input_stream_factory::init(import_asset_input_stream_factory *underlying_input_stream_factory)
+{
+	assert(NULL == this->m_underlying_input_stream_factory);
+	this->m_underlying_input_stream_factory = underlying_input_stream_factory;
+}
+
+void import_asset_compressed_input_stream_factory::uninit()
+{
+	assert(NULL != this->m_underlying_input_stream_factory);
+	this->m_underlying_input_stream_factory = NULL;
+}
+
+import_asset_compressed_input_stream_factory::~import_asset_compressed_input_stream_factory()
+{
+	assert(NULL == this->m_underlying_input_stream_factory);
+}
+
+import_asset_input_stream *import_asset_compressed_input_stream_factory::create_instance(char const *file_name)
+{
+	import_asset_input_stream *underlying_input_stream = this->m_underlying_input_stream_factory->create_instance(file_name);
+	if (NULL == underlying_input_stream)
+	{
+		return NULL;
+	}
+
+	int64_t underlying_size;
+	if (-1 == underlying_input_stream->stat_size(&underlying_size))
+	{
+		this->m_underlying_input_stream_factory->destory_instance(underlying_input_stream);
+		return NULL;
+	}
+
+	IMPORT_ASSET_COMPRESSED_HEADER header;
+	bool compressed = (underlying_size >= static_cast<int64_t>(sizeof(IMPORT_ASSET_COMPRESSED_HEADER))) && (sizeof(IMPORT_ASSET_COMPRESSED_HEADER) == underlying_input_stream->read_at(0, &header, sizeof(IMPORT_ASSET_COMPRESSED_HEADER))) && (IMPORT_ASSET_COMPRESSED_MAGIC == header.magic);
+
+	mcrt_vector<IMPORT_ASSET_COMPRESSED_BLOCK> blocks;
+	if (compressed)
+	{
+		// NOTE: the header is NOT trusted and the checks are written such that the unsigned arithmetic does NOT wrap
+		uint64_t const blocks_size = sizeof(IMPORT_ASSET_COMPRESSED_BLOCK) * static_cast<uint64_t>(header.block_count);
+		if ((IMPORT_ASSET_COMPRESSED_VERSION != header.version) || (0U == header.block_size) || (header.uncompressed_size > static_cast<uint64_t>(INT64_MAX)) || (((header.uncompressed_size / header.block_size) + ((0U != (header.uncompressed_size % header.block_size)) ? 1U : 0U)) != header.block_count) || (blocks_size > static_cast<uint64_t>(underlying_size)) || (header.blocks_offset > (static_cast<uint64_t>(underlying_size) - blocks_size)))
+		{
+			this->m_underlying_input_stream_factory->destory_instance(underlying_input_stream);
+			return NULL;
+		}
+
+		blocks.resize(static_cast<size_t>(header.block_count));
+		if ((header.block_count > 0U) && (static_cast<intptr_t>(sizeof(IMPORT_ASSET_COMPRESSED_BLOCK) * blocks.size()) != underlying_input_stream->read_at(header.blocks_offset, blocks.data(), sizeof(IMPORT_ASSET_COMPRESSED_BLOCK) * blocks.size())))
+		{
+			this->m_underlying_input_stream_factory->destory_instance(underlying_input_stream);
+			return NULL;
+		}
+
+		for (uint32_t block_index = 0U; block_index < header.block_count; ++block_index)
+		{
+			IMPORT_ASSET_COMPRESSED_BLOCK const &block = blocks[block_index];
+
+			uint64_t const block_uncompressed_size = std::min(static_cast<uint64_t>(header.block_size), header.uncompressed_size - static_cast<uint64_t>(header.block_size) * block_index);
+
+			// LZ4 worst case: "LZ4_COMPRESSBOUND"
+			// Zstandard worst case: "ZSTD_COMPRESSBOUND"
+			if ((block.data_size > static_cast<uint64_t>(underlying_size)) || (block.data_offset > (static_cast<uint64_t>(underlying_size) - block.data_size)) || ((IMPORT_ASSET_COMPRESSED_BLOCK_COMPRESSION_NONE == block.compression) && (block_uncompressed_size != block.data_size)) || ((IMPORT_ASSET_COMPRESSED_BLOCK_COMPRESSION_LZ4 == block.compression) && (block.data_size > (block_uncompressed_size + (block_uncompressed_size / 255U) + 16U))) || ((IMPORT_ASSET_COMPRESSED_BLOCK_COMPRESSION_ZSTD == block.compression) && (block.data_size > (block_uncompressed_size + (block_uncompressed_size >> 8U) + ((block_uncompressed_size < (128U << 10U)) ? (((128U << 10U) - block_uncompressed_size) >> 11U) : 0U)))) || ((IMPORT_ASSET_COMPRESSED_BLOCK_COMPRESSION_NONE != block.compression) && (IMPORT_ASSET_COMPRESSED_BLOCK_COMPRESSION_LZ4 != block.compression) && (IMPORT_ASSET_COMPRESSED_BLOCK_COMPRESSION_ZSTD != block.compression)))
+			{
+				this->m_underlying_input_stream_factory->destory_instance(underlying_input_stream);
+				return NULL;
+			}
+		}
+	}
+
+	void *new_unwrapped_input_stream_base = mcrt_malloc(sizeof(import_asset_compressed_input_stream), alignof(import_asset_compressed_input_stream));
+	assert(NULL != new_unwrapped_input_stream_base);
+
+	import_asset_compressed_input_stream *new_unwrapped_input_stream = new (new_unwrapped_input_stream_base) import_asset_compressed_input_stream{};
+	if (compressed)
+	{
+		new_unwrapped_input_stream->init(underlying_input_stream, header.block_size, static_cast<int64_t>(header.uncompressed_size), std::move(blocks));
+	}
+	else
+	{
+		new_unwrapped_input_stream->init(underlying_input_stream);
+	}
+	return new_unwrapped_input_stream;
+}
+
+void import_asset_compressed_input_stream_factory::destory_instance(import_asset_input_stream *wrapped_input_stream)
+{
+	assert(NULL != wrapped_input_stream);
+	import_asset_compressed_input_stream *delete_unwrapped_input_stream = static_cast<import_asset_compressed_input_stream *>(wrapped_input_stream);
+
+	import_asset_input_stream *underlying_input_stream = delete_unwrapped_input_stream->uninit();
+
+	delete_unwrapped_input_stream->~import_asset_compressed_input_stream();
+	mcrt_free(delete_unwrapped_input_stream);
+
+	this->m_underlying_input_stream_factory->destory_instance(underlying_input_stream);
+}
+
+import_asset_compressed_input_stream::import_asset_compressed_input_stream() : m_underlying_input_stream(NULL), m_compressed(false), m_block_size(0U), m_uncompressed_size(0), m_offset(0)
+{
+}
+
+void import_asset_compressed_input_stream::init(import_asset_input_stream *underlying_input_stream, uint32_t block_size, int64_t uncompressed_size, mcrt_vector<IMPORT_ASSET_COMPRESSED_BLOCK> &&blocks)
+{
+	assert(NULL == this->m_underlying_input_stream);
+	this->m_underlying_input_stream = underlying_input_stream;
+
+	assert(!this->m_compressed);
+	this->m_compressed = true;
+
+	assert(0U == this->m_block_size);
+	this->m_block_size = block_size;
+
+	assert(0 == this->m_uncompressed_size);
+	this->m_uncompressed_size = uncompressed_size;
+
+	assert(this->m_blocks.empty());
+	this->m_blocks = std::move(blocks);
+
+	assert(0 == this->m_offset);
+	assert(this->m_block_caches.empty());
+}
+
+void import_asset_compressed_input_stream::init(import_asset_input_stream *underlying_input_stream)
+{
+	assert(NULL == this->m_underlying_input_stream);
+	this->m_underlying_input_stream = underlying_input_stream;
+
+	assert(!this->m_compressed);
+}
+
+import_asset_input_stream *import_asset_compressed_input_stream::uninit()
+{
+	assert(NULL != this->m_underlying_input_stream);
+	import_asset_input_stream *underlying_input_stream = this->m_underlying_input_stream;
+	this->m_underlying_input_stream = NULL;
+
+	this->m_compressed = false;
+	this->m_block_size = 0U;
+	this->m_uncompressed_size = 0;
+	this->m_blocks.clear();
+	this->m_offset = 0;
+
+	// all caches have been released since no read is in progress
+	for (import_asset_compressed_block_cache *const block_cache : this->m_block_caches)
+	{
+		if (NULL != block_cache->m_zstd_context)
+		{
+			ZSTD_freeDCtx(block_cache->m_zstd_context);
+		}
+
+		block_cache->~import_asset_compressed_block_cache();
+		mcrt_free(block_cache);
+	}
+	this->m_block_caches.clear();
+
+	return underlying_input_stream;
+}
+
+import_asset_compressed_input_stream::~import_asset_compressed_input_stream()
+{
+	assert(NULL == this->m_underlying_input_stream);
+	assert(!this->m_compressed);
+	assert(0 == this->m_offset);
+	assert(this->m_block_caches.empty());
+}
+
+int import_asset_compressed_input_stream::stat_size(int64_t *size)
+{
+	if (!this->m_compressed)
+	{
+		return this->m_underlying_input_stream->stat_size(size);
+	}
+
+	(*size) = this->m_uncompressed_size;
+	return 0;
+}
+
+intptr_t import_asset_compressed_input_stream::read(void *data, size_t size)
+{
+	if (!this->m_compressed)
+	{
+		return this->m_underlying_input_stream->read(data, size);
+	}
+
+	import_asset_compressed_block_cache *const block_cache = this->acquire_block_cache(this->m_offset);
+	intptr_t read_size = this->read_blocks(this->m_offset, data, size, block_cache);
+	this->release_block_cache(block_cache);
+
+	if (read_size > 0)
+	{
+		this->m_offset += read_size;
+	}
+
+	return read_size;
+}
+
+int64_t import_asset_compressed_input_stream::seek(int64_t offset, int whence)
+{
+	if (!this->m_compressed)
+	{
+		return this->m_underlying_input_stream->seek(offset, whence);
+	}
+
+	// NOTE: no I/O here and the block is located by "offset / block_size" when read
+	int64_t new_offset;
+	switch (whence)
+	{
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_SET:
+		new_offset = offset;
+		break;
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_CUR:
+		new_offset = this->m_offset + offset;
+		break;
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_END:
+		new_offset = this->m_uncompressed_size + offset;
+		break;
+	default:
+		assert(false);
+		new_offset = -1;
+	}
+
+	if (new_offset < 0)
+	{
+		return -1;
+	}
+
+	this->m_offset = new_offset;
+	return this->m_offset;
+}
+
+intptr_t import_asset_compressed_input_stream::read_at(int64_t offset, void *data, size_t size)
+{
+	if (!this->m_compressed)
+	{
+		return this->m_underlying_input_stream->read_at(offset, data, size);
+	}
+
+	// the blocks are independent and each concurrent call uses its own cache to be safe to be called concurrently
+	import_asset_compressed_block_cache *const block_cache = this->acquire_block_cache(offset);
+	intptr_t const read_size = this->read_blocks(offset, data, size, block_cache);
+	this->release_block_cache(block_cache);
+
+	return read_size;
+}
+
+bool import_asset_compressed_input_stream::is_read_at_thread_safe() const
+{
+	return this->m_underlying_input_stream->is_read_at_thread_safe();
+}
+
+int import_asset_compressed_input_stream::map_range(int64_t offset, size_t size, void const **data)
+{
+	if (!this->m_compressed)
+	{
+		return this->m_underlying_input_stream->map_range(offset, size, data);
+	}
+
+	// the uncompressed data does NOT exist in the underlying input stream
+	return -1;
+}
+
+int import_asset_compressed_input_stream::read_submit(size_t request_count, IMPORT_ASSET_INPUT_STREAM_READ_REQUEST *requests)
+{
+	if (!this->m_compressed)
+	{
+		return this->m_underlying_input_stream->read_submit(request_count, requests);
+	}
+
+	// the blocks are decompressed synchronously by "read_at"
+	return import_asset_input_stream::read_submit(request_count, requests);
+}
+
+intptr_t import_asset_compressed_input_stream::read_poll()
+{
+	if (!this->m_compressed)
+	{
+		return this->m_underlying_input_stream->read_poll();
+	}
+
+	return 0;
+}
+
+int import_asset_compressed_input_stream::read_wait()
+{
+	if (!this->m_compressed)
+	{
+		return this->m_underlying_input_stream->read_wait();
+	}
+
+	return 0;
+}
+
+import_asset_compressed_block_cache *import_asset_compressed_input_stream::acquire_block_cache(int64_t offset)
+{
+	uint32_t const block_index = ((offset >= 0) && (offset < this->m_uncompressed_size)) ? static_cast<uint32_t>(offset / this->m_block_size) : INVALID_BLOCK_INDEX;
+
+	{
+		std::lock_guard<std::mutex> lock_guard(this->m_block_caches_mutex);
+
+		if (!this->m_block_caches.empty())
+		{
+			// prefer the cache which already contains the first block (otherwise the cache released most recently)
+			size_t cache_index = this->m_block_caches.size() - 1U;
+			for (size_t candidate_cache_index = 0U; candidate_cache_index < this->m_block_caches.size(); ++candidate_cache_index)
+			{
+				if (block_index == this->m_block_caches[candidate_cache_index]->m_block_index)
+				{
+					cache_index = candidate_cache_index;
+					break;
+				}
+			}
+
+			import_asset_compressed_block_cache *const block_cache = this->m_block_caches[cache_index];
+			this->m_block_caches[cache_index] = this->m_block_caches.back();
+			this->m_block_caches.pop_back();
+			return block_cache;
+		}
+	}
+
+	void *new_block_cache_base = mcrt_malloc(sizeof(import_asset_compressed_block_cache), alignof(import_asset_compressed_block_cache));
+	assert(NULL != new_block_cache_base);
+
+	import_asset_compressed_block_cache *new_block_cache = new (new_block_cache_base) import_asset_compressed_block_cache{};
+	new_block_cache->m_block_index = INVALID_BLOCK_INDEX;
+	new_block_cache->m_zstd_context = NULL;
+	return new_block_cache;
+}
+
+void import_asset_compressed_input_stream::release_block_cache(import_asset_compressed_block_cache *block_cache)
+{
+	std::lock_guard<std::mutex> lock_guard(this->m_block_caches_mutex);
+
+	this->m_block_caches.push_back(block_cache);
+}
+
+intptr_t import_asset_compressed_input_stream::read_blocks(int64_t offset, void *data, size_t size, import_asset_compressed_block_cache *block_cache)
+{
+	if (offset < 0)
+	{
+		return -1;
+	}
+
+	if (offset >= this->m_uncompressed_size)
+	{
+		return 0;
+	}
+
+	size_t const read_size = static_cast<size_t>(std::min(static_cast<int64_t>(size), this->m_uncompressed_size - offset));
+
+	size_t read_offset = 0U;
+	while (read_offset < read_size)
+	{
+		int64_t const current_offset = offset + static_cast<int64_t>(read_offset);
+		uint32_t const block_index = static_cast<uint32_t>(current_offset / this->m_block_size);
+		size_t const block_offset = static_cast<size_t>(current_offset % this->m_block_size);
+		size_t const block_uncompressed_size = static_cast<size_t>(std::min(static_cast<int64_t>(this->m_block_size), this->m_uncompressed_size - static_cast<int64_t>(this->m_block_size) * block_index));
+		size_t const copy_size = std::min(read_size - read_offset, block_uncompressed_size - block_offset);
+
+		if ((0U == block_offset) && (block_uncompressed_size == copy_size) && (block_cache->m_block_index != block_index))
+		{
+			// the whole block is decompressed into the caller memory directly
+			if (!this->decompress_block(block_index, static_cast<uint8_t *>(data) + read_offset, block_cache))
+			{
+				return -1;
+			}
+		}
+		else
+		{
+			if (block_cache->m_block_index != block_index)
+			{
+				block_cache->m_block.resize(this->m_block_size);
+				if (!this->decompress_block(block_index, block_cache->m_block.data(), block_cache))
+				{
+					block_cache->m_block_index = INVALID_BLOCK_INDEX;
+					return -1;
+				}
+				block_cache->m_block_index = block_index;
+			}
+
+			std::memcpy(static_cast<uint8_t *>(data) + read_offset, block_cache->m_block.data() + block_offset, copy_size);
+		}
+
+		read_offset += copy_size;
+	}
+
+	return static_cast<intptr_t>(read_size);
+}
+
+bool import_asset_compressed_input_stream::decompress_block(uint32_t block_index, void *data, import_asset_compressed_block_cache *block_cache)
+{
+	IMPORT_ASSET_COMPRESSED_BLOCK const &block = this->m_blocks[block_index];
+	size_t const block_uncompressed_size = static_cast<size_t>(std::min(static_cast<int64_t>(this->m_block_size), this->m_uncompressed_size - static_cast<int64_t>(this->m_block_size) * block_index));
+
+	if (IMPORT_ASSET_COMPRESSED_BLOCK_COMPRESSION_NONE == block.compression)
+	{
+		return (static_cast<intptr_t>(block_uncompressed_size) == this->m_underlying_input_stream->read_at(static_cast<int64_t>(block.data_offset), data, block_uncompressed_size));
+	}
+	else
+	{
+		assert((IMPORT_ASSET_COMPRESSED_BLOCK_COMPRESSION_LZ4 == block.compression) || (IMPORT_ASSET_COMPRESSED_BLOCK_COMPRESSION_ZSTD == block.compression));
+
+		// decompress from the mapping directly if the underlying input stream is able to provide the view
+		void const *compressed_data;
+		if (-1 == this->m_underlying_input_stream->map_range(static_cast<int64_t>(block.data_offset), block.data_size, &compressed_data))
+		{
+			block_cache->m_compressed_block.resize(block.data_size);
+			if (static_cast<intptr_t>(block.data_size) != this->m_underlying_input_stream->read_at(static_cast<int64_t>(block.data_offset), block_cache->m_compressed_block.data(), block.data_size))
+			{
+				return false;
+			}
+			compressed_data = block_cache->m_compressed_block.data();
+		}
+
+		if (IMPORT_ASSET_COMPRESSED_BLOCK_COMPRESSION_LZ4 == block.compression)
+		{
+			return (static_cast<intptr_t>(block_uncompressed_size) == import_asset_lz4_decompress_block(compressed_data, block.data_size, data, block_uncompressed_size));
+		}
+		else
+		{
+			// the context is reused by the blocks decompressed by the same cache
+			if (NULL == block_cache->m_zstd_context)
+			{
+				block_cache->m_zstd_context = ZSTD_createDCtx();
+				if (NULL == block_cache->m_zstd_context)
+				{
+					return false;
+				}
+			}
+
+			size_t const decompressed_size = ZSTD_decompressDCtx(block_cache->m_zstd_context, data, block_uncompressed_size, compressed_data, block.data_size);
+			return ((!ZSTD_isError(decompressed_size)) && (block_uncompressed_size == decompressed_size));
+		}
+	}
+}
+
+static inline intptr_t import_asset_lz4_decompress_block(void const *source, size_t source_size, void *destination, size_t destination_capacity)
+{
+	// https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+	// NOTE: the input is NOT trusted and all lengths and offsets are validated
+
+	uint8_t const *input = static_cast<uint8_t const *>(source);
+	uint8_t const *const input_end = input + source_size;
+	uint8_t *output = static_cast<uint8_t *>(destination);
+	uint8_t *const output_begin = output;
+	uint8_t *const output_end = output + destination_capacity;
+
+	while (true)
+	{
+		if (input >= input_end)
+		{
+			return -1;
+		}
+
+		uint32_t const token = (*input);
+		++input;
+
+		// literals
+		size_t literal_length = (token >> 4U);
+		if (15U == literal_length)
+		{
+			uint8_t length_byte;
+			do
+			{
+				if (input >= input_end)
+				{
+					return -1;
+				}
+				length_byte = (*input);
+				++input;
+				literal_length += length_byte;
+			} while (255U == length_byte);
+		}
+
+		if ((literal_length > static_cast<size_t>(input_end - input)) || (literal_length > static_cast<size_t>(output_end - output)))
+		{
+			return -1;
+		}
+
+		std::memcpy(output, input, literal_length);
+		input += literal_length;
+		output += literal_length;
+
+		// the last sequence contains only the literals
+		if (input == input_end)
+		{
+			break;
+		}
+
+		// match
+		if ((input_end - input) < 2)
+		{
+			return -1;
+		}
+
+		size_t const match_offset = static_cast<size_t>(input[0]) | (static_cast<size_t>(input[1]) << 8U);
+		input += 2;
+
+		if ((0U == match_offset) || (match_offset > static_cast<size_t>(output - output_begin)))
+		{
+			return -1;
+		}
+
+		size_t match_length = (token & 15U);
+		if (15U == match_length)
+		{
+			uint8_t length_byte;
+			do
+			{
+				if (input >= input_end)
+				{
+					return -1;
+				}
+				length_byte = (*input);
+				++input;
+				match_length += length_byte;
+			} while (255U == length_byte);
+		}
+		match_length += 4U;
+
+		if (match_length > static_cast<size_t>(output_end - output))
+		{
+			return -1;
+		}
+
+		uint8_t const *match = output - match_offset;
+		if (match_offset >= match_length)
+		{
+			std::memcpy(output, match, match_length);
+			output += match_length;
+		}
+		else
+		{
+			// the overlapped copy repeats the pattern
+			for (size_t byte_index = 0U; byte_index < match_length; ++byte_index)
+			{
+				(*output) = (*match);
+				++output;
+				++match;
+			}
+		}
+	}
+
+	return static_cast<intptr_t>(output - output_begin);
+}
@@ -0,0 +1,119 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _IMPORT_ASSET_COMPRESSED_INPUT_STREAM_H_
+#define _IMPORT_ASSET_COMPRESSED_INPUT_STREAM_H_ 1
+
+#include "../include/import_asset_input_stream.h"
+#include "../../McRT-Malloc/include/mcrt_vector.h"
+#include "../thirdparty/zstd/lib/zstd.h"
+#include <mutex>
+
+// Compressed Container Layout (Little Endian)
+// [IMPORT_ASSET_COMPRESSED_HEADER]
+// [IMPORT_ASSET_COMPRESSED_BLOCK] * block_count (located by "blocks_offset")
+// [Data] (each block is compressed independently and the uncompressed size of each block except the last one is "block_size")
+
+static constexpr uint32_t const IMPORT_ASSET_COMPRESSED_MAGIC = 0X5A4C4149U; // "IALZ"
+static constexpr uint32_t const IMPORT_ASSET_COMPRESSED_VERSION = 1U;
+
+enum
+{
+	IMPORT_ASSET_COMPRESSED_BLOCK_COMPRESSION_NONE = 0,
+	IMPORT_ASSET_COMPRESSED_BLOCK_COMPRESSION_LZ4 = 1,
+	IMPORT_ASSET_COMPRESSED_BLOCK_COMPRESSION_ZSTD = 2
+};
+
+struct IMPORT_ASSET_COMPRESSED_HEADER
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t block_size;
+	uint32_t block_count;
+	uint64_t uncompressed_size;
+	uint64_t blocks_offset;
+};
+static_assert(sizeof(IMPORT_ASSET_COMPRESSED_HEADER) == 32U, "");
+
+struct IMPORT_ASSET_COMPRESSED_BLOCK
+{
+	uint64_t data_offset;
+	uint32_t data_size;
+	uint32_t compression;
+};
+static_assert(sizeof(IMPORT_ASSET_COMPRESSED_BLOCK) == 16U, "");
+
+class import_asset_compressed_input_stream_factory final : public import_asset_input_stream_factory
+{
+	import_asset_input_stream_factory *m_underlying_input_stream_factory;
+
+public:
+	import_asset_compressed_input_stream_factory();
+	void init(import_asset_input_stream_factory *underlying_input_stream_factory);
+	void uninit();
+	~import_asset_compressed_input_stream_factory();
+
+private:
+	virtual import_asset_input_stream *create_instance(char const *file_name) override;
+	virtual void destory_instance(import_asset_input_stream *input_stream) override;
+};
+
+// the decompressed block is cached for the small reads and the scratch buffer of the compressed block (and the Zstandard context) is reused
+struct import_asset_compressed_block_cache
+{
+	uint32_t m_block_index;
+	mcrt_vector<uint8_t> m_block;
+	mcrt_vector<uint8_t> m_compressed_block;
+	ZSTD_DCtx *m_zstd_context;
+};
+
+class import_asset_compressed_input_stream final : public import_asset_input_stream
+{
+	// NOTE: all methods are forwarded to the underlying input stream if the file is NOT the compressed container
+	import_asset_input_stream *m_underlying_input_stream;
+	bool m_compressed;
+	uint32_t m_block_size;
+	int64_t m_uncompressed_size;
+	mcrt_vector<IMPORT_ASSET_COMPRESSED_BLOCK> m_blocks;
+	int64_t m_offset;
+	// the idle caches are pooled and shared by "read" and "read_at" (each concurrent "read_at" acquires its own cache and the number of the caches is bounded by the number of the concurrent calls)
+	std::mutex m_block_caches_mutex;
+	mcrt_vector<import_asset_compressed_block_cache *> m_block_caches;
+
+	import_asset_compressed_block_cache *acquire_block_cache(int64_t offset);
+	void release_block_cache(import_asset_compressed_block_cache *block_cache);
+	intptr_t read_blocks(int64_t offset, void *data, size_t size, import_asset_compressed_block_cache *block_cache);
+	bool decompress_block(uint32_t block_index, void *data, import_asset_compressed_block_cache *block_cache);
+
+public:
+	import_asset_compressed_input_stream();
+	void init(import_asset_input_stream *underlying_input_stream, uint32_t block_size, int64_t uncompressed_size, mcrt_vector<IMPORT_ASSET_COMPRESSED_BLOCK> &&blocks);
+	void init(import_asset_input_stream *underlying_input_stream);
+	import_asset_input_stream *uninit();
+	~import_asset_compressed_input_stream();
+	int stat_size(int64_t *size) override;
+	intptr_t read(void *data, size_t size) override;
+	int64_t seek(int64_t offset, int whence) override;
+	intptr_t read_at(int64_t offset, void *data, size_t size) override;
+	bool is_read_at_thread_safe() const override;
+	int map_range(int64_t offset, size_t size, void const **data) override;
+	int read_submit(size_t request_count, IMPORT_ASSET_INPUT_STREAM_READ_REQUEST *requests) override;
+	intptr_t read_poll() override;
+	int read_wait() override;
+};
+
+#endif
@@ -26,6 +26,9 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <errno.h>
+#include <cstring>
+#include <algorithm>
+#include "../../McRT-Malloc/include/mcrt_vector.h"
 
 #if defined(__x86_64__) || defined(__i386__)
 #include <immintrin.h>
@@ -35,6 +38,69 @@
 #error Unknown Architecture
 #endif
 
+// NOTE: the "io_uring" is blocked by the "seccomp" on Android
+// NOTE: the "IORING_OP_READ" is an enumerator (which can NOT be detected by the preprocessor) and is only declared by the uapi headers of Linux 5.6 or later
+#if defined(__linux__) && (!defined(__ANDROID__)) && __has_include(<linux/io_uring.h>) && __has_include(<linux/version.h>)
+#include <linux/version.h>
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 6, 0)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#define IMPORT_ASSET_FILE_INPUT_STREAM_IO_URING 1
+#else
+#define IMPORT_ASSET_FILE_INPUT_STREAM_IO_URING 0
+#endif
+#else
+#define IMPORT_ASSET_FILE_INPUT_STREAM_IO_URING 0
+#endif
+
+static inline void import_asset_file_input_stream_pread(int file, IMPORT_ASSET_INPUT_STREAM_READ_REQUEST *request);
+
+#if IMPORT_ASSET_FILE_INPUT_STREAM_IO_URING
+struct import_asset_file_input_stream_io_uring
+{
+	int m_ring;
+
+	void *m_sq_ring_base;
+	size_t m_sq_ring_size;
+	void *m_cq_ring_base;
+	size_t m_cq_ring_size;
+	struct io_uring_sqe *m_sqes;
+	size_t m_sqes_size;
+
+	uint32_t *m_sq_head;
+	uint32_t *m_sq_tail;
+	uint32_t m_sq_mask;
+	uint32_t m_sq_entries;
+	uint32_t *m_sq_array;
+
+	uint32_t *m_cq_head;
+	uint32_t *m_cq_tail;
+	uint32_t m_cq_mask;
+	struct io_uring_cqe *m_cqes;
+
+	// in the submission queue but NOT consumed by the kernel yet
+	uint32_t m_unsubmitted_count;
+	// consumed by the kernel but NOT completed yet
+	uint32_t m_in_flight_count;
+
+	// the requests (or the remaining parts of the short reads) which are waiting for the free entries of the submission queue
+	mcrt_vector<IMPORT_ASSET_INPUT_STREAM_READ_REQUEST *> m_pending_requests;
+	size_t m_pending_request_index;
+};
+
+static inline import_asset_file_input_stream_io_uring *import_asset_file_input_stream_io_uring_init();
+
+static inline void import_asset_file_input_stream_io_uring_destroy(import_asset_file_input_stream_io_uring *io_uring);
+
+static inline intptr_t import_asset_file_input_stream_io_uring_pump(import_asset_file_input_stream_io_uring *io_uring, int file, bool wait);
+
+static inline void import_asset_file_input_stream_io_uring_fallback(import_asset_file_input_stream_io_uring *io_uring, int file);
+
+// the number of the consecutive "EAGAIN" or "EBUSY" of the "io_uring_enter" before the requests, which are NOT consumed by the kernel, fall back to "pread"
+static constexpr uint32_t const k_io_uring_enter_max_retry_count = 10U;
+#endif
+
 extern import_asset_input_stream_factory *import_asset_init_file_input_stream_factory()
 {
 	void *new_unwrapped_input_stream_factory_base = mcrt_malloc(sizeof(import_asset_input_stream_factory_file), alignof(import_asset_input_stream_factory_file));
@@ -75,6 +141,7 @@ import_asset_input_stream_factory_file::~import_asset_input_stream_factory_file(
 import_asset_input_stream *import_asset_input_stream_factory_file::create_instance(char const *file_name)
 {
 	// NOTE: we can not share the "fd" between different instances, since the results of "lseek" can NOT be shared.
+	// use the "shared file" input stream factory (which is based on the positional reads) to share the "fd"
 
 	int file = openat(AT_FDCWD, file_name, O_RDONLY);
 	if (-1 != file)
@@ -103,7 +170,7 @@ void import_asset_input_stream_factory_file::destory_instance(import_asset_input
 	mcrt_free(delete_unwrapped_input_stream);
 }
 
-import_asset_file_input_stream::import_asset_file_input_stream() : m_file(-1)
+import_asset_file_input_stream::import_asset_file_input_stream() : m_file(-1), m_io_uring(NULL), m_io_uring_unavailable(false)
 {
 }
 
@@ -118,6 +185,21 @@ void import_asset_file_input_stream::uninit()
 {
 	assert(-1 != this->m_file);
 
+#if IMPORT_ASSET_FILE_INPUT_STREAM_IO_URING
+	if (NULL != this->m_io_uring)
+	{
+		// the kernel may still be writing to the requests
+		intptr_t res_pump = import_asset_file_input_stream_io_uring_pump(this->m_io_uring, this->m_file, true);
+		assert(0 == res_pump);
+
+		import_asset_file_input_stream_io_uring_destroy(this->m_io_uring);
+		this->m_io_uring = NULL;
+	}
+#else
+	assert(NULL == this->m_io_uring);
+#endif
+	this->m_io_uring_unavailable = false;
+
 	int res_close = close(this->m_file);
 	assert(0 == res_close);
 
@@ -127,6 +209,7 @@ void import_asset_file_input_stream::uninit()
 import_asset_file_input_stream::~import_asset_file_input_stream()
 {
 	assert(-1 == this->m_file);
+	assert(NULL == this->m_io_uring);
 }
 
 int import_asset_file_input_stream::stat_size(int64_t *size)
@@ -191,10 +274,424 @@ int64_t import_asset_file_input_stream::seek(int64_t offset, int wrapped_whence)
 	return res_lseek;
 }
 
+intptr_t import_asset_file_input_stream::read_at(int64_t offset, void *data, size_t size)
+{
+	assert(-1 != this->m_file);
+
+	IMPORT_ASSET_INPUT_STREAM_READ_REQUEST request;
+	request.offset = offset;
+	request.size = size;
+	request.data = data;
+	request.result = (offset >= 0) ? 0 : -1;
+
+	if (0 == request.result)
+	{
+		import_asset_file_input_stream_pread(this->m_file, &request);
+	}
+
+	return request.result;
+}
+
+bool import_asset_file_input_stream::is_read_at_thread_safe() const
+{
+	return true;
+}
+
+int import_asset_file_input_stream::read_submit(size_t request_count, IMPORT_ASSET_INPUT_STREAM_READ_REQUEST *requests)
+{
+	assert(-1 != this->m_file);
+
+	for (size_t request_index = 0U; request_index < request_count; ++request_index)
+	{
+		requests[request_index].result = (requests[request_index].offset >= 0) ? 0 : -1;
+	}
+
+#if IMPORT_ASSET_FILE_INPUT_STREAM_IO_URING
+	if ((NULL == this->m_io_uring) && (!this->m_io_uring_unavailable))
+	{
+		this->m_io_uring = import_asset_file_input_stream_io_uring_init();
+		this->m_io_uring_unavailable = (NULL == this->m_io_uring);
+	}
+
+	if (NULL != this->m_io_uring)
+	{
+		for (size_t request_index = 0U; request_index < request_count; ++request_index)
+		{
+			if ((0 == requests[request_index].result) && (requests[request_index].size > 0U))
+			{
+				this->m_io_uring->m_pending_requests.push_back(&requests[request_index]);
+			}
+		}
+
+		return ((-1 != import_asset_file_input_stream_io_uring_pump(this->m_io_uring, this->m_file, false)) ? 0 : -1);
+	}
+#endif
+
+	// synchronous fallback: the requests have been completed before "read_submit" returns
+	for (size_t request_index = 0U; request_index < request_count; ++request_index)
+	{
+		if (0 == requests[request_index].result)
+		{
+			import_asset_file_input_stream_pread(this->m_file, &requests[request_index]);
+		}
+	}
+
+	return 0;
+}
+
+intptr_t import_asset_file_input_stream::read_poll()
+{
+	assert(-1 != this->m_file);
+
+#if IMPORT_ASSET_FILE_INPUT_STREAM_IO_URING
+	if (NULL != this->m_io_uring)
+	{
+		return import_asset_file_input_stream_io_uring_pump(this->m_io_uring, this->m_file, false);
+	}
+#endif
+
+	return 0;
+}
+
+int import_asset_file_input_stream::read_wait()
+{
+	assert(-1 != this->m_file);
+
+#if IMPORT_ASSET_FILE_INPUT_STREAM_IO_URING
+	if (NULL != this->m_io_uring)
+	{
+		return ((-1 != import_asset_file_input_stream_io_uring_pump(this->m_io_uring, this->m_file, true)) ? 0 : -1);
+	}
+#endif
+
+	return 0;
+}
+
+static inline void import_asset_file_input_stream_pread(int file, IMPORT_ASSET_INPUT_STREAM_READ_REQUEST *request)
+{
+	assert(request->result >= 0);
+
+	while (static_cast<size_t>(request->result) < request->size)
+	{
+		ssize_t res_pread;
+		while ((-1 == (res_pread = pread(file, reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(request->data) + request->result), request->size - request->result, request->offset + request->result))) && (EINTR == errno))
+		{
+#if defined(__x86_64__) || defined(__i386__)
+			_mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+			__yield();
+#else
+#error Unknown Architecture
+#endif
+		}
+
+		if (-1 == res_pread)
+		{
+			request->result = -1;
+			break;
+		}
+		else if (0 == res_pread)
+		{
+			// EOF
+			break;
+		}
+
+		request->result += res_pread;
+	}
+}
+
+#if IMPORT_ASSET_FILE_INPUT_STREAM_IO_URING
+static inline import_asset_file_input_stream_io_uring *import_asset_file_input_stream_io_uring_init()
+{
+	constexpr uint32_t const ring_entries = 64U;
+
+	struct io_uring_params params;
+	std::memset(&params, 0, sizeof(struct io_uring_params));
+
+	int ring = static_cast<int>(syscall(__NR_io_uring_setup, ring_entries, &params));
+	if (-1 == ring)
+	{
+		return NULL;
+	}
+
+	size_t sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	size_t cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+	bool const single_mmap = (0U != (params.features & IORING_FEAT_SINGLE_MMAP));
+	if (single_mmap)
+	{
+		sq_ring_size = std::max(sq_ring_size, cq_ring_size);
+		cq_ring_size = sq_ring_size;
+	}
+
+	void *sq_ring_base = mmap(NULL, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQ_RING);
+	if (MAP_FAILED == sq_ring_base)
+	{
+		int res_close = close(ring);
+		assert(0 == res_close);
+		return NULL;
+	}
+
+	void *cq_ring_base = single_mmap ? sq_ring_base : mmap(NULL, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_CQ_RING);
+	if (MAP_FAILED == cq_ring_base)
+	{
+		int res_munmap = munmap(sq_ring_base, sq_ring_size);
+		assert(0 == res_munmap);
+		int res_close = close(ring);
+		assert(0 == res_close);
+		return NULL;
+	}
+
+	size_t const sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+	void *sqes = mmap(NULL, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQES);
+	if (MAP_FAILED == sqes)
+	{
+		if (!single_mmap)
+		{
+			int res_munmap = munmap(cq_ring_base, cq_ring_size);
+			assert(0 == res_munmap);
+		}
+		int res_munmap = munmap(sq_ring_base, sq_ring_size);
+		assert(0 == res_munmap);
+		int res_close = close(ring);
+		assert(0 == res_close);
+		return NULL;
+	}
+
+	void *new_io_uring_base = mcrt_malloc(sizeof(import_asset_file_input_stream_io_uring), alignof(import_asset_file_input_stream_io_uring));
+	assert(NULL != new_io_uring_base);
+
+	import_asset_file_input_stream_io_uring *new_io_uring = new (new_io_uring_base) import_asset_file_input_stream_io_uring{};
+	new_io_uring->m_ring = ring;
+	new_io_uring->m_sq_ring_base = sq_ring_base;
+	new_io_uring->m_sq_ring_size = sq_ring_size;
+	new_io_uring->m_cq_ring_base = cq_ring_base;
+	new_io_uring->m_cq_ring_size = cq_ring_size;
+	new_io_uring->m_sqes = static_cast<struct io_uring_sqe *>(sqes);
+	new_io_uring->m_sqes_size = sqes_size;
+	new_io_uring->m_sq_head = reinterpret_cast<uint32_t *>(reinterpret_cast<uintptr_t>(sq_ring_base) + params.sq_off.head);
+	new_io_uring->m_sq_tail = reinterpret_cast<uint32_t *>(reinterpret_cast<uintptr_t>(sq_ring_base) + params.sq_off.tail);
+	new_io_uring->m_sq_mask = (*reinterpret_cast<uint32_t *>(reinterpret_cast<uintptr_t>(sq_ring_base) + params.sq_off.ring_mask));
+	new_io_uring->m_sq_entries = params.sq_entries;
+	new_io_uring->m_sq_array = reinterpret_cast<uint32_t *>(reinterpret_cast<uintptr_t>(sq_ring_base) + params.sq_off.array);
+	new_io_uring->m_cq_head = reinterpret_cast<uint32_t *>(reinterpret_cast<uintptr_t>(cq_ring_base) + params.cq_off.head);
+	new_io_uring->m_cq_tail = reinterpret_cast<uint32_t *>(reinterpret_cast<uintptr_t>(cq_ring_base) + params.cq_off.tail);
+	new_io_uring->m_cq_mask = (*reinterpret_cast<uint32_t *>(reinterpret_cast<uintptr_t>(cq_ring_base) + params.cq_off.ring_mask));
+	new_io_uring->m_cqes = reinterpret_cast<struct io_uring_cqe *>(reinterpret_cast<uintptr_t>(cq_ring_base) + params.cq_off.cqes);
+	new_io_uring->m_unsubmitted_count = 0U;
+	new_io_uring->m_in_flight_count = 0U;
+	new_io_uring->m_pending_request_index = 0U;
+	return new_io_uring;
+}
+
+static inline void import_asset_file_input_stream_io_uring_destroy(import_asset_file_input_stream_io_uring *delete_io_uring)
+{
+	assert(0U == delete_io_uring->m_unsubmitted_count);
+	assert(0U == delete_io_uring->m_in_flight_count);
+
+	int res_munmap_sqes = munmap(delete_io_uring->m_sqes, delete_io_uring->m_sqes_size);
+	assert(0 == res_munmap_sqes);
+
+	if (delete_io_uring->m_cq_ring_base != delete_io_uring->m_sq_ring_base)
+	{
+		int res_munmap_cq_ring = munmap(delete_io_uring->m_cq_ring_base, delete_io_uring->m_cq_ring_size);
+		assert(0 == res_munmap_cq_ring);
+	}
+
+	int res_munmap_sq_ring = munmap(delete_io_uring->m_sq_ring_base, delete_io_uring->m_sq_ring_size);
+	assert(0 == res_munmap_sq_ring);
+
+	int res_close = close(delete_io_uring->m_ring);
+	assert(0 == res_close);
+
+	delete_io_uring->~import_asset_file_input_stream_io_uring();
+	mcrt_free(delete_io_uring);
+}
+
+static inline intptr_t import_asset_file_input_stream_io_uring_pump(import_asset_file_input_stream_io_uring *io_uring, int file, bool wait)
+{
+	uint32_t retry_count = 0U;
+
+	for (;;)
+	{
+		// fill the submission queue
+		{
+			uint32_t sq_tail = (*io_uring->m_sq_tail);
+
+			while ((io_uring->m_pending_request_index < io_uring->m_pending_requests.size()) && ((io_uring->m_unsubmitted_count + io_uring->m_in_flight_count) < io_uring->m_sq_entries))
+			{
+				IMPORT_ASSET_INPUT_STREAM_READ_REQUEST *const request = io_uring->m_pending_requests[io_uring->m_pending_request_index];
+				++io_uring->m_pending_request_index;
+
+				assert((request->result >= 0) && (static_cast<size_t>(request->result) < request->size));
+
+				uint32_t const sqe_index = (sq_tail & io_uring->m_sq_mask);
+
+				struct io_uring_sqe *const sqe = &io_uring->m_sqes[sqe_index];
+				std::memset(sqe, 0, sizeof(struct io_uring_sqe));
+				sqe->opcode = IORING_OP_READ;
+				sqe->fd = file;
+				sqe->off = static_cast<uint64_t>(request->offset + request->result);
+				sqe->addr = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(request->data) + request->result);
+				sqe->len = static_cast<uint32_t>(std::min(request->size - static_cast<size_t>(request->result), static_cast<size_t>(0X40000000U)));
+				sqe->user_data = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(request));
+
+				io_uring->m_sq_array[sqe_index] = sqe_index;
+
+				++sq_tail;
+				++io_uring->m_unsubmitted_count;
+			}
+
+			__atomic_store_n(io_uring->m_sq_tail, sq_tail, __ATOMIC_RELEASE);
+
+			if (io_uring->m_pending_request_index == io_uring->m_pending_requests.size())
+			{
+				io_uring->m_pending_requests.clear();
+				io_uring->m_pending_request_index = 0U;
+			}
+		}
+
+		// submit (and wait)
+		{
+			bool const get_events = (wait && (io_uring->m_in_flight_count + io_uring->m_unsubmitted_count) > 0U);
+
+			if ((io_uring->m_unsubmitted_count > 0U) || get_events)
+			{
+				long res_io_uring_enter = syscall(__NR_io_uring_enter, io_uring->m_ring, io_uring->m_unsubmitted_count, (get_events ? 1U : 0U), (get_events ? IORING_ENTER_GETEVENTS : 0U), NULL, 0);
+				if (res_io_uring_enter >= 0)
+				{
+					assert(static_cast<uint32_t>(res_io_uring_enter) <= io_uring->m_unsubmitted_count);
+					io_uring->m_unsubmitted_count -= static_cast<uint32_t>(res_io_uring_enter);
+					io_uring->m_in_flight_count += static_cast<uint32_t>(res_io_uring_enter);
+
+					retry_count = 0U;
+				}
+				else if ((EAGAIN == errno) || (EBUSY == errno))
+				{
+					// the kernel is temporarily out of resources (EAGAIN) or the completion queue is overflown (EBUSY)
+					if (retry_count < k_io_uring_enter_max_retry_count)
+					{
+						// exponential backoff (the completion queue is reaped below in the meantime)
+						for (uint32_t pause_index = 0U; pause_index < (1U << retry_count); ++pause_index)
+						{
+#if defined(__x86_64__) || defined(__i386__)
+							_mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+							__yield();
+#else
+#error Unknown Architecture
+#endif
+						}
+
+						++retry_count;
+					}
+					else if ((io_uring->m_unsubmitted_count > 0U) || (io_uring->m_pending_request_index < io_uring->m_pending_requests.size()))
+					{
+						import_asset_file_input_stream_io_uring_fallback(io_uring, file);
+
+						// only the requests in flight are waited for from now on
+						retry_count = 0U;
+					}
+					else
+					{
+						return -1;
+					}
+				}
+				else if (EINTR != errno)
+				{
+					return -1;
+				}
+			}
+		}
+
+		// reap the completion queue
+		{
+			uint32_t cq_head = (*io_uring->m_cq_head);
+			uint32_t const cq_tail = __atomic_load_n(io_uring->m_cq_tail, __ATOMIC_ACQUIRE);
+
+			for (; cq_head != cq_tail; ++cq_head)
+			{
+				struct io_uring_cqe const *const cqe = &io_uring->m_cqes[cq_head & io_uring->m_cq_mask];
+
+				IMPORT_ASSET_INPUT_STREAM_READ_REQUEST *const request = reinterpret_cast<IMPORT_ASSET_INPUT_STREAM_READ_REQUEST *>(static_cast<uintptr_t>(cqe->user_data));
+
+				assert(io_uring->m_in_flight_count > 0U);
+				--io_uring->m_in_flight_count;
+
+				if (cqe->res > 0)
+				{
+					request->result += cqe->res;
+
+					if (static_cast<size_t>(request->result) < request->size)
+					{
+						// short read: read the remaining part
+						io_uring->m_pending_requests.push_back(request);
+					}
+				}
+				else if (0 == cqe->res)
+				{
+					// EOF
+				}
+				else if ((-EINTR == cqe->res) || (-EAGAIN == cqe->res))
+				{
+					io_uring->m_pending_requests.push_back(request);
+				}
+				else if ((-EINVAL == cqe->res) || (-EOPNOTSUPP == cqe->res))
+				{
+					// "IORING_OP_READ" is NOT supported before Linux 5.6
+					import_asset_file_input_stream_pread(file, request);
+				}
+				else
+				{
+					request->result = -1;
+				}
+			}
+
+			__atomic_store_n(io_uring->m_cq_head, cq_head, __ATOMIC_RELEASE);
+		}
+
+		size_t const outstanding_count = static_cast<size_t>(io_uring->m_unsubmitted_count) + static_cast<size_t>(io_uring->m_in_flight_count) + (io_uring->m_pending_requests.size() - io_uring->m_pending_request_index);
+		if ((!wait) || (0U == outstanding_count))
+		{
+			return static_cast<intptr_t>(outstanding_count);
+		}
+	}
+}
+
+static inline void import_asset_file_input_stream_io_uring_fallback(import_asset_file_input_stream_io_uring *io_uring, int file)
+{
+	// the kernel only consumes the submission queue entries within the "io_uring_enter" (the "IORING_SETUP_SQPOLL" is NOT used) and thus the unconsumed entries can be withdrawn
+	uint32_t const sq_head = __atomic_load_n(io_uring->m_sq_head, __ATOMIC_ACQUIRE);
+	uint32_t sq_tail = (*io_uring->m_sq_tail);
+	assert((sq_tail - sq_head) == io_uring->m_unsubmitted_count);
+
+	while (sq_tail != sq_head)
+	{
+		--sq_tail;
+
+		struct io_uring_sqe const *const sqe = &io_uring->m_sqes[io_uring->m_sq_array[sq_tail & io_uring->m_sq_mask]];
+
+		import_asset_file_input_stream_pread(file, reinterpret_cast<IMPORT_ASSET_INPUT_STREAM_READ_REQUEST *>(static_cast<uintptr_t>(sqe->user_data)));
+	}
+
+	__atomic_store_n(io_uring->m_sq_tail, sq_tail, __ATOMIC_RELEASE);
+	io_uring->m_unsubmitted_count = 0U;
+
+	for (; io_uring->m_pending_request_index < io_uring->m_pending_requests.size(); ++io_uring->m_pending_request_index)
+	{
+		import_asset_file_input_stream_pread(file, io_uring->m_pending_requests[io_uring->m_pending_request_index]);
+	}
+
+	io_uring->m_pending_requests.clear();
+	io_uring->m_pending_request_index = 0U;
+}
+#endif
+
 #elif defined(_MSC_VER)
 
 #include "../../libiconv/include/iconv.h"
 #include "../../McRT-Malloc/include/mcrt_string.h"
+#include <algorithm>
 
 extern import_asset_input_stream_factory *import_asset_init_file_input_stream_factory()
 {
@@ -236,6 +733,7 @@ import_asset_input_stream_factory_file::~import_asset_input_stream_factory_file(
 import_asset_input_stream *import_asset_input_stream_factory_file::create_instance(char const *file_name)
 {
 	// NOTE: we can not share the "fd" between different instances, since the results of "lseek" can NOT be shared.
+	// use the "shared file" input stream factory (which is based on the positional reads) to share the "fd"
 
 	mcrt_wstring file_name_utf16;
 	{
@@ -295,7 +793,7 @@ void import_asset_input_stream_factory_file::destory_instance(import_asset_input
 	mcrt_free(delete_unwrapped_input_stream);
 }
 
-import_asset_file_input_stream::import_asset_file_input_stream() : m_file(INVALID_HANDLE_VALUE)
+import_asset_file_input_stream::import_asset_file_input_stream() : m_file(INVALID_HANDLE_VALUE), m_offset(0)
 {
 }
 
@@ -304,6 +802,8 @@ void import_asset_file_input_stream::init(HANDLE file)
 	assert(INVALID_HANDLE_VALUE == this->m_file);
 
 	this->m_file = file;
+
+	assert(0 == this->m_offset);
 }
 
 void import_asset_file_input_stream::uninit()
@@ -314,11 +814,14 @@ void import_asset_file_input_stream::uninit()
 	assert(FALSE != res_close_handle);
 
 	this->m_file = INVALID_HANDLE_VALUE;
+
+	this->m_offset = 0;
 }
 
 import_asset_file_input_stream::~import_asset_file_input_stream()
 {
 	assert(INVALID_HANDLE_VALUE == this->m_file);
+	assert(0 == this->m_offset);
 }
 
 int import_asset_file_input_stream::stat_size(int64_t *size)
@@ -337,45 +840,102 @@ intptr_t import_asset_file_input_stream::read(void *data, size_t size)
 {
 	assert(INVALID_HANDLE_VALUE != this->m_file);
 
-	DWORD read_size;
-	BOOL res_read_file = ReadFile(this->m_file, data, static_cast<DWORD>(size), &read_size, NULL);
+	intptr_t read_size = this->read_at(this->m_offset, data, size);
+	if (read_size > 0)
+	{
+		this->m_offset += read_size;
+	}
 
-	return (FALSE != res_read_file) ? (static_cast<intptr_t>(read_size)) : (-1);
+	return read_size;
 }
 
 int64_t import_asset_file_input_stream::seek(int64_t offset, int whence)
 {
 	assert(INVALID_HANDLE_VALUE != this->m_file);
 
-	DWORD move_method;
+	int64_t new_offset;
 	switch (whence)
 	{
 	case IMPORT_ASSET_INPUT_STREAM_SEEK_SET:
 	{
-		move_method = FILE_BEGIN;
+		new_offset = offset;
 	}
 	break;
 	case IMPORT_ASSET_INPUT_STREAM_SEEK_CUR:
 	{
-		move_method = FILE_CURRENT;
+		new_offset = this->m_offset + offset;
 	}
 	break;
 	case IMPORT_ASSET_INPUT_STREAM_SEEK_END:
 	{
-		move_method = FILE_END;
+		LARGE_INTEGER length;
+		if (FALSE == GetFileSizeEx(this->m_file, &length))
+		{
+			return -1;
+		}
+
+		new_offset = static_cast<int64_t>(length.QuadPart) + offset;
 	}
 	break;
 	default:
 		assert(false);
-		move_method = -1;
+		new_offset = -1;
+	}
+
+	// the same as "SetFilePointerEx": seeking beyond the end is allowed while seeking before the beginning is NOT
+	if (new_offset < 0)
+	{
+		return -1;
+	}
+
+	this->m_offset = new_offset;
+	return this->m_offset;
+}
+
+intptr_t import_asset_file_input_stream::read_at(int64_t offset, void *data, size_t size)
+{
+	assert(INVALID_HANDLE_VALUE != this->m_file);
+
+	if (offset < 0)
+	{
+		return -1;
 	}
 
-	LARGE_INTEGER distance_to_move;
-	distance_to_move.QuadPart = static_cast<LONGLONG>(offset);
+	// NOTE: the "ReadFile" with the "OVERLAPPED" offset is positional and the file pointer of the synchronous handle is NOT used
+	size_t read_size = 0U;
+	while (read_size < size)
+	{
+		uint64_t const read_offset = static_cast<uint64_t>(offset) + read_size;
+
+		OVERLAPPED overlapped = {};
+		overlapped.Offset = static_cast<DWORD>(read_offset & 0XFFFFFFFFU);
+		overlapped.OffsetHigh = static_cast<DWORD>(read_offset >> 32U);
 
-	LARGE_INTEGER new_file_pointer;
-	BOOL res_set_file_pointer_ex = SetFilePointerEx(this->m_file, distance_to_move, &new_file_pointer, move_method);
-	return (FALSE != res_set_file_pointer_ex) ? (static_cast<int64_t>(new_file_pointer.QuadPart)) : (-1);
+		DWORD chunk_read_size;
+		BOOL res_read_file = ReadFile(this->m_file, reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(data) + read_size), static_cast<DWORD>(std::min(size - read_size, static_cast<size_t>(0X40000000U))), &chunk_read_size, &overlapped);
+		if (FALSE == res_read_file)
+		{
+			if (ERROR_HANDLE_EOF != GetLastError())
+			{
+				return -1;
+			}
+			break;
+		}
+		else if (0U == chunk_read_size)
+		{
+			// EOF
+			break;
+		}
+
+		read_size += chunk_read_size;
+	}
+
+	return static_cast<intptr_t>(read_size);
+}
+
+bool import_asset_file_input_stream::is_read_at_thread_safe() const
+{
+	return true;
 }
 
 #else
@@ -35,10 +35,16 @@ private:
 	virtual void destory_instance(import_asset_input_stream *input_stream) override;
 };
 
+struct import_asset_file_input_stream_io_uring;
+
 class import_asset_file_input_stream final : public import_asset_input_stream
 {
 	int m_file;
 
+	// NULL if the "io_uring" has NOT been set up yet or is NOT available (e.g. blocked by the "seccomp" on Android)
+	import_asset_file_input_stream_io_uring *m_io_uring;
+	bool m_io_uring_unavailable;
+
 public:
 	import_asset_file_input_stream();
 	void init(int file);
@@ -49,6 +55,11 @@ private:
 	int stat_size(int64_t *size) override;
 	intptr_t read(void *data, size_t size) override;
 	int64_t seek(int64_t offset, int whence) override;
+	intptr_t read_at(int64_t offset, void *data, size_t size) override;
+	bool is_read_at_thread_safe() const override;
+	int read_submit(size_t request_count, IMPORT_ASSET_INPUT_STREAM_READ_REQUEST *requests) override;
+	intptr_t read_poll() override;
+	int read_wait() override;
 };
 
 #elif defined(_MSC_VER)
@@ -74,6 +85,8 @@ private:
 class import_asset_file_input_stream final : public import_asset_input_stream
 {
 	HANDLE m_file;
+	// NOTE: all reads are positional and the file pointer of the handle is NOT used
+	int64_t m_offset;
 
 public:
 	import_asset_file_input_stream();
@@ -83,6 +96,8 @@ public:
 	int stat_size(int64_t *size) override;
 	intptr_t read(void *data, size_t size) override;
 	int64_t seek(int64_t offset, int whence) override;
+	intptr_t read_at(int64_t offset, void *data, size_t size) override;
+	bool is_read_at_thread_safe() const override;
 };
 
 #else
@@ -174,3 +174,37 @@ int64_t import_asset_memory_input_stream::seek(int64_t offset, int whence)
 
 	return this->m_memory_range_offset;
 }
+
+intptr_t import_asset_memory_input_stream::read_at(int64_t offset, void *data, size_t size)
+{
+	if (offset < 0)
+	{
+		return -1;
+	}
+
+	intptr_t size_read = ((offset + static_cast<int64_t>(size)) <= this->m_memory_range_size) ? static_cast<int64_t>(size) : ((offset < this->m_memory_range_size) ? (this->m_memory_range_size - offset) : 0);
+	if (size_read > 0)
+	{
+		std::memcpy(data, reinterpret_cast<void const *>(reinterpret_cast<intptr_t>(this->m_memory_range_base) + offset), size_read);
+	}
+	return size_read;
+}
+
+bool import_asset_memory_input_stream::is_read_at_thread_safe() const
+{
+	return true;
+}
+
+int import_asset_memory_input_stream::map_range(int64_t offset, size_t size, void const **data)
+{
+	if ((offset >= 0) && (offset <= this->m_memory_range_size) && (static_cast<int64_t>(size) <= (this->m_memory_range_size - offset)))
+	{
+		(*data) = reinterpret_cast<void const *>(reinterpret_cast<intptr_t>(this->m_memory_range_base) + offset);
+		return 0;
+	}
+	else
+	{
+		return -1;
+	}
+}
+
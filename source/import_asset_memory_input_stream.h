@@ -57,6 +57,9 @@ public:
 	int stat_size(int64_t *size) override;
 	intptr_t read(void *data, size_t size) override;
 	int64_t seek(int64_t offset, int whence) override;
+	intptr_t read_at(int64_t offset, void *data, size_t size) override;
+	bool is_read_at_thread_safe() const override;
+	int map_range(int64_t offset, size_t size, void const **data) override;
 };
 
 #endif
\ No newline at end of file
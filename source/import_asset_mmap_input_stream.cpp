@@ -0,0 +1,361 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "import_asset_mmap_input_stream.h"
+#include "../../McRT-Malloc/include/mcrt_malloc.h"
+#include <new>
+#include <cstring>
+#include <assert.h>
+
+#if defined(__GNUC__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#elif defined(_MSC_VER)
+
+#define NOMINMAX 1
+#define WIN32_LEAN_AND_MEAN 1
+#include <sdkddkver.h>
+#include <Windows.h>
+#include "../../libiconv/include/iconv.h"
+#include "../../McRT-Malloc/include/mcrt_string.h"
+
+#else
+#error Unknown Compiler
+#endif
+
+extern import_asset_input_stream_factory *import_asset_init_mmap_input_stream_factory()
+{
+	void *new_unwrapped_input_stream_factory_base = mcrt_malloc(sizeof(import_asset_mmap_input_stream_factory), alignof(import_asset_mmap_input_stream_factory));
+	assert(NULL != new_unwrapped_input_stream_factory_base);
+
+	import_asset_mmap_input_stream_factory *new_unwrapped_input_stream_factory = new (new_unwrapped_input_stream_factory_base) import_asset_mmap_input_stream_factory{};
+	new_unwrapped_input_stream_factory->init();
+	return new_unwrapped_input_stream_factory;
+}
+
+extern void import_asset_destroy_mmap_input_stream_factory(import_asset_input_stream_factory *wrapped_input_stream_factory)
+{
+	assert(NULL != wrapped_input_stream_factory);
+	import_asset_mmap_input_stream_factory *delete_unwrapped_input_stream_factory = static_cast<import_asset_mmap_input_stream_factory *>(wrapped_input_stream_factory);
+
+	delete_unwrapped_input_stream_factory->uninit();
+
+	delete_unwrapped_input_stream_factory->~import_asset_mmap_input_stream_factory();
+	mcrt_free(delete_unwrapped_input_stream_factory);
+}
+
+import_asset_mmap_input_stream_factory::import_asset_mmap_input_stream_factory()
+{
+}
+
+void import_asset_mmap_input_stream_factory::init()
+{
+}
+
+void import_asset_mmap_input_stream_factory::uninit()
+{
+}
+
+import_asset_mmap_input_stream_factory::~import_asset_mmap_input_stream_factory()
+{
+}
+
+#if defined(__GNUC__)
+
+import_asset_input_stream *import_asset_mmap_input_stream_factory::create_instance(char const *file_name)
+{
+	int file = openat(AT_FDCWD, file_name, O_RDONLY);
+	if (-1 == file)
+	{
+		return NULL;
+	}
+
+	struct stat buf;
+	if ((-1 == fstat(file, &buf)) || (static_cast<uint64_t>(buf.st_size) > static_cast<uint64_t>(SIZE_MAX)))
+	{
+		int res_close = close(file);
+		assert(0 == res_close);
+		return NULL;
+	}
+
+	void *mapping_base = NULL;
+	if (buf.st_size > 0)
+	{
+		mapping_base = mmap(NULL, static_cast<size_t>(buf.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		if (MAP_FAILED == mapping_base)
+		{
+			int res_close = close(file);
+			assert(0 == res_close);
+			return NULL;
+		}
+	}
+
+	// NOTE: the mapping remains valid after the "fd" is closed
+	int res_close = close(file);
+	assert(0 == res_close);
+
+	void *new_unwrapped_input_stream_base = mcrt_malloc(sizeof(import_asset_mmap_input_stream), alignof(import_asset_mmap_input_stream));
+	assert(NULL != new_unwrapped_input_stream_base);
+
+	import_asset_mmap_input_stream *new_unwrapped_input_stream = new (new_unwrapped_input_stream_base) import_asset_mmap_input_stream{};
+	new_unwrapped_input_stream->init(mapping_base, static_cast<int64_t>(buf.st_size));
+	return new_unwrapped_input_stream;
+}
+
+void import_asset_mmap_input_stream::uninit()
+{
+	if (NULL != this->m_mapping_base)
+	{
+		assert(this->m_mapping_size > 0);
+
+		int res_munmap = munmap(const_cast<void *>(this->m_mapping_base), static_cast<size_t>(this->m_mapping_size));
+		assert(0 == res_munmap);
+	}
+	else
+	{
+		assert(0 == this->m_mapping_size);
+	}
+
+	this->m_mapping_base = NULL;
+	this->m_mapping_size = 0;
+	this->m_mapping_offset = 0;
+}
+
+#elif defined(_MSC_VER)
+
+import_asset_input_stream *import_asset_mmap_input_stream_factory::create_instance(char const *file_name)
+{
+	mcrt_wstring file_name_utf16;
+	{
+		assert(file_name_utf16.empty());
+
+		mcrt_string src_utf8 = file_name;
+		mcrt_wstring &dst_utf16 = file_name_utf16;
+
+		assert(dst_utf16.empty());
+
+		if (!src_utf8.empty())
+		{
+			dst_utf16.resize(src_utf8.size() + 1U);
+
+			size_t in_bytes_left = sizeof(src_utf8[0]) * src_utf8.size();
+			size_t out_bytes_left = sizeof(dst_utf16[0]) * dst_utf16.size();
+			char *in_buf = src_utf8.data();
+			char *out_buf = reinterpret_cast<char *>(dst_utf16.data());
+
+			iconv_t conversion_descriptor = iconv_open("UTF-16LE", "UTF-8");
+			assert(((iconv_t)(-1)) != conversion_descriptor);
+
+			size_t conversion_result = iconv(conversion_descriptor, &in_buf, &in_bytes_left, &out_buf, &out_bytes_left);
+			assert(((size_t)(-1)) != conversion_result);
+
+			int result = iconv_close(conversion_descriptor);
+			assert(-1 != result);
+
+			dst_utf16.resize(reinterpret_cast<decltype(&dst_utf16[0])>(out_buf) - dst_utf16.data());
+		}
+	}
+
+	HANDLE file = CreateFileW(file_name_utf16.c_str(), FILE_READ_DATA, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (INVALID_HANDLE_VALUE == file)
+	{
+		return NULL;
+	}
+
+	LARGE_INTEGER length;
+	if ((FALSE == GetFileSizeEx(file, &length)) || (static_cast<uint64_t>(length.QuadPart) > static_cast<uint64_t>(SIZE_MAX)))
+	{
+		BOOL res_close_handle = CloseHandle(file);
+		assert(FALSE != res_close_handle);
+		return NULL;
+	}
+
+	void *mapping_base = NULL;
+	if (length.QuadPart > 0)
+	{
+		HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0U, 0U, NULL);
+		if (NULL == mapping)
+		{
+			BOOL res_close_handle = CloseHandle(file);
+			assert(FALSE != res_close_handle);
+			return NULL;
+		}
+
+		mapping_base = MapViewOfFile(mapping, FILE_MAP_READ, 0U, 0U, static_cast<SIZE_T>(length.QuadPart));
+
+		// NOTE: the view remains valid after the handles are closed
+		BOOL res_close_mapping_handle = CloseHandle(mapping);
+		assert(FALSE != res_close_mapping_handle);
+
+		if (NULL == mapping_base)
+		{
+			BOOL res_close_handle = CloseHandle(file);
+			assert(FALSE != res_close_handle);
+			return NULL;
+		}
+	}
+
+	BOOL res_close_handle = CloseHandle(file);
+	assert(FALSE != res_close_handle);
+
+	void *new_unwrapped_input_stream_base = mcrt_malloc(sizeof(import_asset_mmap_input_stream), alignof(import_asset_mmap_input_stream));
+	assert(NULL != new_unwrapped_input_stream_base);
+
+	import_asset_mmap_input_stream *new_unwrapped_input_stream = new (new_unwrapped_input_stream_base) import_asset_mmap_input_stream{};
+	new_unwrapped_input_stream->init(mapping_base, static_cast<int64_t>(length.QuadPart));
+	return new_unwrapped_input_stream;
+}
+
+void import_asset_mmap_input_stream::uninit()
+{
+	if (NULL != this->m_mapping_base)
+	{
+		assert(this->m_mapping_size > 0);
+
+		BOOL res_unmap_view_of_file = UnmapViewOfFile(this->m_mapping_base);
+		assert(FALSE != res_unmap_view_of_file);
+	}
+	else
+	{
+		assert(0 == this->m_mapping_size);
+	}
+
+	this->m_mapping_base = NULL;
+	this->m_mapping_size = 0;
+	this->m_mapping_offset = 0;
+}
+
+#else
+#error Unknown Compiler
+#endif
+
+void import_asset_mmap_input_stream_factory::destory_instance(import_asset_input_stream *wrapped_input_stream)
+{
+	assert(NULL != wrapped_input_stream);
+	import_asset_mmap_input_stream *delete_unwrapped_input_stream = static_cast<import_asset_mmap_input_stream *>(wrapped_input_stream);
+
+	delete_unwrapped_input_stream->uninit();
+
+	delete_unwrapped_input_stream->~import_asset_mmap_input_stream();
+	mcrt_free(delete_unwrapped_input_stream);
+}
+
+import_asset_mmap_input_stream::import_asset_mmap_input_stream() : m_mapping_base(NULL), m_mapping_size(0), m_mapping_offset(0)
+{
+}
+
+void import_asset_mmap_input_stream::init(void const *mapping_base, int64_t mapping_size)
+{
+	assert(NULL == this->m_mapping_base);
+	this->m_mapping_base = mapping_base;
+
+	assert(0 == this->m_mapping_size);
+	this->m_mapping_size = mapping_size;
+
+	assert(0 == this->m_mapping_offset);
+}
+
+import_asset_mmap_input_stream::~import_asset_mmap_input_stream()
+{
+	assert(NULL == this->m_mapping_base);
+	assert(0 == this->m_mapping_size);
+	assert(0 == this->m_mapping_offset);
+}
+
+int import_asset_mmap_input_stream::stat_size(int64_t *size)
+{
+	(*size) = this->m_mapping_size;
+	return 0;
+}
+
+intptr_t import_asset_mmap_input_stream::read(void *data, size_t size)
+{
+	intptr_t size_read = ((this->m_mapping_offset + static_cast<int64_t>(size)) <= this->m_mapping_size) ? static_cast<int64_t>(size) : ((this->m_mapping_offset < this->m_mapping_size) ? (this->m_mapping_size - this->m_mapping_offset) : 0);
+	if (size_read > 0)
+	{
+		std::memcpy(data, reinterpret_cast<void const *>(reinterpret_cast<intptr_t>(this->m_mapping_base) + this->m_mapping_offset), size_read);
+		this->m_mapping_offset += size_read;
+	}
+	return size_read;
+}
+
+int64_t import_asset_mmap_input_stream::seek(int64_t offset, int whence)
+{
+	int64_t new_mapping_offset;
+	switch (whence)
+	{
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_SET:
+		new_mapping_offset = offset;
+		break;
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_CUR:
+		new_mapping_offset = this->m_mapping_offset + offset;
+		break;
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_END:
+		new_mapping_offset = this->m_mapping_size + offset;
+		break;
+	default:
+		assert(false);
+		new_mapping_offset = -1;
+	}
+
+	// the same as "lseek": seeking beyond the end is allowed while seeking before the beginning is NOT
+	if (new_mapping_offset < 0)
+	{
+		return -1;
+	}
+
+	this->m_mapping_offset = new_mapping_offset;
+	return this->m_mapping_offset;
+}
+
+intptr_t import_asset_mmap_input_stream::read_at(int64_t offset, void *data, size_t size)
+{
+	if (offset < 0)
+	{
+		return -1;
+	}
+
+	intptr_t size_read = ((offset + static_cast<int64_t>(size)) <= this->m_mapping_size) ? static_cast<int64_t>(size) : ((offset < this->m_mapping_size) ? (this->m_mapping_size - offset) : 0);
+	if (size_read > 0)
+	{
+		std::memcpy(data, reinterpret_cast<void const *>(reinterpret_cast<intptr_t>(this->m_mapping_base) + offset), size_read);
+	}
+	return size_read;
+}
+
+bool import_asset_mmap_input_stream::is_read_at_thread_safe() const
+{
+	return true;
+}
+
+int import_asset_mmap_input_stream::map_range(int64_t offset, size_t size, void const **data)
+{
+	if ((offset >= 0) && (offset <= this->m_mapping_size) && (static_cast<int64_t>(size) <= (this->m_mapping_size - offset)))
+	{
+		(*data) = reinterpret_cast<void const *>(reinterpret_cast<intptr_t>(this->m_mapping_base) + offset);
+		return 0;
+	}
+	else
+	{
+		return -1;
+	}
+}
+
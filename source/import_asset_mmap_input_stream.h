@@ -0,0 +1,56 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _IMPORT_ASSET_MMAP_INPUT_STREAM_H_
+#define _IMPORT_ASSET_MMAP_INPUT_STREAM_H_ 1
+
+#include "../include/import_asset_input_stream.h"
+
+class import_asset_mmap_input_stream_factory final : public import_asset_input_stream_factory
+{
+public:
+	import_asset_mmap_input_stream_factory();
+	void init();
+	void uninit();
+	~import_asset_mmap_input_stream_factory();
+
+private:
+	virtual import_asset_input_stream *create_instance(char const *file_name) override;
+	virtual void destory_instance(import_asset_input_stream *input_stream) override;
+};
+
+class import_asset_mmap_input_stream final : public import_asset_input_stream
+{
+	// NOTE: the mapping of the empty file is NULL
+	void const *m_mapping_base;
+	int64_t m_mapping_size;
+	int64_t m_mapping_offset;
+
+public:
+	import_asset_mmap_input_stream();
+	void init(void const *mapping_base, int64_t mapping_size);
+	void uninit();
+	~import_asset_mmap_input_stream();
+	int stat_size(int64_t *size) override;
+	intptr_t read(void *data, size_t size) override;
+	int64_t seek(int64_t offset, int whence) override;
+	intptr_t read_at(int64_t offset, void *data, size_t size) override;
+	bool is_read_at_thread_safe() const override;
+	int map_range(int64_t offset, size_t size, void const **data) override;
+};
+
+#endif
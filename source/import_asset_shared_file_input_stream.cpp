@@ -0,0 +1,525 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "import_asset_shared_file_input_stream.h"
+#include "../../McRT-Malloc/include/mcrt_malloc.h"
+#include <new>
+#include <algorithm>
+#include <assert.h>
+
+extern import_asset_input_stream_factory *import_asset_init_shared_file_input_stream_factory()
+{
+	void *new_unwrapped_input_stream_factory_base = mcrt_malloc(sizeof(import_asset_shared_file_input_stream_factory), alignof(import_asset_shared_file_input_stream_factory));
+	assert(NULL != new_unwrapped_input_stream_factory_base);
+
+	import_asset_shared_file_input_stream_factory *new_unwrapped_input_stream_factory = new (new_unwrapped_input_stream_factory_base) import_asset_shared_file_input_stream_factory{};
+	new_unwrapped_input_stream_factory->init();
+	return new_unwrapped_input_stream_factory;
+}
+
+extern void import_asset_destroy_shared_file_input_stream_factory(import_asset_input_stream_factory *wrapped_input_stream_factory)
+{
+	assert(NULL != wrapped_input_stream_factory);
+	import_asset_shared_file_input_stream_factory *delete_unwrapped_input_stream_factory = static_cast<import_asset_shared_file_input_stream_factory *>(wrapped_input_stream_factory);
+
+	delete_unwrapped_input_stream_factory->uninit();
+
+	delete_unwrapped_input_stream_factory->~import_asset_shared_file_input_stream_factory();
+	mcrt_free(delete_unwrapped_input_stream_factory);
+}
+
+import_asset_shared_file_input_stream_factory::import_asset_shared_file_input_stream_factory()
+{
+}
+
+void import_asset_shared_file_input_stream_factory::init()
+{
+	assert(this->m_shared_files.empty());
+}
+
+void import_asset_shared_file_input_stream_factory::uninit()
+{
+	// all input streams should have been destroyed and all shared files have been closed by the last input stream
+	assert(this->m_shared_files.empty());
+}
+
+import_asset_shared_file_input_stream_factory::~import_asset_shared_file_input_stream_factory()
+{
+	assert(this->m_shared_files.empty());
+}
+
+void import_asset_shared_file_input_stream_factory::destory_instance(import_asset_input_stream *wrapped_input_stream)
+{
+	assert(NULL != wrapped_input_stream);
+	import_asset_shared_file_input_stream *delete_unwrapped_input_stream = static_cast<import_asset_shared_file_input_stream *>(wrapped_input_stream);
+
+	mcrt_string const *file_name = delete_unwrapped_input_stream->uninit();
+
+	delete_unwrapped_input_stream->~import_asset_shared_file_input_stream();
+	mcrt_free(delete_unwrapped_input_stream);
+
+	this->release_shared_file(file_name);
+}
+
+#if defined(__GNUC__)
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <errno.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(__arm__)
+#include <arm_acle.h>
+#else
+#error Unknown Architecture
+#endif
+
+void import_asset_shared_file_input_stream_factory::release_shared_file(mcrt_string const *file_name)
+{
+	std::lock_guard<std::mutex> lock_guard(this->m_shared_files_mutex);
+
+	auto found = this->m_shared_files.find(*file_name);
+	assert(this->m_shared_files.end() != found);
+
+	assert(found->second.m_reference_count > 0U);
+	--found->second.m_reference_count;
+
+	if (0U == found->second.m_reference_count)
+	{
+		int res_close = close(found->second.m_file);
+		assert(0 == res_close);
+
+		this->m_shared_files.erase(found);
+	}
+}
+
+import_asset_input_stream *import_asset_shared_file_input_stream_factory::create_instance(char const *file_name)
+{
+	int file;
+	mcrt_string const *shared_file_name;
+	{
+		mcrt_string new_shared_file_name = file_name;
+
+		std::lock_guard<std::mutex> lock_guard(this->m_shared_files_mutex);
+
+		auto found = this->m_shared_files.find(new_shared_file_name);
+		if (this->m_shared_files.end() == found)
+		{
+			int new_file = openat(AT_FDCWD, file_name, O_RDONLY);
+			if (-1 == new_file)
+			{
+				return NULL;
+			}
+
+			found = this->m_shared_files.emplace(std::move(new_shared_file_name), import_asset_shared_file{new_file, 0U}).first;
+		}
+
+		++found->second.m_reference_count;
+
+		// NOTE: the references to the elements of the unordered map remain valid until the elements are erased
+		file = found->second.m_file;
+		shared_file_name = &found->first;
+	}
+
+	void *new_unwrapped_input_stream_base = mcrt_malloc(sizeof(import_asset_shared_file_input_stream), alignof(import_asset_shared_file_input_stream));
+	assert(NULL != new_unwrapped_input_stream_base);
+
+	import_asset_shared_file_input_stream *new_unwrapped_input_stream = new (new_unwrapped_input_stream_base) import_asset_shared_file_input_stream{};
+	new_unwrapped_input_stream->init(file, shared_file_name);
+	return new_unwrapped_input_stream;
+}
+
+import_asset_shared_file_input_stream::import_asset_shared_file_input_stream() : m_file(-1), m_offset(0), m_file_name(NULL)
+{
+}
+
+void import_asset_shared_file_input_stream::init(int file, mcrt_string const *file_name)
+{
+	assert(-1 == this->m_file);
+	this->m_file = file;
+
+	assert(0 == this->m_offset);
+
+	assert(NULL == this->m_file_name);
+	this->m_file_name = file_name;
+}
+
+mcrt_string const *import_asset_shared_file_input_stream::uninit()
+{
+	assert(-1 != this->m_file);
+	this->m_file = -1;
+
+	this->m_offset = 0;
+
+	assert(NULL != this->m_file_name);
+	mcrt_string const *file_name = this->m_file_name;
+	this->m_file_name = NULL;
+
+	return file_name;
+}
+
+import_asset_shared_file_input_stream::~import_asset_shared_file_input_stream()
+{
+	assert(-1 == this->m_file);
+	assert(0 == this->m_offset);
+	assert(NULL == this->m_file_name);
+}
+
+int import_asset_shared_file_input_stream::stat_size(int64_t *size)
+{
+	assert(-1 != this->m_file);
+
+	struct stat buf;
+	int res_fstat = fstat(this->m_file, &buf);
+
+	(*size) = static_cast<int64_t>(buf.st_size);
+
+	return res_fstat;
+}
+
+intptr_t import_asset_shared_file_input_stream::read_at(int64_t offset, void *data, size_t size)
+{
+	assert(-1 != this->m_file);
+
+	if (offset < 0)
+	{
+		return -1;
+	}
+
+	size_t read_size = 0U;
+	while (read_size < size)
+	{
+		ssize_t res_pread;
+		while ((-1 == (res_pread = pread(this->m_file, reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(data) + read_size), size - read_size, offset + static_cast<int64_t>(read_size)))) && (EINTR == errno))
+		{
+#if defined(__x86_64__) || defined(__i386__)
+			_mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+			__yield();
+#else
+#error Unknown Architecture
+#endif
+		}
+
+		if (-1 == res_pread)
+		{
+			return -1;
+		}
+		else if (0 == res_pread)
+		{
+			// EOF
+			break;
+		}
+
+		read_size += res_pread;
+	}
+
+	return static_cast<intptr_t>(read_size);
+}
+
+bool import_asset_shared_file_input_stream::is_read_at_thread_safe() const
+{
+	return true;
+}
+
+int64_t import_asset_shared_file_input_stream::seek(int64_t offset, int whence)
+{
+	assert(-1 != this->m_file);
+
+	int64_t new_offset;
+	switch (whence)
+	{
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_SET:
+	{
+		new_offset = offset;
+	}
+	break;
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_CUR:
+	{
+		new_offset = this->m_offset + offset;
+	}
+	break;
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_END:
+	{
+		struct stat buf;
+		if (-1 == fstat(this->m_file, &buf))
+		{
+			return -1;
+		}
+
+		new_offset = static_cast<int64_t>(buf.st_size) + offset;
+	}
+	break;
+	default:
+		assert(false);
+		new_offset = -1;
+	}
+
+	// the same as "lseek": seeking beyond the end is allowed while seeking before the beginning is NOT
+	if (new_offset < 0)
+	{
+		return -1;
+	}
+
+	this->m_offset = new_offset;
+	return this->m_offset;
+}
+
+#elif defined(_MSC_VER)
+
+#include "../../libiconv/include/iconv.h"
+
+void import_asset_shared_file_input_stream_factory::release_shared_file(mcrt_string const *file_name)
+{
+	std::lock_guard<std::mutex> lock_guard(this->m_shared_files_mutex);
+
+	auto found = this->m_shared_files.find(*file_name);
+	assert(this->m_shared_files.end() != found);
+
+	assert(found->second.m_reference_count > 0U);
+	--found->second.m_reference_count;
+
+	if (0U == found->second.m_reference_count)
+	{
+		BOOL res_close_handle = CloseHandle(found->second.m_file);
+		assert(FALSE != res_close_handle);
+
+		this->m_shared_files.erase(found);
+	}
+}
+
+import_asset_input_stream *import_asset_shared_file_input_stream_factory::create_instance(char const *file_name)
+{
+	HANDLE file;
+	mcrt_string const *shared_file_name;
+	{
+		mcrt_string new_shared_file_name = file_name;
+
+		std::lock_guard<std::mutex> lock_guard(this->m_shared_files_mutex);
+
+		auto found = this->m_shared_files.find(new_shared_file_name);
+		if (this->m_shared_files.end() == found)
+		{
+			mcrt_wstring file_name_utf16;
+			{
+				assert(file_name_utf16.empty());
+
+				mcrt_string src_utf8 = file_name;
+				mcrt_wstring &dst_utf16 = file_name_utf16;
+
+				assert(dst_utf16.empty());
+
+				if (!src_utf8.empty())
+				{
+					dst_utf16.resize(src_utf8.size() + 1U);
+
+					size_t in_bytes_left = sizeof(src_utf8[0]) * src_utf8.size();
+					size_t out_bytes_left = sizeof(dst_utf16[0]) * dst_utf16.size();
+					char *in_buf = src_utf8.data();
+					char *out_buf = reinterpret_cast<char *>(dst_utf16.data());
+
+					iconv_t conversion_descriptor = iconv_open("UTF-16LE", "UTF-8");
+					assert(((iconv_t)(-1)) != conversion_descriptor);
+
+					size_t conversion_result = iconv(conversion_descriptor, &in_buf, &in_bytes_left, &out_buf, &out_bytes_left);
+					assert(((size_t)(-1)) != conversion_result);
+
+					int result = iconv_close(conversion_descriptor);
+					assert(-1 != result);
+
+					dst_utf16.resize(reinterpret_cast<decltype(&dst_utf16[0])>(out_buf) - dst_utf16.data());
+				}
+			}
+
+			HANDLE new_file = CreateFileW(file_name_utf16.c_str(), FILE_READ_DATA, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+			if (INVALID_HANDLE_VALUE == new_file)
+			{
+				return NULL;
+			}
+
+			found = this->m_shared_files.emplace(std::move(new_shared_file_name), import_asset_shared_file{new_file, 0U}).first;
+		}
+
+		++found->second.m_reference_count;
+
+		// NOTE: the references to the elements of the unordered map remain valid until the elements are erased
+		file = found->second.m_file;
+		shared_file_name = &found->first;
+	}
+
+	void *new_unwrapped_input_stream_base = mcrt_malloc(sizeof(import_asset_shared_file_input_stream), alignof(import_asset_shared_file_input_stream));
+	assert(NULL != new_unwrapped_input_stream_base);
+
+	import_asset_shared_file_input_stream *new_unwrapped_input_stream = new (new_unwrapped_input_stream_base) import_asset_shared_file_input_stream{};
+	new_unwrapped_input_stream->init(file, shared_file_name);
+	return new_unwrapped_input_stream;
+}
+
+import_asset_shared_file_input_stream::import_asset_shared_file_input_stream() : m_file(INVALID_HANDLE_VALUE), m_offset(0), m_file_name(NULL)
+{
+}
+
+void import_asset_shared_file_input_stream::init(HANDLE file, mcrt_string const *file_name)
+{
+	assert(INVALID_HANDLE_VALUE == this->m_file);
+	this->m_file = file;
+
+	assert(0 == this->m_offset);
+
+	assert(NULL == this->m_file_name);
+	this->m_file_name = file_name;
+}
+
+mcrt_string const *import_asset_shared_file_input_stream::uninit()
+{
+	assert(INVALID_HANDLE_VALUE != this->m_file);
+	this->m_file = INVALID_HANDLE_VALUE;
+
+	this->m_offset = 0;
+
+	assert(NULL != this->m_file_name);
+	mcrt_string const *file_name = this->m_file_name;
+	this->m_file_name = NULL;
+
+	return file_name;
+}
+
+import_asset_shared_file_input_stream::~import_asset_shared_file_input_stream()
+{
+	assert(INVALID_HANDLE_VALUE == this->m_file);
+	assert(0 == this->m_offset);
+	assert(NULL == this->m_file_name);
+}
+
+int import_asset_shared_file_input_stream::stat_size(int64_t *size)
+{
+	assert(INVALID_HANDLE_VALUE != this->m_file);
+
+	LARGE_INTEGER length;
+	BOOL res_get_file_size_ex = GetFileSizeEx(this->m_file, &length);
+
+	(*size) = static_cast<int64_t>(length.QuadPart);
+
+	return ((FALSE != res_get_file_size_ex) ? (0) : (-1));
+}
+
+intptr_t import_asset_shared_file_input_stream::read_at(int64_t offset, void *data, size_t size)
+{
+	assert(INVALID_HANDLE_VALUE != this->m_file);
+
+	if (offset < 0)
+	{
+		return -1;
+	}
+
+	// NOTE: the "ReadFile" with the "OVERLAPPED" offset is positional and the concurrent calls on the synchronous handle are serialized by the system
+	size_t read_size = 0U;
+	while (read_size < size)
+	{
+		uint64_t const read_offset = static_cast<uint64_t>(offset) + read_size;
+
+		OVERLAPPED overlapped = {};
+		overlapped.Offset = static_cast<DWORD>(read_offset & 0XFFFFFFFFU);
+		overlapped.OffsetHigh = static_cast<DWORD>(read_offset >> 32U);
+
+		DWORD chunk_read_size;
+		BOOL res_read_file = ReadFile(this->m_file, reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(data) + read_size), static_cast<DWORD>(std::min(size - read_size, static_cast<size_t>(0X40000000U))), &chunk_read_size, &overlapped);
+		if (FALSE == res_read_file)
+		{
+			if (ERROR_HANDLE_EOF != GetLastError())
+			{
+				return -1;
+			}
+			break;
+		}
+		else if (0U == chunk_read_size)
+		{
+			// EOF
+			break;
+		}
+
+		read_size += chunk_read_size;
+	}
+
+	return static_cast<intptr_t>(read_size);
+}
+
+bool import_asset_shared_file_input_stream::is_read_at_thread_safe() const
+{
+	return true;
+}
+
+int64_t import_asset_shared_file_input_stream::seek(int64_t offset, int whence)
+{
+	assert(INVALID_HANDLE_VALUE != this->m_file);
+
+	int64_t new_offset;
+	switch (whence)
+	{
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_SET:
+	{
+		new_offset = offset;
+	}
+	break;
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_CUR:
+	{
+		new_offset = this->m_offset + offset;
+	}
+	break;
+	case IMPORT_ASSET_INPUT_STREAM_SEEK_END:
+	{
+		LARGE_INTEGER length;
+		if (FALSE == GetFileSizeEx(this->m_file, &length))
+		{
+			return -1;
+		}
+
+		new_offset = static_cast<int64_t>(length.QuadPart) + offset;
+	}
+	break;
+	default:
+		assert(false);
+		new_offset = -1;
+	}
+
+	// the same as "SetFilePointerEx": seeking beyond the end is allowed while seeking before the beginning is NOT
+	if (new_offset < 0)
+	{
+		return -1;
+	}
+
+	this->m_offset = new_offset;
+	return this->m_offset;
+}
+
+#else
+#error Unknown Compiler
+#endif
+
+intptr_t import_asset_shared_file_input_stream::read(void *data, size_t size)
+{
+	intptr_t read_size = this->read_at(this->m_offset, data, size);
+	if (read_size > 0)
+	{
+		this->m_offset += read_size;
+	}
+
+	return read_size;
+}
+
@@ -0,0 +1,129 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _IMPORT_ASSET_SHARED_FILE_INPUT_STREAM_H_
+#define _IMPORT_ASSET_SHARED_FILE_INPUT_STREAM_H_ 1
+
+#include "../include/import_asset_input_stream.h"
+#include "../../McRT-Malloc/include/mcrt_unordered_map.h"
+#include "../../McRT-Malloc/include/mcrt_string.h"
+#include <mutex>
+
+#if defined(__GNUC__)
+
+class import_asset_shared_file_input_stream_factory final : public import_asset_input_stream_factory
+{
+	struct import_asset_shared_file
+	{
+		int m_file;
+		uint32_t m_reference_count;
+	};
+
+	// the "fd" is opened when the path is firstly requested and is closed when the last input stream of the path is destroyed
+	std::mutex m_shared_files_mutex;
+	mcrt_unordered_map<mcrt_string, import_asset_shared_file> m_shared_files;
+
+	void release_shared_file(mcrt_string const *file_name);
+
+public:
+	import_asset_shared_file_input_stream_factory();
+	void init();
+	void uninit();
+	~import_asset_shared_file_input_stream_factory();
+
+private:
+	virtual import_asset_input_stream *create_instance(char const *file_name) override;
+	virtual void destory_instance(import_asset_input_stream *input_stream) override;
+};
+
+class import_asset_shared_file_input_stream final : public import_asset_input_stream
+{
+	// NOTE: the "fd" is owned (and reference counted) by the factory and all reads are positional ("pread") since the results of "lseek" can NOT be shared
+	int m_file;
+	int64_t m_offset;
+	// the key of the factory which is used to release the reference when the input stream is destroyed
+	mcrt_string const *m_file_name;
+
+public:
+	import_asset_shared_file_input_stream();
+	void init(int file, mcrt_string const *file_name);
+	mcrt_string const *uninit();
+	~import_asset_shared_file_input_stream();
+	int stat_size(int64_t *size) override;
+	intptr_t read(void *data, size_t size) override;
+	int64_t seek(int64_t offset, int whence) override;
+	intptr_t read_at(int64_t offset, void *data, size_t size) override;
+	bool is_read_at_thread_safe() const override;
+};
+
+#elif defined(_MSC_VER)
+
+#define NOMINMAX 1
+#define WIN32_LEAN_AND_MEAN 1
+#include <sdkddkver.h>
+#include <Windows.h>
+
+class import_asset_shared_file_input_stream_factory final : public import_asset_input_stream_factory
+{
+	struct import_asset_shared_file
+	{
+		HANDLE m_file;
+		uint32_t m_reference_count;
+	};
+
+	// the handle is opened when the path is firstly requested and is closed when the last input stream of the path is destroyed
+	std::mutex m_shared_files_mutex;
+	mcrt_unordered_map<mcrt_string, import_asset_shared_file> m_shared_files;
+
+	void release_shared_file(mcrt_string const *file_name);
+
+public:
+	import_asset_shared_file_input_stream_factory();
+	void init();
+	void uninit();
+	~import_asset_shared_file_input_stream_factory();
+
+private:
+	virtual import_asset_input_stream *create_instance(char const *file_name) override;
+	virtual void destory_instance(import_asset_input_stream *input_stream) override;
+};
+
+class import_asset_shared_file_input_stream final : public import_asset_input_stream
+{
+	// NOTE: the handle is owned (and reference counted) by the factory and all reads are positional ("ReadFile" with the "OVERLAPPED" offset) since the file pointer can NOT be shared
+	HANDLE m_file;
+	int64_t m_offset;
+	// the key of the factory which is used to release the reference when the input stream is destroyed
+	mcrt_string const *m_file_name;
+
+public:
+	import_asset_shared_file_input_stream();
+	void init(HANDLE file, mcrt_string const *file_name);
+	mcrt_string const *uninit();
+	~import_asset_shared_file_input_stream();
+	int stat_size(int64_t *size) override;
+	intptr_t read(void *data, size_t size) override;
+	int64_t seek(int64_t offset, int whence) override;
+	intptr_t read_at(int64_t offset, void *data, size_t size) override;
+	bool is_read_at_thread_safe() const override;
+};
+
+#else
+#error Unknown Compiler
+#endif
+
+#endif
@@ -16,8 +16,11 @@
 //
 #include <stddef.h>
 #include <assert.h>
+#include <cstring>
 #include <algorithm>
 #include "../include/import_image_asset.h"
+#include "internal_import_image_subresource.h"
+#include "../../McRT-Malloc/include/mcrt_vector.h"
 
 //--------------------------------------------------------------------------------------
 // DDS file structure definitions
@@ -251,9 +254,57 @@ struct DDS_HEADER_DXT10
     uint32_t miscFlags2;
 };
 
+//--------------------------------------------------------------------------------------
+// the "DDS_FORMAT"s which can be imported (both the header and the data)
+static constexpr struct
+{
+    DDS_FORMAT dds_format;
+    BRX_SAMPLED_ASSET_IMAGE_FORMAT format;
+} const DDS_FORMAT_MAPPINGS[] = {
+    {DDS_FORMAT_R8G8B8A8_UNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_UNORM},
+    {DDS_FORMAT_R8G8B8A8_UNORM_SRGB, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_SRGB},
+    {DDS_FORMAT_R8G8B8A8_SNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_SNORM},
+    {DDS_FORMAT_B8G8R8A8_UNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_B8G8R8A8_UNORM},
+    {DDS_FORMAT_B8G8R8A8_UNORM_SRGB, BRX_SAMPLED_ASSET_IMAGE_FORMAT_B8G8R8A8_SRGB},
+    {DDS_FORMAT_R8_UNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8_UNORM},
+    {DDS_FORMAT_R8_SNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8_SNORM},
+    {DDS_FORMAT_R8G8_UNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8_UNORM},
+    {DDS_FORMAT_R8G8_SNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8_SNORM},
+    {DDS_FORMAT_R16_UNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R16_UNORM},
+    {DDS_FORMAT_R16_FLOAT, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R16_SFLOAT},
+    {DDS_FORMAT_R16G16_UNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R16G16_UNORM},
+    {DDS_FORMAT_R16G16_FLOAT, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R16G16_SFLOAT},
+    {DDS_FORMAT_R16G16B16A16_UNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R16G16B16A16_UNORM},
+    {DDS_FORMAT_R16G16B16A16_FLOAT, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R16G16B16A16_SFLOAT},
+    {DDS_FORMAT_R32_FLOAT, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R32_SFLOAT},
+    {DDS_FORMAT_R32G32_FLOAT, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R32G32_SFLOAT},
+    {DDS_FORMAT_R32G32B32A32_FLOAT, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R32G32B32A32_SFLOAT},
+    {DDS_FORMAT_R10G10B10A2_UNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_A2B10G10R10_UNORM_PACK32},
+    {DDS_FORMAT_R11G11B10_FLOAT, BRX_SAMPLED_ASSET_IMAGE_FORMAT_B10G11R11_UFLOAT_PACK32},
+    {DDS_FORMAT_R9G9B9E5_SHAREDEXP, BRX_SAMPLED_ASSET_IMAGE_FORMAT_E5B9G9R9_UFLOAT_PACK32},
+    {DDS_FORMAT_BC1_UNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC1_RGBA_UNORM_BLOCK},
+    {DDS_FORMAT_BC1_UNORM_SRGB, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC1_RGBA_SRGB_BLOCK},
+    {DDS_FORMAT_BC2_UNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC2_UNORM_BLOCK},
+    {DDS_FORMAT_BC2_UNORM_SRGB, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC2_SRGB_BLOCK},
+    {DDS_FORMAT_BC3_UNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC3_UNORM_BLOCK},
+    {DDS_FORMAT_BC3_UNORM_SRGB, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC3_SRGB_BLOCK},
+    {DDS_FORMAT_BC4_UNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC4_UNORM_BLOCK},
+    {DDS_FORMAT_BC4_SNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC4_SNORM_BLOCK},
+    {DDS_FORMAT_BC5_UNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC5_UNORM_BLOCK},
+    {DDS_FORMAT_BC5_SNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC5_SNORM_BLOCK},
+    {DDS_FORMAT_BC6H_UF16, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC6H_UFLOAT_BLOCK},
+    {DDS_FORMAT_BC6H_SF16, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC6H_SFLOAT_BLOCK},
+    {DDS_FORMAT_BC7_UNORM, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_UNORM_BLOCK},
+    {DDS_FORMAT_BC7_UNORM_SRGB, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_SRGB_BLOCK},
+};
+
 //--------------------------------------------------------------------------------------
 static inline DDS_FORMAT GetDDSFormat(struct DDS_PIXELFORMAT const *ddpf);
 
+static inline bool DDSGetImageFormat(DDS_FORMAT dds_format, BRX_SAMPLED_ASSET_IMAGE_FORMAT *format);
+
+static inline DDS_FORMAT DDSGetFormatFromImageFormat(BRX_SAMPLED_ASSET_IMAGE_FORMAT format);
+
 static inline size_t BitsPerPixel(uint32_t fmt);
 
 static inline bool GetSurfaceInfo(size_t width, size_t height, uint32_t fmt, size_t *outNumBytes, size_t *outRowBytes, size_t *outNumRows);
@@ -471,24 +522,8 @@ extern bool import_dds_image_asset_header_from_input_stream(import_asset_input_s
 
     image_asset_header->is_cube_map = is_cube_map;
     image_asset_header->type = res_dim;
-    switch (dds_format)
+    if (!DDSGetImageFormat(dds_format, &image_asset_header->format))
     {
-    case DDS_FORMAT_R8G8B8A8_UNORM:
-        image_asset_header->format = BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_UNORM;
-        break;
-    case DDS_FORMAT_R8G8B8A8_UNORM_SRGB:
-        image_asset_header->format = BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_SRGB;
-        break;
-    case DDS_FORMAT_BC7_UNORM:
-        image_asset_header->format = BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_UNORM_BLOCK;
-        break;
-    case DDS_FORMAT_BC7_UNORM_SRGB:
-        image_asset_header->format = BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_SRGB_BLOCK;
-        break;
-    default:
-        // TODO: support more format
-        assert(false);
-        image_asset_header->format = static_cast<BRX_SAMPLED_ASSET_IMAGE_FORMAT>(-1);
         return false;
     }
     image_asset_header->width = width;
@@ -500,6 +535,11 @@ extern bool import_dds_image_asset_header_from_input_stream(import_asset_input_s
 }
 
 extern bool import_dds_image_asset_data_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests)
+{
+    return import_dds_image_asset_mip_range_data_from_input_stream(input_stream, image_asset_header, image_asset_data_offset, 0U, image_asset_header->mip_levels, staging_upload_buffer_base, subresource_count, subresource_memcpy_dests);
+}
+
+extern bool import_dds_image_asset_mip_range_data_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, uint32_t first_mip_level, uint32_t mip_level_count, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests)
 {
 #ifndef NDEBUG
     IMPORT_ASSET_IMAGE_HEADER image_asset_header_for_validate;
@@ -521,29 +561,66 @@ extern bool import_dds_image_asset_data_from_input_stream(import_asset_input_str
     assert(image_asset_data_offset == image_asset_data_offset_for_validate);
 #endif
 
-    if (-1 == input_stream->seek(image_asset_data_offset, IMPORT_ASSET_INPUT_STREAM_SEEK_SET))
+    mcrt_vector<IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT> subresource_layouts(subresource_count);
+    if (!import_dds_image_asset_subresource_layouts(image_asset_header, image_asset_data_offset, subresource_count, subresource_layouts.data()))
     {
         return false;
     }
 
-    DDS_FORMAT dds_format;
-    switch (image_asset_header->format)
+    // only the selected mip levels are read (e.g. the mip tail is loaded first and the higher mip levels are streamed on demand)
+    mcrt_vector<uint32_t> selected_subresource_indices;
+    if (!internal_import_image_select_mip_range(image_asset_header, first_mip_level, mip_level_count, subresource_count, &selected_subresource_indices))
     {
-    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_UNORM:
-        dds_format = DDS_FORMAT_R8G8B8A8_UNORM;
-        break;
-    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_SRGB:
-        dds_format = DDS_FORMAT_R8G8B8A8_UNORM_SRGB;
-        break;
-    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_UNORM_BLOCK:
-        dds_format = DDS_FORMAT_BC7_UNORM;
-        break;
-    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_SRGB_BLOCK:
-        dds_format = DDS_FORMAT_BC7_UNORM_SRGB;
-        break;
-    default:
-        assert(false);
-        dds_format = static_cast<DDS_FORMAT>(-1);
+        return false;
+    }
+
+    return internal_import_image_subresources_from_input_stream(input_stream, image_asset_data_offset, staging_upload_buffer_base, subresource_count, subresource_layouts.data(), subresource_memcpy_dests, selected_subresource_indices.size(), selected_subresource_indices.data());
+}
+
+extern bool import_dds_image_asset_data_from_input_stream_parallel(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests, import_asset_task_scheduler *task_scheduler)
+{
+#ifndef NDEBUG
+    IMPORT_ASSET_IMAGE_HEADER image_asset_header_for_validate;
+    size_t image_asset_data_offset_for_validate;
+    if (!import_dds_image_asset_header_from_input_stream(input_stream, &image_asset_header_for_validate, &image_asset_data_offset_for_validate))
+    {
+        return false;
+    }
+
+    assert(image_asset_header->is_cube_map == image_asset_header_for_validate.is_cube_map);
+    assert(image_asset_header->type == image_asset_header_for_validate.type);
+    assert(image_asset_header->format == image_asset_header_for_validate.format);
+    assert(image_asset_header->width == image_asset_header_for_validate.width);
+    assert(image_asset_header->height == image_asset_header_for_validate.height);
+    assert(image_asset_header->depth == image_asset_header_for_validate.depth);
+    assert(image_asset_header->mip_levels == image_asset_header_for_validate.mip_levels);
+    assert(image_asset_header->array_layers == image_asset_header_for_validate.array_layers);
+
+    assert(image_asset_data_offset == image_asset_data_offset_for_validate);
+#endif
+
+    // the offset of each subresource is computed up front and the subresources are independent of each other
+    mcrt_vector<IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT> subresource_layouts(subresource_count);
+    if (!import_dds_image_asset_subresource_layouts(image_asset_header, image_asset_data_offset, subresource_count, subresource_layouts.data()))
+    {
+        return false;
+    }
+
+    mcrt_vector<uint32_t> selected_subresource_indices;
+    if (!internal_import_image_select_mip_range(image_asset_header, 0U, image_asset_header->mip_levels, subresource_count, &selected_subresource_indices))
+    {
+        return false;
+    }
+
+    return internal_import_image_subresources_from_input_stream_parallel(input_stream, image_asset_data_offset, staging_upload_buffer_base, subresource_count, subresource_layouts.data(), subresource_memcpy_dests, selected_subresource_indices.size(), selected_subresource_indices.data(), task_scheduler);
+}
+
+extern bool import_dds_image_asset_subresource_layouts(IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, size_t subresource_count, IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT *subresource_layouts)
+{
+    DDS_FORMAT const dds_format = DDSGetFormatFromImageFormat(image_asset_header->format);
+    if (DDS_FORMAT_UNKNOWN == dds_format)
+    {
+        return false;
     }
 
     uint32_t const numberOfPlanes = DDSGetFormatPlaneCount(dds_format);
@@ -565,15 +642,16 @@ extern bool import_dds_image_asset_data_from_input_stream(import_asset_input_str
         return false;
     }
 
-    size_t inputSkipBytes = image_asset_data_offset;
-
     // TODO: support more than one plane
-    assert(1U == numberOfPlanes);
-    for (uint32_t planeSlice = 0; planeSlice < 1U; ++planeSlice)
+    if (1U != numberOfPlanes)
     {
-        // AdjustPlaneResource
+        return false;
+    }
+
+    size_t inputSkipBytes = image_asset_data_offset;
 
-        // Create the texture
+    for (uint32_t planeSlice = 0; planeSlice < numberOfPlanes; ++planeSlice)
+    {
         for (uint32_t arraySlice = 0; arraySlice < image_asset_header->array_layers; ++arraySlice)
         {
             size_t w = image_asset_header->width;
@@ -581,7 +659,6 @@ extern bool import_dds_image_asset_data_from_input_stream(import_asset_input_str
             size_t d = image_asset_header->depth;
             for (uint32_t mipSlice = 0; mipSlice < image_asset_header->mip_levels; ++mipSlice)
             {
-
                 size_t NumBytes = 0U;
                 size_t RowBytes = 0U;
                 size_t NumRows = 0U;
@@ -595,68 +672,19 @@ extern bool import_dds_image_asset_data_from_input_stream(import_asset_input_str
                     return false;
                 }
 
-                // GetLoadFunctionsLoadFunctionsMap libANGLE/renderer/load_functions_table_autogen.cpp
-                // LoadToNative
-                // LoadCompressedToNative
-                size_t inputRowSize = RowBytes;
-                size_t inputNumRows = NumRows;
-                size_t inputSliceSize = NumBytes;
-                size_t inputNumSlices = d;
-
-                // MemcpySubresource d3dx12.h
                 uint32_t dstSubresource = brx_sampled_asset_image_import_calculate_subresource_index(mipSlice, arraySlice, planeSlice, image_asset_header->mip_levels, image_asset_header->array_layers);
-                assert(dstSubresource < subresource_count);
-
-                assert(inputNumSlices == subresource_memcpy_dests[dstSubresource].output_slice_count);
-                assert(inputNumRows == subresource_memcpy_dests[dstSubresource].output_row_count);
-                assert(inputRowSize == subresource_memcpy_dests[dstSubresource].output_row_size);
-
-                if (inputSliceSize == subresource_memcpy_dests[dstSubresource].output_slice_pitch && inputRowSize == subresource_memcpy_dests[dstSubresource].output_row_pitch)
+                if (dstSubresource >= subresource_count)
                 {
-                    assert(input_stream->seek(0, IMPORT_ASSET_INPUT_STREAM_SEEK_CUR) == inputSkipBytes);
-
-                    ptrdiff_t BytesRead = input_stream->read(reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(staging_upload_buffer_base) + subresource_memcpy_dests[dstSubresource].staging_upload_buffer_offset), inputSliceSize * inputNumSlices);
-                    if (BytesRead == -1 || static_cast<size_t>(BytesRead) < (inputSliceSize * inputNumSlices))
-                    {
-                        return false;
-                    }
-                }
-                else if (inputRowSize == subresource_memcpy_dests[dstSubresource].output_row_pitch)
-                {
-                    assert(inputSliceSize <= subresource_memcpy_dests[dstSubresource].output_slice_pitch);
-
-                    for (size_t z = 0; z < inputNumSlices; ++z)
-                    {
-                        assert(input_stream->seek(0, IMPORT_ASSET_INPUT_STREAM_SEEK_CUR) == (inputSkipBytes + inputSliceSize * z));
-
-                        ptrdiff_t BytesRead = input_stream->read(reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(staging_upload_buffer_base) + (subresource_memcpy_dests[dstSubresource].staging_upload_buffer_offset + subresource_memcpy_dests[dstSubresource].output_slice_pitch * z)), inputSliceSize);
-                        if (BytesRead == -1 || static_cast<size_t>(BytesRead) < inputSliceSize)
-                        {
-                            return false;
-                        }
-                    }
-                }
-                else
-                {
-                    assert(inputSliceSize <= subresource_memcpy_dests[dstSubresource].output_slice_pitch);
-                    assert(inputRowSize <= subresource_memcpy_dests[dstSubresource].output_row_pitch);
-
-                    for (size_t z = 0; z < inputNumSlices; ++z)
-                    {
-                        for (size_t y = 0; y < inputNumRows; ++y)
-                        {
-                            assert(input_stream->seek(0, IMPORT_ASSET_INPUT_STREAM_SEEK_CUR) == (inputSkipBytes + inputSliceSize * z + inputRowSize * y));
-
-                            ptrdiff_t BytesRead = input_stream->read(reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(staging_upload_buffer_base) + (subresource_memcpy_dests[dstSubresource].staging_upload_buffer_offset + subresource_memcpy_dests[dstSubresource].output_slice_pitch * z + subresource_memcpy_dests[dstSubresource].output_row_pitch * y)), inputRowSize);
-                            if (BytesRead == -1 || static_cast<size_t>(BytesRead) < inputRowSize)
-                            {
-                                return false;
-                            }
-                        }
-                    }
+                    return false;
                 }
 
-                inputSkipBytes += inputSliceSize * inputNumSlices;
+                subresource_layouts[dstSubresource].offset = inputSkipBytes;
+                subresource_layouts[dstSubresource].row_size = static_cast<uint32_t>(RowBytes);
+                subresource_layouts[dstSubresource].row_count = static_cast<uint32_t>(NumRows);
+                subresource_layouts[dstSubresource].slice_size = static_cast<uint32_t>(NumBytes);
+                subresource_layouts[dstSubresource].slice_count = static_cast<uint32_t>(d);
+
+                inputSkipBytes += NumBytes * d;
 
                 w = w >> 1;
                 h = h >> 1;
@@ -677,11 +705,38 @@ extern bool import_dds_image_asset_data_from_input_stream(import_asset_input_str
         }
     }
 
-    uint8_t u_assert_only[1];
-    assert(input_stream->read(u_assert_only, sizeof(uint8_t)) == 0);
     return true;
 }
 
+//--------------------------------------------------------------------------------------
+static inline bool DDSGetImageFormat(DDS_FORMAT dds_format, BRX_SAMPLED_ASSET_IMAGE_FORMAT *format)
+{
+    for (auto const &dds_format_mapping : DDS_FORMAT_MAPPINGS)
+    {
+        if (dds_format == dds_format_mapping.dds_format)
+        {
+            (*format) = dds_format_mapping.format;
+            return true;
+        }
+    }
+
+    // TODO: support more format
+    return false;
+}
+
+static inline DDS_FORMAT DDSGetFormatFromImageFormat(BRX_SAMPLED_ASSET_IMAGE_FORMAT format)
+{
+    for (auto const &dds_format_mapping : DDS_FORMAT_MAPPINGS)
+    {
+        if (format == dds_format_mapping.format)
+        {
+            return dds_format_mapping.dds_format;
+        }
+    }
+
+    return DDS_FORMAT_UNKNOWN;
+}
+
 //--------------------------------------------------------------------------------------
 static inline DDS_FORMAT GetDDSFormat(DDS_PIXELFORMAT const *ddpf)
 {
@@ -27,16 +27,26 @@
 #endif
 #include <cmath>
 #include <algorithm>
+#include <mutex>
 #include <assert.h>
 #include "../../Packed-Vector/shaders/packed_vector.sli"
 #include "../../Packed-Vector/shaders/octahedron_mapping.sli"
 #include "../../McRT-Malloc/include/mcrt_unordered_map.h"
 #include "../thirdparty/cgltf/cgltf.h"
 #include "../thirdparty/DirectXMesh/DirectXMesh/DirectXMesh.h"
+#include "internal_import_gltf_accessor.h"
 
 static cgltf_result cgltf_custom_read_file(const struct cgltf_memory_options *memory_options, const struct cgltf_file_options *, const char *path, cgltf_size *size, void **data);
 
-static void cgltf_custom_file_release(const struct cgltf_memory_options *memory_options, const struct cgltf_file_options *, void *data);
+static void cgltf_custom_file_release(const struct cgltf_memory_options *memory_options, const struct cgltf_file_options *file_options, void *data);
+
+struct cgltf_custom_file_context
+{
+    import_asset_input_stream_factory *m_input_stream_factory;
+    // the mapped input streams should be kept alive until the file data is released
+    // NOTE: the same mapping may be returned more than once (e.g. the buffers which refer to the same file of the memory input stream) and "cgltf_custom_file_release" is called once for each "cgltf_custom_read_file"
+    mcrt_unordered_map<void const *, mcrt_vector<import_asset_input_stream *>> m_mapped_input_streams;
+};
 
 static void *cgltf_custom_alloc(void *, cgltf_size size);
 
@@ -46,16 +56,119 @@ static inline uint32_t sqrt_ceil(uint32_t x);
 
 static inline void decode_morton2(uint32_t const v, uint32_t &x, uint32_t &y);
 
-static inline void import_gltf_scene_mesh_asset(scene_mesh_data *out_mesh_data, int32_t *out_max_joint_index, cgltf_data const *data, cgltf_mesh const *mesh);
+// the number of the vertices decoded into the stack buffers at a time when the varying binding is packed directly from the accessors
+static constexpr size_t const k_vertex_varying_binding_block_size = 64U;
+
+// the number of the vertices packed at a time by the SoA kernel (one vertex per lane of the XMVECTOR)
+static constexpr size_t const k_vertex_varying_binding_pack_width = 4U;
+
+// the number of the vertices decoded into the stack buffers at a time when the joint weights are packed
+static constexpr size_t const k_vertex_joint_binding_block_size = 64U;
+
+static constexpr size_t const k_decode_arena_alignment = 16U;
+
+// the scratch memory of the attributes generated from the whole primitive (e.g. the computed normals)
+// the arena is reset between the primitives such that the same allocation is reused by all primitives decoded by the same arena
+struct import_gltf_scene_decode_arena
+{
+    void *m_base;
+    size_t m_capacity;
+    size_t m_size;
+};
+
+// the task scheduler provides no thread index and thus the idle arenas are pooled instead of being indexed by the thread
+// the pool lives as long as the import and the number of the arenas is bounded by the number of the concurrent decode tasks
+struct import_gltf_scene_decode_arena_pool
+{
+    std::mutex m_mutex;
+    mcrt_vector<import_gltf_scene_decode_arena *> m_arenas;
+};
+
+struct import_gltf_scene_primitive_data
+{
+    size_t m_mesh_index;
+    size_t m_subset_index;
+
+    cgltf_accessor const *m_index_accessor;
+    cgltf_accessor const *m_position_accessor;
+    cgltf_accessor const *m_normal_accessor;
+    cgltf_accessor const *m_tangent_accessor;
+    cgltf_accessor const *m_texcoord_accessor;
+    cgltf_accessor const *m_joints_accessor;
+    cgltf_accessor const *m_weights_accessor;
+
+    size_t m_vertex_count;
+    size_t m_index_count;
+    bool m_skinned;
+
+    // written by the counting pass
+    uint32_t m_out_subset_vertex_index_offset;
+    uint32_t m_out_subset_index_index_offset;
+
+    // written by the decode tasks
+    uint32_t m_raw_max_index;
+    uint16_t m_raw_max_joint_index;
+};
+
+struct import_gltf_scene_primitive_task_context
+{
+    import_gltf_scene_primitive_data *primitive_data;
+    import_gltf_scene_decode_arena_pool *arena_pool;
+    scene_mesh_data *out_total_mesh_data;
+};
+
+struct import_gltf_scene_mesh_task_context
+{
+    cgltf_data const *data;
+    float frame_rate;
+    int32_t const *max_joint_indices;
+    scene_mesh_data *out_total_mesh_data;
+};
+
+static void import_gltf_scene_primitive_decode_task_function(uint32_t task_index, void *user_data);
+
+static void import_gltf_scene_mesh_task_function(uint32_t task_index, void *user_data);
+
+static inline void import_gltf_scene_mesh_asset(scene_mesh_data *out_mesh_data, mcrt_vector<import_gltf_scene_primitive_data> &out_primitive_data, cgltf_data const *data, size_t mesh_index);
+
+static inline void import_gltf_scene_pack_vertex_varying_bindings(DirectX::XMFLOAT3 const *normals, DirectX::XMFLOAT4 const *tangents, DirectX::XMFLOAT2 const *texcoords, size_t vertex_count, scene_mesh_vertex_varying_binding *out_vertex_varying_bindings);
+
+static inline void import_gltf_scene_octahedron_map_soa(DirectX::FXMVECTOR x, DirectX::FXMVECTOR y, DirectX::FXMVECTOR z, DirectX::XMVECTOR *out_u, DirectX::XMVECTOR *out_v);
+
+static inline void import_gltf_scene_mesh_subset_offsets(scene_mesh_data &out_mesh_data, import_gltf_scene_primitive_data *primitive_data, size_t primitive_count);
+
+static inline void import_gltf_scene_mesh_subset_max_indices(scene_mesh_data &out_mesh_data, int32_t *out_max_joint_index, import_gltf_scene_primitive_data const *primitive_data, size_t primitive_count);
+
+static inline import_gltf_scene_decode_arena *import_gltf_scene_decode_arena_acquire(import_gltf_scene_decode_arena_pool *arena_pool);
+
+static inline void import_gltf_scene_decode_arena_release(import_gltf_scene_decode_arena_pool *arena_pool, import_gltf_scene_decode_arena *arena);
+
+static inline void import_gltf_scene_decode_arena_pool_destroy(import_gltf_scene_decode_arena_pool *arena_pool);
+
+static inline size_t import_gltf_scene_decode_arena_aligned_size(size_t size);
+
+static inline void import_gltf_scene_decode_arena_reset(import_gltf_scene_decode_arena *arena, size_t capacity);
+
+static inline void *import_gltf_scene_decode_arena_allocate(import_gltf_scene_decode_arena *arena, size_t size);
+
+static inline void import_gltf_scene_mesh_instances_asset(scene_mesh_data *out_mesh_data, int32_t max_joint_index, float frame_rate, cgltf_data const *data, cgltf_mesh const *mesh);
 
 static inline void import_gltf_scene_mesh_instance_asset(mcrt_vector<cgltf_node const *> &out_mesh_instance_nodes, mcrt_vector<DirectX::XMFLOAT4X4> &out_mesh_instance_node_world_transforms, cgltf_data const *data, cgltf_mesh const *mesh);
 
 static inline void import_gltf_scene_animation_asset(scene_animation_skeleton *out_animated_skeleton, float frame_rate, cgltf_data const *data, cgltf_skin const *skin, cgltf_animation const *animation);
 
 extern bool import_gltf_scene_asset(mcrt_vector<scene_mesh_data> &out_total_mesh_data, float frame_rate, import_asset_input_stream_factory *input_stream_factory, char const *path)
+{
+    return import_gltf_scene_asset_parallel(out_total_mesh_data, frame_rate, input_stream_factory, path, NULL);
+}
+
+extern bool import_gltf_scene_asset_parallel(mcrt_vector<scene_mesh_data> &out_total_mesh_data, float frame_rate, import_asset_input_stream_factory *input_stream_factory, char const *path, import_asset_task_scheduler *task_scheduler)
 {
     // TODO: merge primitives with the same material from different meshes (consider multiple instances)
 
+    cgltf_custom_file_context file_context;
+    file_context.m_input_stream_factory = input_stream_factory;
+
     cgltf_data *data = NULL;
     {
         cgltf_options options = {};
@@ -63,7 +176,7 @@ extern bool import_gltf_scene_asset(mcrt_vector<scene_mesh_data> &out_total_mesh
         options.memory.free_func = cgltf_custom_free;
         options.file.read = cgltf_custom_read_file;
         options.file.release = cgltf_custom_file_release;
-        options.file.user_data = input_stream_factory;
+        options.file.user_data = &file_context;
 
         cgltf_result result_parse_file = cgltf_parse_file(&options, path, &data);
         if (cgltf_result_success != result_parse_file)
@@ -81,98 +194,181 @@ extern bool import_gltf_scene_asset(mcrt_vector<scene_mesh_data> &out_total_mesh
 
     out_total_mesh_data.resize(data->meshes_count);
 
-    for (size_t mesh_index = 0; mesh_index < data->meshes_count; ++mesh_index)
+    assert(data->meshes_count <= static_cast<size_t>(UINT32_MAX));
+    uint32_t const mesh_count = static_cast<uint32_t>(data->meshes_count);
+
+    // the subsets (and the materials) are assigned serially since this is cheap and the merge order of the primitives is the same as the glTF file
+    // the primitives of the same mesh are contiguous in the "primitive_data"
+    mcrt_vector<import_gltf_scene_primitive_data> primitive_data;
+    mcrt_vector<size_t> mesh_primitive_data_offsets(static_cast<size_t>(mesh_count) + 1U);
+    for (uint32_t mesh_index = 0U; mesh_index < mesh_count; ++mesh_index)
     {
-        scene_mesh_data &out_mesh_data = out_total_mesh_data[mesh_index];
-        int32_t max_joint_index;
-        import_gltf_scene_mesh_asset(&out_mesh_data, &max_joint_index, data, &data->meshes[mesh_index]);
+        mesh_primitive_data_offsets[mesh_index] = primitive_data.size();
+        import_gltf_scene_mesh_asset(&out_total_mesh_data[mesh_index], primitive_data, data, mesh_index);
+    }
+    mesh_primitive_data_offsets[mesh_count] = primitive_data.size();
 
-        mcrt_vector<cgltf_node const *> mesh_instance_nodes;
-        mcrt_vector<DirectX::XMFLOAT4X4> mesh_instance_node_world_transforms;
-        import_gltf_scene_mesh_instance_asset(mesh_instance_nodes, mesh_instance_node_world_transforms, data, &data->meshes[mesh_index]);
+    // the tasks of the primitives from all meshes are flattened into the same "parallel_for" rather than nested within the mesh tasks
+    assert(primitive_data.size() <= static_cast<size_t>(UINT32_MAX));
+    uint32_t const primitive_count = static_cast<uint32_t>(primitive_data.size());
 
-        size_t const mesh_instance_count = mesh_instance_nodes.size();
-        assert(mesh_instance_node_world_transforms.size() == mesh_instance_count);
+    // the counts of the primitives are known before decoding and thus each subset is allocated exactly once by the prefix sum of the vertex and index counts
+    for (uint32_t mesh_index = 0U; mesh_index < mesh_count; ++mesh_index)
+    {
+        size_t const mesh_primitive_data_offset = mesh_primitive_data_offsets[mesh_index];
+        import_gltf_scene_mesh_subset_offsets(out_total_mesh_data[mesh_index], primitive_data.data() + mesh_primitive_data_offset, mesh_primitive_data_offsets[mesh_index + 1U] - mesh_primitive_data_offset);
+    }
+
+    import_gltf_scene_decode_arena_pool arena_pool;
 
-        mcrt_vector<scene_mesh_instance_data> &out_mesh_instance_data = out_mesh_data.m_instances;
-        if (!out_mesh_data.m_skinned)
+    import_gltf_scene_primitive_task_context primitive_context;
+    primitive_context.primitive_data = primitive_data.data();
+    primitive_context.arena_pool = &arena_pool;
+    primitive_context.out_total_mesh_data = out_total_mesh_data.data();
+
+    // the primitives are independent of each other since each task only reads the (immutable) parsed data and the ranges of the subsets written by the different primitives do not overlap
+    if (NULL != task_scheduler)
+    {
+        task_scheduler->parallel_for(primitive_count, import_gltf_scene_primitive_decode_task_function, &primitive_context);
+    }
+    else
+    {
+        for (uint32_t primitive_data_index = 0U; primitive_data_index < primitive_count; ++primitive_data_index)
         {
-            assert(max_joint_index < 0);
+            import_gltf_scene_primitive_decode_task_function(primitive_data_index, &primitive_context);
+        }
+    }
 
-            out_mesh_instance_data.resize(mesh_instance_count);
+    import_gltf_scene_decode_arena_pool_destroy(&arena_pool);
 
-            for (size_t mesh_instance_index = 0; mesh_instance_index < mesh_instance_count; ++mesh_instance_index)
-            {
-                assert(NULL == mesh_instance_nodes[mesh_instance_index]->skin);
-                out_mesh_instance_data[mesh_instance_index].m_model_transform = mesh_instance_node_world_transforms[mesh_instance_index];
-            }
+    // the max indices depend on the decoded indices
+    mcrt_vector<int32_t> max_joint_indices(mesh_count);
+    for (uint32_t mesh_index = 0U; mesh_index < mesh_count; ++mesh_index)
+    {
+        size_t const mesh_primitive_data_offset = mesh_primitive_data_offsets[mesh_index];
+        import_gltf_scene_mesh_subset_max_indices(out_total_mesh_data[mesh_index], &max_joint_indices[mesh_index], primitive_data.data() + mesh_primitive_data_offset, mesh_primitive_data_offsets[mesh_index + 1U] - mesh_primitive_data_offset);
+    }
+
+    mcrt_vector<import_gltf_scene_primitive_data>().swap(primitive_data);
+
+    import_gltf_scene_mesh_task_context mesh_context;
+    mesh_context.data = data;
+    mesh_context.frame_rate = frame_rate;
+    mesh_context.max_joint_indices = max_joint_indices.data();
+    mesh_context.out_total_mesh_data = out_total_mesh_data.data();
+
+    // the meshes are independent of each other since each task only reads the (immutable) parsed data and writes the pre-sized element of the "out_total_mesh_data"
+    if (NULL != task_scheduler)
+    {
+        task_scheduler->parallel_for(mesh_count, import_gltf_scene_mesh_task_function, &mesh_context);
+    }
+    else
+    {
+        for (uint32_t mesh_index = 0U; mesh_index < mesh_count; ++mesh_index)
+        {
+            import_gltf_scene_mesh_task_function(mesh_index, &mesh_context);
         }
-        else
+    }
+
+    cgltf_free(data);
+
+    assert(file_context.m_mapped_input_streams.empty());
+
+    return true;
+}
+
+static void import_gltf_scene_mesh_task_function(uint32_t task_index, void *user_data)
+{
+    import_gltf_scene_mesh_task_context const *const context = static_cast<import_gltf_scene_mesh_task_context const *>(user_data);
+
+    assert(task_index < context->data->meshes_count);
+
+    import_gltf_scene_mesh_instances_asset(&context->out_total_mesh_data[task_index], context->max_joint_indices[task_index], context->frame_rate, context->data, &context->data->meshes[task_index]);
+}
+
+static void import_gltf_scene_mesh_instances_asset(scene_mesh_data *out_mesh_data, int32_t max_joint_index, float frame_rate, cgltf_data const *data, cgltf_mesh const *mesh)
+{
+    mcrt_vector<cgltf_node const *> mesh_instance_nodes;
+    mcrt_vector<DirectX::XMFLOAT4X4> mesh_instance_node_world_transforms;
+    import_gltf_scene_mesh_instance_asset(mesh_instance_nodes, mesh_instance_node_world_transforms, data, mesh);
+
+    size_t const mesh_instance_count = mesh_instance_nodes.size();
+    assert(mesh_instance_node_world_transforms.size() == mesh_instance_count);
+
+    mcrt_vector<scene_mesh_instance_data> &out_mesh_instance_data = out_mesh_data->m_instances;
+    if (!out_mesh_data->m_skinned)
+    {
+        assert(max_joint_index < 0);
+
+        out_mesh_instance_data.resize(mesh_instance_count);
+
+        for (size_t mesh_instance_index = 0; mesh_instance_index < mesh_instance_count; ++mesh_instance_index)
         {
-            assert(max_joint_index >= 0);
+            assert(NULL == mesh_instance_nodes[mesh_instance_index]->skin);
+            out_mesh_instance_data[mesh_instance_index].m_model_transform = mesh_instance_node_world_transforms[mesh_instance_index];
+        }
+    }
+    else
+    {
+        assert(max_joint_index >= 0);
 
-            out_mesh_instance_data.resize(mesh_instance_count);
+        out_mesh_instance_data.resize(mesh_instance_count);
 
-            for (size_t mesh_instance_index = 0; mesh_instance_index < mesh_instance_count; ++mesh_instance_index)
+        for (size_t mesh_instance_index = 0; mesh_instance_index < mesh_instance_count; ++mesh_instance_index)
+        {
+            cgltf_skin const *skin = mesh_instance_nodes[mesh_instance_index]->skin;
+            if (NULL != skin)
             {
-                cgltf_skin const *skin = mesh_instance_nodes[mesh_instance_index]->skin;
-                if (NULL != skin)
-                {
-                    // TODO: support multiple animations
-                    cgltf_animation const *animation = ((data->animations_count > 0) ? (&data->animations[0]) : NULL);
+                // TODO: support multiple animations
+                cgltf_animation const *animation = ((data->animations_count > 0) ? (&data->animations[0]) : NULL);
 
 #ifndef NDEBUG
-                    // glTF Validator
-                    // NODE_SKINNED_MESH_NON_ROOT
-                    // NODE_SKINNED_MESH_LOCAL_TRANSFORMS
-                    DirectX::XMVECTOR out_instance_node_world_scale;
-                    DirectX::XMVECTOR out_instance_node_world_rotation;
-                    DirectX::XMVECTOR out_instance_node_world_translation;
-                    DirectX::XMMatrixDecompose(&out_instance_node_world_scale, &out_instance_node_world_rotation, &out_instance_node_world_translation, DirectX::XMLoadFloat4x4(&mesh_instance_node_world_transforms[mesh_instance_index]));
-
-                    // FLT_EPSILON
-                    constexpr float const scale_epsilon = 1E-5F;
-                    assert(DirectX::XMVector3EqualInt(DirectX::XMVectorTrueInt(), DirectX::XMVectorLess(DirectX::XMVectorAbs(DirectX::XMVectorSubtract(out_instance_node_world_scale, DirectX::XMVectorSplatOne())), DirectX::XMVectorReplicate(scale_epsilon))));
-                    constexpr float const rotation_epsilon = 1E-5F;
-                    assert(DirectX::XMVector3EqualInt(DirectX::XMVectorTrueInt(), DirectX::XMVectorLess(DirectX::XMVectorAbs(DirectX::XMVectorSubtract(out_instance_node_world_rotation, DirectX::XMQuaternionIdentity())), DirectX::XMVectorReplicate(rotation_epsilon))));
-                    constexpr float const translation_epsilon = 1E-5F;
-                    assert(DirectX::XMVector3EqualInt(DirectX::XMVectorTrueInt(), DirectX::XMVectorLess(DirectX::XMVectorAbs(DirectX::XMVectorSubtract(out_instance_node_world_translation, DirectX::XMVectorZero())), DirectX::XMVectorReplicate(translation_epsilon))));
+                // glTF Validator
+                // NODE_SKINNED_MESH_NON_ROOT
+                // NODE_SKINNED_MESH_LOCAL_TRANSFORMS
+                DirectX::XMVECTOR out_instance_node_world_scale;
+                DirectX::XMVECTOR out_instance_node_world_rotation;
+                DirectX::XMVECTOR out_instance_node_world_translation;
+                DirectX::XMMatrixDecompose(&out_instance_node_world_scale, &out_instance_node_world_rotation, &out_instance_node_world_translation, DirectX::XMLoadFloat4x4(&mesh_instance_node_world_transforms[mesh_instance_index]));
+
+                // FLT_EPSILON
+                constexpr float const scale_epsilon = 1E-5F;
+                assert(DirectX::XMVector3EqualInt(DirectX::XMVectorTrueInt(), DirectX::XMVectorLess(DirectX::XMVectorAbs(DirectX::XMVectorSubtract(out_instance_node_world_scale, DirectX::XMVectorSplatOne())), DirectX::XMVectorReplicate(scale_epsilon))));
+                constexpr float const rotation_epsilon = 1E-5F;
+                assert(DirectX::XMVector3EqualInt(DirectX::XMVectorTrueInt(), DirectX::XMVectorLess(DirectX::XMVectorAbs(DirectX::XMVectorSubtract(out_instance_node_world_rotation, DirectX::XMQuaternionIdentity())), DirectX::XMVectorReplicate(rotation_epsilon))));
+                constexpr float const translation_epsilon = 1E-5F;
+                assert(DirectX::XMVector3EqualInt(DirectX::XMVectorTrueInt(), DirectX::XMVectorLess(DirectX::XMVectorAbs(DirectX::XMVectorSubtract(out_instance_node_world_translation, DirectX::XMVectorZero())), DirectX::XMVectorReplicate(translation_epsilon))));
 #endif
-                    DirectX::XMStoreFloat4x4(&out_mesh_instance_data[mesh_instance_index].m_model_transform, DirectX::XMMatrixIdentity());
+                DirectX::XMStoreFloat4x4(&out_mesh_instance_data[mesh_instance_index].m_model_transform, DirectX::XMMatrixIdentity());
 
-                    import_gltf_scene_animation_asset(&out_mesh_instance_data[mesh_instance_index].m_animation_skeleton, frame_rate, data, skin, animation);
-                }
-                else
-                {
-                    // TODO: This should NOT happen
-                    assert(0);
+                import_gltf_scene_animation_asset(&out_mesh_instance_data[mesh_instance_index].m_animation_skeleton, frame_rate, data, skin, animation);
+            }
+            else
+            {
+                // TODO: This should NOT happen
+                assert(0);
 
-                    out_mesh_instance_data[mesh_instance_index].m_model_transform = mesh_instance_node_world_transforms[mesh_instance_index];
+                out_mesh_instance_data[mesh_instance_index].m_model_transform = mesh_instance_node_world_transforms[mesh_instance_index];
 
-                    out_mesh_instance_data[mesh_instance_index].m_animation_skeleton.init(1, (max_joint_index + 1));
+                out_mesh_instance_data[mesh_instance_index].m_animation_skeleton.init(1, (max_joint_index + 1));
 
-                    DirectX::XMFLOAT4 quaternion;
-                    DirectX::XMFLOAT3 translation;
-                    DirectX::XMStoreFloat4(&quaternion, DirectX::XMQuaternionIdentity());
-                    DirectX::XMStoreFloat3(&translation, DirectX::XMVectorZero());
+                DirectX::XMFLOAT4 quaternion;
+                DirectX::XMFLOAT3 translation;
+                DirectX::XMStoreFloat4(&quaternion, DirectX::XMQuaternionIdentity());
+                DirectX::XMStoreFloat3(&translation, DirectX::XMVectorZero());
 
-                    for (int32_t joint_index = 0; joint_index < (max_joint_index + 1); ++joint_index)
-                    {
-                        out_mesh_instance_data[mesh_instance_index].m_animation_skeleton.set_transform(0, joint_index, quaternion, translation);
-                    }
+                for (int32_t joint_index = 0; joint_index < (max_joint_index + 1); ++joint_index)
+                {
+                    out_mesh_instance_data[mesh_instance_index].m_animation_skeleton.set_transform(0, joint_index, quaternion, translation);
                 }
             }
         }
     }
-
-    cgltf_free(data);
-
-    return true;
 }
 
-static void import_gltf_scene_mesh_asset(scene_mesh_data *out_mesh_data, int32_t *out_max_joint_index, cgltf_data const *data, cgltf_mesh const *mesh)
+static void import_gltf_scene_mesh_asset(scene_mesh_data *out_mesh_data, mcrt_vector<import_gltf_scene_primitive_data> &out_primitive_data, cgltf_data const *data, size_t mesh_index)
 {
-    (*out_max_joint_index) = -1;
+    cgltf_mesh const *const mesh = &data->meshes[mesh_index];
 
     mcrt_unordered_map<size_t, size_t> subset_material_indices;
     subset_material_indices.reserve(mesh->primitives_count);
@@ -270,414 +466,20 @@ static void import_gltf_scene_mesh_asset(scene_mesh_data *out_mesh_data, int32_t
                             weights_index = vertex_attribute->index;
                         }
                     }
-                    break;
-                    default:
-                    {
-                        // Do Nothing
-                    }
-                    }
-                }
-            }
-
-            if (NULL != position_accessor)
-            {
-                cgltf_accessor const *const index_accessor = primitive->indices;
-
-                size_t const vertex_count = position_accessor->count;
-                size_t const index_count = (NULL != index_accessor) ? index_accessor->count : vertex_count;
-
-                uint32_t raw_max_index = 0U;
-                mcrt_vector<uint32_t> raw_indices(index_count);
-                mcrt_vector<DirectX::XMFLOAT3> raw_positions(vertex_count);
-                mcrt_vector<DirectX::XMFLOAT3> raw_normals(vertex_count);
-                mcrt_vector<DirectX::XMFLOAT2> raw_texcoords(vertex_count);
-                mcrt_vector<DirectX::XMFLOAT4> raw_tangents(vertex_count);
-                {
-                    // TODO: support strip and fan
-                    assert(0U == (index_count % 3U));
-                    size_t const face_count = index_count / 3U;
-
-                    if (NULL != index_accessor)
-                    {
-                        uintptr_t index_base = -1;
-                        size_t index_stride = -1;
-                        {
-                            cgltf_buffer_view const *const index_buffer_view = index_accessor->buffer_view;
-                            index_base = reinterpret_cast<uintptr_t>(index_buffer_view->buffer->data) + index_buffer_view->offset + index_accessor->offset;
-                            index_stride = (0 != index_buffer_view->stride) ? index_buffer_view->stride : index_accessor->stride;
-                        }
-
-                        assert(cgltf_type_scalar == index_accessor->type);
-
-                        switch (index_accessor->component_type)
-                        {
-                        case cgltf_component_type_r_8u:
-                        {
-                            assert(cgltf_component_type_r_8u == index_accessor->component_type);
-
-                            for (size_t index_index = 0; index_index < index_accessor->count; ++index_index)
-                            {
-                                uint8_t const *const index_ubyte = reinterpret_cast<uint8_t const *>(index_base + index_stride * index_index);
-
-                                uint32_t const raw_index = static_cast<uint32_t>(*index_ubyte);
-
-                                raw_max_index = std::max(raw_max_index, raw_index);
-
-                                raw_indices[index_index] = raw_index;
-                            }
-                        }
-                        break;
-                        case cgltf_component_type_r_16u:
-                        {
-                            assert(cgltf_component_type_r_16u == index_accessor->component_type);
-
-                            for (size_t index_index = 0; index_index < index_accessor->count; ++index_index)
-                            {
-                                uint16_t const *const index_ushort = reinterpret_cast<uint16_t const *>(index_base + index_stride * index_index);
-
-                                uint32_t const raw_index = static_cast<uint32_t>(*index_ushort);
-
-                                raw_max_index = std::max(raw_max_index, raw_index);
-
-                                raw_indices[index_index] = raw_index;
-                            }
-                        }
-                        break;
-                        case cgltf_component_type_r_32u:
-                        {
-                            assert(cgltf_component_type_r_32u == index_accessor->component_type);
-
-                            for (size_t index_index = 0; index_index < index_accessor->count; ++index_index)
-                            {
-                                uint32_t const *const index_uint = reinterpret_cast<uint32_t const *>(index_base + index_stride * index_index);
-
-                                uint32_t const raw_index = (*index_uint);
-
-                                raw_max_index = std::max(raw_max_index, raw_index);
-
-                                raw_indices[index_index] = raw_index;
-                            }
-                        }
-                        break;
-                        default:
-                            assert(0);
-                        }
-                    }
-                    else
-                    {
-                        for (size_t index_index = 0; index_index < index_count; ++index_index)
-                        {
-                            uint32_t const raw_index = static_cast<uint32_t>(index_index);
-
-                            raw_max_index = std::max(raw_max_index, raw_index);
-
-                            raw_indices[index_index] = raw_index;
-                        }
-                    }
-
-                    assert(NULL != position_accessor);
-                    {
-                        uintptr_t position_base = -1;
-                        size_t position_stride = -1;
-                        {
-                            cgltf_buffer_view const *const position_buffer_view = position_accessor->buffer_view;
-                            position_base = reinterpret_cast<uintptr_t>(position_buffer_view->buffer->data) + position_buffer_view->offset + position_accessor->offset;
-                            position_stride = (0 != position_buffer_view->stride) ? position_buffer_view->stride : position_accessor->stride;
-                        }
-
-                        assert(cgltf_type_vec3 == position_accessor->type);
-                        assert(cgltf_component_type_r_32f == position_accessor->component_type);
-
-                        for (size_t vertex_index = 0; vertex_index < position_accessor->count; ++vertex_index)
-                        {
-                            float const *const position_float3 = reinterpret_cast<float const *>(position_base + position_stride * vertex_index);
-
-                            raw_positions[vertex_index] = DirectX::XMFLOAT3(position_float3[0], position_float3[1], position_float3[2]);
-                        }
-                    }
-
-                    if (NULL != normal_accessor)
-                    {
-                        uintptr_t normal_base = -1;
-                        size_t normal_stride = -1;
-                        {
-                            cgltf_buffer_view const *const normal_buffer_view = normal_accessor->buffer_view;
-                            normal_base = reinterpret_cast<uintptr_t>(normal_buffer_view->buffer->data) + normal_buffer_view->offset + normal_accessor->offset;
-                            normal_stride = (0 != normal_buffer_view->stride) ? normal_buffer_view->stride : normal_accessor->stride;
-                        }
-
-                        assert(normal_accessor->count == vertex_count);
-
-                        assert(cgltf_type_vec3 == normal_accessor->type);
-                        assert(cgltf_component_type_r_32f == normal_accessor->component_type);
-
-                        for (size_t vertex_index = 0; vertex_index < normal_accessor->count; ++vertex_index)
-                        {
-                            float const *const normal_float3 = reinterpret_cast<float const *>(normal_base + normal_stride * vertex_index);
-
-                            raw_normals[vertex_index] = DirectX::XMFLOAT3(normal_float3[0], normal_float3[1], normal_float3[2]);
-                        }
-                    }
-                    else
-                    {
-                        DirectX::ComputeNormals(raw_indices.data(), face_count, raw_positions.data(), vertex_count, DirectX::CNORM_DEFAULT, raw_normals.data());
-                    }
-
-                    if (NULL != texcoord_accessor)
-                    {
-                        uintptr_t texcoord_base = -1;
-                        size_t texcoord_stride = -1;
-                        {
-                            cgltf_buffer_view const *const texcoord_buffer_view = texcoord_accessor->buffer_view;
-                            texcoord_base = reinterpret_cast<uintptr_t>(texcoord_buffer_view->buffer->data) + texcoord_buffer_view->offset + texcoord_accessor->offset;
-                            texcoord_stride = (0 != texcoord_buffer_view->stride) ? texcoord_buffer_view->stride : texcoord_accessor->stride;
-                        }
-
-                        assert(texcoord_accessor->count == vertex_count);
-
-                        assert(cgltf_type_vec2 == texcoord_accessor->type);
-
-                        switch (texcoord_accessor->component_type)
-                        {
-                        case cgltf_component_type_r_8u:
-                        {
-                            assert(cgltf_component_type_r_8u == texcoord_accessor->component_type);
-
-                            for (size_t vertex_index = 0; vertex_index < texcoord_accessor->count; ++vertex_index)
-                            {
-                                uint8_t const *const texcoord_ubyte2 = reinterpret_cast<uint8_t const *>(texcoord_base + texcoord_stride * vertex_index);
-
-                                DirectX::PackedVector::XMUBYTEN2 packed_vector_ubyten2(texcoord_ubyte2[0], texcoord_ubyte2[1]);
-
-                                DirectX::XMVECTOR unpacked_vector = DirectX::PackedVector::XMLoadUByteN2(&packed_vector_ubyten2);
-
-                                DirectX::XMStoreFloat2(&raw_texcoords[vertex_index], unpacked_vector);
-                            }
-                        }
-                        break;
-                        case cgltf_component_type_r_16u:
-                        {
-                            assert(cgltf_component_type_r_16u == texcoord_accessor->component_type);
-
-                            for (size_t vertex_index = 0; vertex_index < texcoord_accessor->count; ++vertex_index)
-                            {
-                                uint16_t const *const texcoord_ushortn2 = reinterpret_cast<uint16_t const *>(texcoord_base + texcoord_stride * vertex_index);
-
-                                DirectX::PackedVector::XMUSHORTN2 packed_vector_ushortn2(texcoord_ushortn2[0], texcoord_ushortn2[1]);
-
-                                DirectX::XMVECTOR unpacked_vector = DirectX::PackedVector::XMLoadUShortN2(&packed_vector_ushortn2);
-
-                                DirectX::XMStoreFloat2(&raw_texcoords[vertex_index], unpacked_vector);
-                            }
-                        }
-                        break;
-                        case cgltf_component_type_r_32f:
-                        {
-                            assert(cgltf_component_type_r_32f == texcoord_accessor->component_type);
-
-                            for (size_t vertex_index = 0; vertex_index < texcoord_accessor->count; ++vertex_index)
-                            {
-                                float const *const texcoord_float2 = reinterpret_cast<float const *>(texcoord_base + texcoord_stride * vertex_index);
-
-                                raw_texcoords[vertex_index] = DirectX::XMFLOAT2(texcoord_float2[0], texcoord_float2[1]);
-                            }
-                        }
-                        break;
-                        default:
-                            assert(0);
-                        }
-                    }
-                    else
-                    {
-                        // TODO: uv may overlap since we merge different primitives based on the material
-                        assert(vertex_count <= static_cast<size_t>(UINT32_MAX));
-                        uint32_t sqrt_ceil_vertex_count = sqrt_ceil(static_cast<uint32_t>(vertex_count));
-
-                        for (size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
-                        {
-                            assert(vertex_index <= static_cast<size_t>(UINT32_MAX));
-
-                            uint32_t x;
-                            uint32_t y;
-                            decode_morton2(static_cast<uint32_t>(vertex_index), x, y);
-
-                            assert(x <= sqrt_ceil_vertex_count);
-                            assert(y <= sqrt_ceil_vertex_count);
-                            raw_texcoords[vertex_index] = DirectX::XMFLOAT2(static_cast<float>(x) / static_cast<float>(sqrt_ceil_vertex_count), static_cast<float>(y) / static_cast<float>(sqrt_ceil_vertex_count));
-                        }
-                    }
-
-                    if (NULL != tangent_accessor)
-                    {
-                        uintptr_t tangent_base = -1;
-                        size_t tangent_stride = -1;
-                        {
-                            cgltf_buffer_view const *const tangent_buffer_view = tangent_accessor->buffer_view;
-                            tangent_base = reinterpret_cast<uintptr_t>(tangent_buffer_view->buffer->data) + tangent_buffer_view->offset + tangent_accessor->offset;
-                            tangent_stride = (0 != tangent_buffer_view->stride) ? tangent_buffer_view->stride : tangent_accessor->stride;
-                        }
-
-                        assert(tangent_accessor->count == vertex_count);
-
-                        assert(cgltf_type_vec4 == tangent_accessor->type);
-                        assert(cgltf_component_type_r_32f == tangent_accessor->component_type);
-
-                        for (size_t vertex_index = 0; vertex_index < tangent_accessor->count; ++vertex_index)
-                        {
-                            float const *const tangent_float4 = reinterpret_cast<float const *>(tangent_base + tangent_stride * vertex_index);
-
-                            raw_tangents[vertex_index] = DirectX::XMFLOAT4(tangent_float4[0], tangent_float4[1], tangent_float4[2], tangent_float4[3]);
-                        }
-                    }
-                    else
-                    {
-                        DirectX::ComputeTangentFrame(raw_indices.data(), face_count, raw_positions.data(), raw_normals.data(), raw_texcoords.data(), vertex_count, raw_tangents.data());
-                    }
-                }
-
-                uint16_t raw_max_joint_index = 0U;
-                mcrt_vector<DirectX::PackedVector::XMUSHORT4> raw_joint_indices((NULL != joints_accessor && NULL != weights_accessor) ? vertex_count : static_cast<size_t>(0U));
-                mcrt_vector<DirectX::XMFLOAT4> raw_joint_weights((NULL != joints_accessor && NULL != weights_accessor) ? vertex_count : static_cast<size_t>(0U));
-                {
-                    if (NULL != joints_accessor && NULL != weights_accessor)
-                    {
-                        // Joint Indices
-                        {
-                            uintptr_t joints_base = -1;
-                            size_t joints_stride = -1;
-                            {
-                                cgltf_buffer_view const *const joint_indices_buffer_view = joints_accessor->buffer_view;
-                                joints_base = reinterpret_cast<uintptr_t>(joint_indices_buffer_view->buffer->data) + joint_indices_buffer_view->offset + joints_accessor->offset;
-                                joints_stride = (0 != joint_indices_buffer_view->stride) ? joint_indices_buffer_view->stride : joints_accessor->stride;
-                            }
-
-                            assert(joints_accessor->count == vertex_count);
-
-                            assert(cgltf_type_vec4 == joints_accessor->type);
-
-                            switch (joints_accessor->component_type)
-                            {
-                            case cgltf_component_type_r_8u:
-                            {
-                                assert(cgltf_component_type_r_8u == joints_accessor->component_type);
-
-                                for (size_t vertex_index = 0; vertex_index < joints_accessor->count; ++vertex_index)
-                                {
-                                    uint8_t const *const joint_indices_ubyte4 = reinterpret_cast<uint8_t const *>(joints_base + joints_stride * vertex_index);
-
-                                    uint16_t raw_joint_index_x = static_cast<uint16_t>(joint_indices_ubyte4[0]);
-                                    uint16_t raw_joint_index_y = static_cast<uint16_t>(joint_indices_ubyte4[1]);
-                                    uint16_t raw_joint_index_z = static_cast<uint16_t>(joint_indices_ubyte4[2]);
-                                    uint16_t raw_joint_index_w = static_cast<uint16_t>(joint_indices_ubyte4[3]);
-
-                                    raw_max_joint_index = std::max(raw_max_joint_index, raw_joint_index_x);
-                                    raw_max_joint_index = std::max(raw_max_joint_index, raw_joint_index_y);
-                                    raw_max_joint_index = std::max(raw_max_joint_index, raw_joint_index_z);
-                                    raw_max_joint_index = std::max(raw_max_joint_index, raw_joint_index_w);
-
-                                    raw_joint_indices[vertex_index] = DirectX::PackedVector::XMUSHORT4(raw_joint_index_x, raw_joint_index_y, raw_joint_index_z, raw_joint_index_w);
-                                }
-                            }
-                            break;
-                            case cgltf_component_type_r_16u:
-                            {
-                                assert(cgltf_component_type_r_16u == joints_accessor->component_type);
-
-                                for (size_t vertex_index = 0; vertex_index < joints_accessor->count; ++vertex_index)
-                                {
-                                    uint16_t const *const joint_indices_ushort4 = reinterpret_cast<uint16_t const *>(joints_base + joints_stride * vertex_index);
-
-                                    uint16_t raw_joint_index_x = joint_indices_ushort4[0];
-                                    uint16_t raw_joint_index_y = joint_indices_ushort4[1];
-                                    uint16_t raw_joint_index_z = joint_indices_ushort4[2];
-                                    uint16_t raw_joint_index_w = joint_indices_ushort4[3];
-
-                                    raw_max_joint_index = std::max(raw_max_joint_index, raw_joint_index_x);
-                                    raw_max_joint_index = std::max(raw_max_joint_index, raw_joint_index_y);
-                                    raw_max_joint_index = std::max(raw_max_joint_index, raw_joint_index_z);
-                                    raw_max_joint_index = std::max(raw_max_joint_index, raw_joint_index_w);
-
-                                    raw_joint_indices[vertex_index] = DirectX::PackedVector::XMUSHORT4(raw_joint_index_x, raw_joint_index_y, raw_joint_index_z, raw_joint_index_w);
-                                }
-                            }
-                            break;
-                            default:
-                                assert(0);
-                            }
-                        }
-
-                        // Joint Weights
-                        {
-                            uintptr_t weights_base = -1;
-                            size_t weights_stride = -1;
-                            {
-                                cgltf_buffer_view const *const joint_weights_buffer_view = weights_accessor->buffer_view;
-                                weights_base = reinterpret_cast<uintptr_t>(joint_weights_buffer_view->buffer->data) + joint_weights_buffer_view->offset + weights_accessor->offset;
-                                weights_stride = (0 != joint_weights_buffer_view->stride) ? joint_weights_buffer_view->stride : weights_accessor->stride;
-                            }
-
-                            assert(weights_accessor->count == vertex_count);
-
-                            assert(cgltf_type_vec4 == weights_accessor->type);
-
-                            switch (weights_accessor->component_type)
-                            {
-                            case cgltf_component_type_r_8u:
-                            {
-                                assert(cgltf_component_type_r_8u == weights_accessor->component_type);
-
-                                for (size_t vertex_index = 0; vertex_index < weights_accessor->count; ++vertex_index)
-                                {
-                                    uint8_t const *const joint_weights_ubyte4 = reinterpret_cast<uint8_t const *>(weights_base + weights_stride * vertex_index);
-
-                                    DirectX::PackedVector::XMUBYTEN4 packed_vector_ubyten4(joint_weights_ubyte4[0], joint_weights_ubyte4[1], joint_weights_ubyte4[2], joint_weights_ubyte4[3]);
-
-                                    DirectX::XMVECTOR unpacked_vector = DirectX::PackedVector::XMLoadUByteN4(&packed_vector_ubyten4);
-
-                                    DirectX::XMStoreFloat4(&raw_joint_weights[vertex_index], unpacked_vector);
-                                }
-                            }
-                            break;
-                            case cgltf_component_type_r_16u:
-                            {
-                                assert(cgltf_component_type_r_16u == weights_accessor->component_type);
-
-                                for (size_t vertex_index = 0; vertex_index < weights_accessor->count; ++vertex_index)
-                                {
-                                    uint16_t const *const joint_weights_ushortn4 = reinterpret_cast<uint16_t const *>(weights_base + weights_stride * vertex_index);
-
-                                    DirectX::PackedVector::XMUSHORTN4 packed_vector_ushortn4(joint_weights_ushortn4[0], joint_weights_ushortn4[1], joint_weights_ushortn4[2], joint_weights_ushortn4[3]);
-
-                                    DirectX::XMVECTOR unpacked_vector = DirectX::PackedVector::XMLoadUShortN4(&packed_vector_ushortn4);
-
-                                    DirectX::XMStoreFloat4(&raw_joint_weights[vertex_index], unpacked_vector);
-                                }
-                            }
-                            break;
-                            case cgltf_component_type_r_32f:
-                            {
-                                assert(cgltf_component_type_r_32f == weights_accessor->component_type);
-
-                                for (size_t vertex_index = 0; vertex_index < weights_accessor->count; ++vertex_index)
-                                {
-                                    float const *const joint_weights_float4 = reinterpret_cast<float const *>(weights_base + weights_stride * vertex_index);
-
-                                    raw_joint_weights[vertex_index] = DirectX::XMFLOAT4(joint_weights_float4[0], joint_weights_float4[1], joint_weights_float4[2], joint_weights_float4[3]);
-                                }
-                            }
-                            break;
-                            default:
-                                assert(0);
-                            }
-                        }
+                    break;
+                    default:
+                    {
+                        // Do Nothing
+                    }
                     }
                 }
+            }
 
+            if (NULL != position_accessor)
+            {
                 // We merge the primitives, of which the material is the same, within the same mesh
                 // TODO: shall we merge the primitives within different meshes (consider multiple instances)
-                scene_mesh_subset_data *out_subset_data;
-                uint32_t out_subset_vertex_index_offset;
-                uint32_t out_subset_index_index_offset;
+                size_t subset_data_index;
                 {
                     cgltf_material const *const primitive_material = primitive->material;
 
@@ -686,21 +488,16 @@ static void import_gltf_scene_mesh_asset(scene_mesh_data *out_mesh_data, int32_t
                     auto found = subset_material_indices.find(primitive_material_index);
                     if (subset_material_indices.end() != found)
                     {
-                        size_t const subset_data_index = found->second;
+                        subset_data_index = found->second;
                         assert(subset_data_index < out_mesh_data->m_subsets.size());
-                        out_subset_data = &out_mesh_data->m_subsets[subset_data_index];
-                        out_subset_vertex_index_offset = static_cast<uint32_t>(out_subset_data->m_vertex_position_binding.size());
-                        out_subset_index_index_offset = static_cast<uint32_t>(out_subset_data->m_indices.size());
                     }
                     else
                     {
-                        size_t const subset_data_index = out_mesh_data->m_subsets.size();
+                        subset_data_index = out_mesh_data->m_subsets.size();
                         out_mesh_data->m_subsets.push_back({});
                         subset_material_indices.emplace_hint(found, primitive_material_index, subset_data_index);
-                        out_subset_data = &out_mesh_data->m_subsets.back();
+                        scene_mesh_subset_data *const out_subset_data = &out_mesh_data->m_subsets.back();
                         out_subset_data->m_max_index = 0U;
-                        out_subset_vertex_index_offset = 0U;
-                        out_subset_index_index_offset = 0U;
 
                         if (NULL != primitive_material->normal_texture.texture)
                         {
@@ -792,104 +589,502 @@ static void import_gltf_scene_mesh_asset(scene_mesh_data *out_mesh_data, int32_t
                     }
                 }
 
-                // Indices
-                {
-                    // The vertex buffer for each primitive is independent
-                    // Index for each primitive is from zero
-                    out_subset_data->m_max_index = (out_subset_vertex_index_offset + raw_max_index);
+                // the primitive is decoded directly into the subset when the offsets within the subset have been assigned by the counting pass
+                out_primitive_data.push_back({});
+                import_gltf_scene_primitive_data &primitive_data = out_primitive_data.back();
+                primitive_data.m_mesh_index = mesh_index;
+                primitive_data.m_subset_index = subset_data_index;
+                primitive_data.m_index_accessor = primitive->indices;
+                primitive_data.m_position_accessor = position_accessor;
+                primitive_data.m_normal_accessor = normal_accessor;
+                primitive_data.m_tangent_accessor = tangent_accessor;
+                primitive_data.m_texcoord_accessor = texcoord_accessor;
+                primitive_data.m_joints_accessor = joints_accessor;
+                primitive_data.m_weights_accessor = weights_accessor;
+                primitive_data.m_vertex_count = position_accessor->count;
+                primitive_data.m_index_count = (NULL != primitive->indices) ? primitive->indices->count : position_accessor->count;
+                primitive_data.m_skinned = ((NULL != joints_accessor) && (NULL != weights_accessor));
+            }
+        }
+    }
+}
 
-                    assert(out_subset_index_index_offset == out_subset_data->m_indices.size());
-                    out_subset_data->m_indices.resize(out_subset_index_index_offset + index_count);
+static void import_gltf_scene_primitive_decode_task_function(uint32_t task_index, void *user_data)
+{
+    import_gltf_scene_primitive_task_context const *const context = static_cast<import_gltf_scene_primitive_task_context const *>(user_data);
+
+    import_gltf_scene_primitive_data *const primitive_data = &context->primitive_data[task_index];
+
+    cgltf_accessor const *const index_accessor = primitive_data->m_index_accessor;
+    cgltf_accessor const *const position_accessor = primitive_data->m_position_accessor;
+    cgltf_accessor const *const normal_accessor = primitive_data->m_normal_accessor;
+    cgltf_accessor const *const tangent_accessor = primitive_data->m_tangent_accessor;
+    cgltf_accessor const *const texcoord_accessor = primitive_data->m_texcoord_accessor;
+    cgltf_accessor const *const joints_accessor = primitive_data->m_joints_accessor;
+    cgltf_accessor const *const weights_accessor = primitive_data->m_weights_accessor;
+
+    size_t const vertex_count = primitive_data->m_vertex_count;
+    size_t const index_count = primitive_data->m_index_count;
+
+    // the subsets have been resized by the counting pass and the primitive is decoded directly into its own range of the subset
+    scene_mesh_subset_data *const out_subset_data = &context->out_total_mesh_data[primitive_data->m_mesh_index].m_subsets[primitive_data->m_subset_index];
+    uint32_t const out_subset_vertex_index_offset = primitive_data->m_out_subset_vertex_index_offset;
+    uint32_t const out_subset_index_index_offset = primitive_data->m_out_subset_index_index_offset;
+
+    assert((out_subset_index_index_offset + index_count) <= out_subset_data->m_indices.size());
+    assert((out_subset_vertex_index_offset + vertex_count) <= out_subset_data->m_vertex_position_binding.size());
+    assert((out_subset_vertex_index_offset + vertex_count) <= out_subset_data->m_vertex_varying_binding.size());
+    uint32_t *const out_indices = out_subset_data->m_indices.data() + out_subset_index_index_offset;
+    scene_mesh_vertex_position_binding *const out_vertex_position_binding = out_subset_data->m_vertex_position_binding.data() + out_subset_vertex_index_offset;
+    scene_mesh_vertex_varying_binding *const out_vertex_varying_binding = out_subset_data->m_vertex_varying_binding.data() + out_subset_vertex_index_offset;
+
+    // the indices are relative to the primitive until the varying binding has been generated
+    uint32_t raw_max_index = 0U;
+    {
+        // TODO: support strip and fan
+        assert(0U == (index_count % 3U));
 
-                    uint32_t *const out_indices = &out_subset_data->m_indices[out_subset_index_index_offset];
+        if (NULL != index_accessor)
+        {
+            if (!internal_import_gltf_accessor_read_uint(index_accessor, 1U, out_indices, sizeof(uint32_t)))
+            {
+                assert(0);
+            }
 
-                    for (size_t index_index = 0; index_index < index_count; ++index_index)
-                    {
-                        out_indices[index_index] = (out_subset_vertex_index_offset + raw_indices[index_index]);
-                    }
-                }
+            for (size_t index_index = 0; index_index < index_count; ++index_index)
+            {
+                raw_max_index = std::max(raw_max_index, out_indices[index_index]);
+            }
+        }
+        else
+        {
+            for (size_t index_index = 0; index_index < index_count; ++index_index)
+            {
+                uint32_t const raw_index = static_cast<uint32_t>(index_index);
 
-                // Vertex Position Binding
-                {
-                    assert(out_subset_vertex_index_offset == out_subset_data->m_vertex_position_binding.size());
-                    out_subset_data->m_vertex_position_binding.resize(out_subset_vertex_index_offset + vertex_count);
-                    scene_mesh_vertex_position_binding *const out_vertex_position_binding = &out_subset_data->m_vertex_position_binding[out_subset_vertex_index_offset];
+                raw_max_index = std::max(raw_max_index, raw_index);
 
-                    for (size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
-                    {
-                        out_vertex_position_binding[vertex_index].m_position = raw_positions[vertex_index];
-                    }
-                }
+                out_indices[index_index] = raw_index;
+            }
+        }
+    }
 
-                // Vertex Varying Binding
-                {
-                    assert(out_subset_vertex_index_offset == out_subset_data->m_vertex_varying_binding.size());
-                    out_subset_data->m_vertex_varying_binding.resize(out_subset_vertex_index_offset + vertex_count);
-                    scene_mesh_vertex_varying_binding *const out_vertex_varying_binding = &out_subset_data->m_vertex_varying_binding[out_subset_vertex_index_offset];
+    // Vertex Position Binding
+    {
+        // KHR_mesh_quantization: the quantized (and not necessarily normalized) positions are dequantized by the node transform
+        assert(NULL != position_accessor);
+        {
+            if (!internal_import_gltf_accessor_read_float(position_accessor, 3U, false, &out_vertex_position_binding[0].m_position.x, sizeof(scene_mesh_vertex_position_binding)))
+            {
+                assert(0);
+            }
+        }
+    }
 
-                    for (size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
-                    {
-                        DirectX::XMFLOAT2 const mapped_normal = octahedron_map(raw_normals[vertex_index]);
+    // Vertex Varying Binding
+    if ((NULL != normal_accessor) && (NULL != tangent_accessor) && (NULL != texcoord_accessor) && (!normal_accessor->is_sparse) && (!tangent_accessor->is_sparse) && (!texcoord_accessor->is_sparse))
+    {
+        assert(normal_accessor->count == vertex_count);
+        assert(tangent_accessor->count == vertex_count);
+        assert(texcoord_accessor->count == vertex_count);
+
+        // the unsigned byte and the unsigned short texcoords are always normalized in the glTF 2.0 core
+        bool const texcoord_always_normalized = (cgltf_component_type_r_8u == texcoord_accessor->component_type) || (cgltf_component_type_r_16u == texcoord_accessor->component_type);
 
-                        DirectX::PackedVector::XMSHORTN2 packed_normal;
-                        DirectX::PackedVector::XMStoreShortN2(&packed_normal, DirectX::XMLoadFloat2(&mapped_normal));
+        // the attributes are decoded block by block into the stack buffers (which stay in the cache) and packed immediately such that the float attributes of the whole primitive are never materialized
+        for (size_t block_vertex_index = 0U; block_vertex_index < vertex_count; block_vertex_index += k_vertex_varying_binding_block_size)
+        {
+            size_t const block_vertex_count = std::min(k_vertex_varying_binding_block_size, vertex_count - block_vertex_index);
 
-                        out_vertex_varying_binding[vertex_index].m_normal = packed_normal.v;
+            DirectX::XMFLOAT3 block_normals[k_vertex_varying_binding_block_size];
+            DirectX::XMFLOAT4 block_tangents[k_vertex_varying_binding_block_size];
+            DirectX::XMFLOAT2 block_texcoords[k_vertex_varying_binding_block_size];
 
-                        DirectX::XMFLOAT3 tangent_xyz(raw_tangents[vertex_index].x, raw_tangents[vertex_index].y, raw_tangents[vertex_index].z);
-                        float tangent_w = raw_tangents[vertex_index].w;
+            if (!internal_import_gltf_accessor_read_float_range(normal_accessor, block_vertex_index, block_vertex_count, 3U, false, &block_normals[0].x, sizeof(DirectX::XMFLOAT3)))
+            {
+                assert(0);
+            }
 
-                        out_vertex_varying_binding[vertex_index].m_tangent = FLOAT3_to_R15G15B2_SNORM(octahedron_map(tangent_xyz), tangent_w);
+            if (!internal_import_gltf_accessor_read_float_range(tangent_accessor, block_vertex_index, block_vertex_count, 4U, false, &block_tangents[0].x, sizeof(DirectX::XMFLOAT4)))
+            {
+                assert(0);
+            }
 
-                        DirectX::PackedVector::XMUSHORTN2 packed_texcoord;
-                        DirectX::PackedVector::XMStoreUShortN2(&packed_texcoord, DirectX::XMLoadFloat2(&raw_texcoords[vertex_index]));
+            if (!internal_import_gltf_accessor_read_float_range(texcoord_accessor, block_vertex_index, block_vertex_count, 2U, texcoord_always_normalized, &block_texcoords[0].x, sizeof(DirectX::XMFLOAT2)))
+            {
+                assert(0);
+            }
 
-                        out_vertex_varying_binding[vertex_index].m_texcoord = packed_texcoord.v;
-                    }
-                }
+            import_gltf_scene_pack_vertex_varying_bindings(block_normals, block_tangents, block_texcoords, block_vertex_count, out_vertex_varying_binding + block_vertex_index);
+        }
+    }
+    else
+    {
+        // the generated attributes depend on the whole primitive
+        size_t const face_count = index_count / 3U;
 
-                // Vertex Joint Binding
-                if ((!raw_joint_indices.empty()) && (!raw_joint_weights.empty()))
-                {
-                    (*out_max_joint_index) = std::max((*out_max_joint_index), static_cast<int32_t>(raw_max_joint_index));
+        // the positions are only required by the generated normals and tangents
+        bool const generate_normals_or_tangents = (NULL == normal_accessor) || (NULL == tangent_accessor);
 
-                    assert(out_subset_vertex_index_offset == out_subset_data->m_vertex_joint_binding.size());
-                    out_subset_data->m_vertex_joint_binding.resize(out_subset_vertex_index_offset + vertex_count);
-                    scene_mesh_vertex_joint_binding *const out_vertex_joint_binding = &out_subset_data->m_vertex_joint_binding[out_subset_vertex_index_offset];
+        size_t const raw_positions_size = generate_normals_or_tangents ? import_gltf_scene_decode_arena_aligned_size(sizeof(DirectX::XMFLOAT3) * vertex_count) : static_cast<size_t>(0U);
+        size_t const raw_normals_size = import_gltf_scene_decode_arena_aligned_size(sizeof(DirectX::XMFLOAT3) * vertex_count);
+        size_t const raw_texcoords_size = import_gltf_scene_decode_arena_aligned_size(sizeof(DirectX::XMFLOAT2) * vertex_count);
+        size_t const raw_tangents_size = import_gltf_scene_decode_arena_aligned_size(sizeof(DirectX::XMFLOAT4) * vertex_count);
 
-                    for (size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
-                    {
-                        (*reinterpret_cast<uint64_t *>(&out_vertex_joint_binding[vertex_index].m_indices_xy)) = raw_joint_indices[vertex_index].v;
+        import_gltf_scene_decode_arena *const arena = import_gltf_scene_decode_arena_acquire(context->arena_pool);
+        import_gltf_scene_decode_arena_reset(arena, raw_positions_size + raw_normals_size + raw_texcoords_size + raw_tangents_size);
 
-                        DirectX::PackedVector::XMUBYTEN4 packed_weights;
-                        DirectX::PackedVector::XMStoreUByteN4(&packed_weights, DirectX::XMLoadFloat4(&raw_joint_weights[vertex_index]));
+        DirectX::XMFLOAT3 *const raw_positions = static_cast<DirectX::XMFLOAT3 *>(import_gltf_scene_decode_arena_allocate(arena, raw_positions_size));
+        DirectX::XMFLOAT3 *const raw_normals = static_cast<DirectX::XMFLOAT3 *>(import_gltf_scene_decode_arena_allocate(arena, raw_normals_size));
+        DirectX::XMFLOAT2 *const raw_texcoords = static_cast<DirectX::XMFLOAT2 *>(import_gltf_scene_decode_arena_allocate(arena, raw_texcoords_size));
+        DirectX::XMFLOAT4 *const raw_tangents = static_cast<DirectX::XMFLOAT4 *>(import_gltf_scene_decode_arena_allocate(arena, raw_tangents_size));
 
-                        out_vertex_joint_binding[vertex_index].m_weights = packed_weights.v;
-                    }
+        if (generate_normals_or_tangents)
+        {
+            for (size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+            {
+                raw_positions[vertex_index] = out_vertex_position_binding[vertex_index].m_position;
+            }
+        }
+
+        if (NULL != normal_accessor)
+        {
+            assert(normal_accessor->count == vertex_count);
+
+            if (!internal_import_gltf_accessor_read_float(normal_accessor, 3U, false, &raw_normals[0].x, sizeof(DirectX::XMFLOAT3)))
+            {
+                assert(0);
+            }
+        }
+        else
+        {
+            DirectX::ComputeNormals(out_indices, face_count, raw_positions, vertex_count, DirectX::CNORM_DEFAULT, raw_normals);
+        }
+
+        if (NULL != texcoord_accessor)
+        {
+            assert(texcoord_accessor->count == vertex_count);
+
+            // the unsigned byte and the unsigned short texcoords are always normalized in the glTF 2.0 core
+            if (!internal_import_gltf_accessor_read_float(texcoord_accessor, 2U, (cgltf_component_type_r_8u == texcoord_accessor->component_type) || (cgltf_component_type_r_16u == texcoord_accessor->component_type), &raw_texcoords[0].x, sizeof(DirectX::XMFLOAT2)))
+            {
+                assert(0);
+            }
+        }
+        else
+        {
+            // TODO: uv may overlap since we merge different primitives based on the material
+            assert(vertex_count <= static_cast<size_t>(UINT32_MAX));
+            uint32_t sqrt_ceil_vertex_count = sqrt_ceil(static_cast<uint32_t>(vertex_count));
+
+            for (size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+            {
+                assert(vertex_index <= static_cast<size_t>(UINT32_MAX));
+
+                uint32_t x;
+                uint32_t y;
+                decode_morton2(static_cast<uint32_t>(vertex_index), x, y);
+
+                assert(x <= sqrt_ceil_vertex_count);
+                assert(y <= sqrt_ceil_vertex_count);
+                raw_texcoords[vertex_index] = DirectX::XMFLOAT2(static_cast<float>(x) / static_cast<float>(sqrt_ceil_vertex_count), static_cast<float>(y) / static_cast<float>(sqrt_ceil_vertex_count));
+            }
+        }
+
+        if (NULL != tangent_accessor)
+        {
+            assert(tangent_accessor->count == vertex_count);
+
+            if (!internal_import_gltf_accessor_read_float(tangent_accessor, 4U, false, &raw_tangents[0].x, sizeof(DirectX::XMFLOAT4)))
+            {
+                assert(0);
+            }
+        }
+        else
+        {
+            DirectX::ComputeTangentFrame(out_indices, face_count, raw_positions, raw_normals, raw_texcoords, vertex_count, raw_tangents);
+        }
+
+        import_gltf_scene_pack_vertex_varying_bindings(raw_normals, raw_tangents, raw_texcoords, vertex_count, out_vertex_varying_binding);
+
+        import_gltf_scene_decode_arena_release(context->arena_pool, arena);
+    }
+
+    // The vertex buffer for each primitive is independent
+    // Index for each primitive is from zero
+    if (0U != out_subset_vertex_index_offset)
+    {
+        for (size_t index_index = 0; index_index < index_count; ++index_index)
+        {
+            out_indices[index_index] += out_subset_vertex_index_offset;
+        }
+    }
+
+    // Vertex Joint Binding
+    uint16_t raw_max_joint_index = 0U;
+    if (primitive_data->m_skinned)
+    {
+        assert((out_subset_vertex_index_offset + vertex_count) <= out_subset_data->m_vertex_joint_binding.size());
+        scene_mesh_vertex_joint_binding *const out_vertex_joint_binding = out_subset_data->m_vertex_joint_binding.data() + out_subset_vertex_index_offset;
+
+        // Joint Indices
+        {
+            assert(joints_accessor->count == vertex_count);
+
+            // the four unsigned short joint indices are read directly into the "m_indices_xy" and the "m_indices_wz"
+            if (!internal_import_gltf_accessor_read_ushort(joints_accessor, 4U, reinterpret_cast<uint16_t *>(&out_vertex_joint_binding[0].m_indices_xy), sizeof(scene_mesh_vertex_joint_binding)))
+            {
+                assert(0);
+            }
+
+            for (size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+            {
+                uint16_t const *const raw_joint_indices = reinterpret_cast<uint16_t const *>(&out_vertex_joint_binding[vertex_index].m_indices_xy);
+
+                raw_max_joint_index = std::max(raw_max_joint_index, raw_joint_indices[0]);
+                raw_max_joint_index = std::max(raw_max_joint_index, raw_joint_indices[1]);
+                raw_max_joint_index = std::max(raw_max_joint_index, raw_joint_indices[2]);
+                raw_max_joint_index = std::max(raw_max_joint_index, raw_joint_indices[3]);
+            }
+        }
+
+        // Joint Weights
+        {
+            assert(weights_accessor->count == vertex_count);
+
+            for (size_t block_vertex_index = 0U; block_vertex_index < vertex_count; block_vertex_index += k_vertex_joint_binding_block_size)
+            {
+                size_t const block_vertex_count = std::min(k_vertex_joint_binding_block_size, vertex_count - block_vertex_index);
+
+                DirectX::XMFLOAT4 block_joint_weights[k_vertex_joint_binding_block_size];
+
+                // the unsigned byte and the unsigned short joint weights are always normalized in the glTF 2.0 core
+                if (!internal_import_gltf_accessor_read_float_range(weights_accessor, block_vertex_index, block_vertex_count, 4U, true, &block_joint_weights[0].x, sizeof(DirectX::XMFLOAT4)))
+                {
+                    assert(0);
                 }
-                else
+
+                for (size_t vertex_index = 0; vertex_index < block_vertex_count; ++vertex_index)
                 {
-                    assert(out_subset_data->m_vertex_joint_binding.empty());
+                    DirectX::PackedVector::XMUBYTEN4 packed_weights;
+                    DirectX::PackedVector::XMStoreUByteN4(&packed_weights, DirectX::XMLoadFloat4(&block_joint_weights[vertex_index]));
+
+                    out_vertex_joint_binding[block_vertex_index + vertex_index].m_weights = packed_weights.v;
                 }
             }
         }
     }
 
-    if ((*out_max_joint_index) < 0)
+    primitive_data->m_raw_max_index = raw_max_index;
+    primitive_data->m_raw_max_joint_index = raw_max_joint_index;
+}
+
+static void import_gltf_scene_mesh_subset_offsets(scene_mesh_data &out_mesh_data, import_gltf_scene_primitive_data *primitive_data, size_t primitive_count)
+{
+    size_t const subset_count = out_mesh_data.m_subsets.size();
+
+    mcrt_vector<uint32_t> subset_vertex_counts(subset_count, 0U);
+    mcrt_vector<uint32_t> subset_index_counts(subset_count, 0U);
+    mcrt_vector<uint32_t> subset_joint_vertex_counts(subset_count, 0U);
+
+    // the primitives are visited in the same order as they are in the glTF file such that the merged subsets are deterministic regardless of the order in which the decode tasks are completed
+    for (size_t primitive_data_index = 0; primitive_data_index < primitive_count; ++primitive_data_index)
+    {
+        import_gltf_scene_primitive_data &primitive = primitive_data[primitive_data_index];
+
+        size_t const subset_data_index = primitive.m_subset_index;
+        assert(subset_data_index < subset_count);
+
+        primitive.m_out_subset_vertex_index_offset = subset_vertex_counts[subset_data_index];
+        primitive.m_out_subset_index_index_offset = subset_index_counts[subset_data_index];
+
+        assert((static_cast<size_t>(subset_vertex_counts[subset_data_index]) + primitive.m_vertex_count) <= static_cast<size_t>(UINT32_MAX));
+        assert((static_cast<size_t>(subset_index_counts[subset_data_index]) + primitive.m_index_count) <= static_cast<size_t>(UINT32_MAX));
+        subset_vertex_counts[subset_data_index] += static_cast<uint32_t>(primitive.m_vertex_count);
+        subset_index_counts[subset_data_index] += static_cast<uint32_t>(primitive.m_index_count);
+
+        if (primitive.m_skinned)
+        {
+            subset_joint_vertex_counts[subset_data_index] += static_cast<uint32_t>(primitive.m_vertex_count);
+        }
+    }
+
+    for (size_t subset_data_index = 0; subset_data_index < subset_count; ++subset_data_index)
+    {
+        scene_mesh_subset_data &out_subset_data = out_mesh_data.m_subsets[subset_data_index];
+
+        out_subset_data.m_indices.resize(subset_index_counts[subset_data_index]);
+        out_subset_data.m_vertex_position_binding.resize(subset_vertex_counts[subset_data_index]);
+        out_subset_data.m_vertex_varying_binding.resize(subset_vertex_counts[subset_data_index]);
+
+        // either all or none of the primitives merged into the same subset are skinned
+        assert((0U == subset_joint_vertex_counts[subset_data_index]) || (subset_vertex_counts[subset_data_index] == subset_joint_vertex_counts[subset_data_index]));
+        out_subset_data.m_vertex_joint_binding.resize(subset_joint_vertex_counts[subset_data_index]);
+    }
+}
+
+static void import_gltf_scene_mesh_subset_max_indices(scene_mesh_data &out_mesh_data, int32_t *out_max_joint_index, import_gltf_scene_primitive_data const *primitive_data, size_t primitive_count)
+{
+    int32_t max_joint_index = -1;
+
+    for (size_t primitive_data_index = 0; primitive_data_index < primitive_count; ++primitive_data_index)
+    {
+        import_gltf_scene_primitive_data const &primitive = primitive_data[primitive_data_index];
+
+        // the last primitive merged into the subset has the greatest offset
+        out_mesh_data.m_subsets[primitive.m_subset_index].m_max_index = (primitive.m_out_subset_vertex_index_offset + primitive.m_raw_max_index);
+
+        if (primitive.m_skinned)
+        {
+            max_joint_index = std::max(max_joint_index, static_cast<int32_t>(primitive.m_raw_max_joint_index));
+        }
+    }
+
+    if (max_joint_index < 0)
     {
-        out_mesh_data->m_skinned = false;
+        out_mesh_data.m_skinned = false;
 
-        for (scene_mesh_subset_data &out_subset_data : out_mesh_data->m_subsets)
+        for (scene_mesh_subset_data &out_subset_data : out_mesh_data.m_subsets)
         {
             assert(out_subset_data.m_vertex_joint_binding.empty());
         }
     }
     else
     {
-        out_mesh_data->m_skinned = true;
+        out_mesh_data.m_skinned = true;
+    }
+
+    (*out_max_joint_index) = max_joint_index;
+}
+
+static void import_gltf_scene_pack_vertex_varying_bindings(DirectX::XMFLOAT3 const *normals, DirectX::XMFLOAT4 const *tangents, DirectX::XMFLOAT2 const *texcoords, size_t vertex_count, scene_mesh_vertex_varying_binding *out_vertex_varying_bindings)
+{
+    static_assert(4U == k_vertex_varying_binding_pack_width, "");
+
+    size_t vertex_index = 0;
+
+    // SoA kernel: the attributes of 4 vertices are transposed such that each XMVECTOR holds one component of 4 vertices
+    for (; (vertex_index + k_vertex_varying_binding_pack_width) <= vertex_count; vertex_index += k_vertex_varying_binding_pack_width)
+    {
+        // Normal
+        {
+            DirectX::XMMATRIX const normals_soa = DirectX::XMMatrixTranspose(DirectX::XMMATRIX(DirectX::XMLoadFloat3(&normals[vertex_index]), DirectX::XMLoadFloat3(&normals[vertex_index + 1U]), DirectX::XMLoadFloat3(&normals[vertex_index + 2U]), DirectX::XMLoadFloat3(&normals[vertex_index + 3U])));
+
+            DirectX::XMVECTOR mapped_normals_u;
+            DirectX::XMVECTOR mapped_normals_v;
+            import_gltf_scene_octahedron_map_soa(normals_soa.r[0], normals_soa.r[1], normals_soa.r[2], &mapped_normals_u, &mapped_normals_v);
+
+#ifndef NDEBUG
+            {
+                DirectX::XMFLOAT4 debug_mapped_normals_u;
+                DirectX::XMFLOAT4 debug_mapped_normals_v;
+                DirectX::XMStoreFloat4(&debug_mapped_normals_u, mapped_normals_u);
+                DirectX::XMStoreFloat4(&debug_mapped_normals_v, mapped_normals_v);
+
+                float const *const debug_us = &debug_mapped_normals_u.x;
+                float const *const debug_vs = &debug_mapped_normals_v.x;
+                for (size_t lane_index = 0U; lane_index < k_vertex_varying_binding_pack_width; ++lane_index)
+                {
+                    // the SoA kernel should agree with the octahedron map of the shared shader code (up to the rounding error)
+                    DirectX::XMFLOAT2 const mapped_normal = octahedron_map(normals[vertex_index + lane_index]);
+                    assert(!(std::abs(mapped_normal.x - debug_us[lane_index]) > 1E-5F));
+                    assert(!(std::abs(mapped_normal.y - debug_vs[lane_index]) > 1E-5F));
+                }
+            }
+#endif
+
+            // the (u, v) pairs of 2 vertices are interleaved and quantized by one "XMStoreShortN4" (the same rounding as the "XMStoreShortN2")
+            DirectX::PackedVector::XMSHORTN4 packed_normals[2];
+            DirectX::PackedVector::XMStoreShortN4(&packed_normals[0], DirectX::XMVectorMergeXY(mapped_normals_u, mapped_normals_v));
+            DirectX::PackedVector::XMStoreShortN4(&packed_normals[1], DirectX::XMVectorMergeZW(mapped_normals_u, mapped_normals_v));
+
+            out_vertex_varying_bindings[vertex_index].m_normal = static_cast<uint32_t>(packed_normals[0].v);
+            out_vertex_varying_bindings[vertex_index + 1U].m_normal = static_cast<uint32_t>(packed_normals[0].v >> 32U);
+            out_vertex_varying_bindings[vertex_index + 2U].m_normal = static_cast<uint32_t>(packed_normals[1].v);
+            out_vertex_varying_bindings[vertex_index + 3U].m_normal = static_cast<uint32_t>(packed_normals[1].v >> 32U);
+        }
+
+        // Tangent
+        {
+            DirectX::XMMATRIX const tangents_soa = DirectX::XMMatrixTranspose(DirectX::XMMATRIX(DirectX::XMLoadFloat4(&tangents[vertex_index]), DirectX::XMLoadFloat4(&tangents[vertex_index + 1U]), DirectX::XMLoadFloat4(&tangents[vertex_index + 2U]), DirectX::XMLoadFloat4(&tangents[vertex_index + 3U])));
+
+            DirectX::XMVECTOR mapped_tangents_u;
+            DirectX::XMVECTOR mapped_tangents_v;
+            import_gltf_scene_octahedron_map_soa(tangents_soa.r[0], tangents_soa.r[1], tangents_soa.r[2], &mapped_tangents_u, &mapped_tangents_v);
+
+            DirectX::XMFLOAT4 mapped_tangent_us;
+            DirectX::XMFLOAT4 mapped_tangent_vs;
+            DirectX::XMFLOAT4 tangent_ws;
+            DirectX::XMStoreFloat4(&mapped_tangent_us, mapped_tangents_u);
+            DirectX::XMStoreFloat4(&mapped_tangent_vs, mapped_tangents_v);
+            DirectX::XMStoreFloat4(&tangent_ws, tangents_soa.r[3]);
+
+            // the R15G15B2_SNORM layout is defined by the shared shader code (which the GPU decodes) and thus is packed per vertex
+            out_vertex_varying_bindings[vertex_index].m_tangent = FLOAT3_to_R15G15B2_SNORM(DirectX::XMFLOAT2(mapped_tangent_us.x, mapped_tangent_vs.x), tangent_ws.x);
+            out_vertex_varying_bindings[vertex_index + 1U].m_tangent = FLOAT3_to_R15G15B2_SNORM(DirectX::XMFLOAT2(mapped_tangent_us.y, mapped_tangent_vs.y), tangent_ws.y);
+            out_vertex_varying_bindings[vertex_index + 2U].m_tangent = FLOAT3_to_R15G15B2_SNORM(DirectX::XMFLOAT2(mapped_tangent_us.z, mapped_tangent_vs.z), tangent_ws.z);
+            out_vertex_varying_bindings[vertex_index + 3U].m_tangent = FLOAT3_to_R15G15B2_SNORM(DirectX::XMFLOAT2(mapped_tangent_us.w, mapped_tangent_vs.w), tangent_ws.w);
+        }
+
+        // Texcoord
+        {
+            // the texcoords are already interleaved (u, v) pairs and 2 vertices are quantized by one "XMStoreUShortN4" (the same rounding as the "XMStoreUShortN2")
+            DirectX::PackedVector::XMUSHORTN4 packed_texcoords[2];
+            DirectX::PackedVector::XMStoreUShortN4(&packed_texcoords[0], DirectX::XMVectorPermute<DirectX::XM_PERMUTE_0X, DirectX::XM_PERMUTE_0Y, DirectX::XM_PERMUTE_1X, DirectX::XM_PERMUTE_1Y>(DirectX::XMLoadFloat2(&texcoords[vertex_index]), DirectX::XMLoadFloat2(&texcoords[vertex_index + 1U])));
+            DirectX::PackedVector::XMStoreUShortN4(&packed_texcoords[1], DirectX::XMVectorPermute<DirectX::XM_PERMUTE_0X, DirectX::XM_PERMUTE_0Y, DirectX::XM_PERMUTE_1X, DirectX::XM_PERMUTE_1Y>(DirectX::XMLoadFloat2(&texcoords[vertex_index + 2U]), DirectX::XMLoadFloat2(&texcoords[vertex_index + 3U])));
+
+            out_vertex_varying_bindings[vertex_index].m_texcoord = static_cast<uint32_t>(packed_texcoords[0].v);
+            out_vertex_varying_bindings[vertex_index + 1U].m_texcoord = static_cast<uint32_t>(packed_texcoords[0].v >> 32U);
+            out_vertex_varying_bindings[vertex_index + 2U].m_texcoord = static_cast<uint32_t>(packed_texcoords[1].v);
+            out_vertex_varying_bindings[vertex_index + 3U].m_texcoord = static_cast<uint32_t>(packed_texcoords[1].v >> 32U);
+        }
+    }
+
+    // the remaining vertices (less than the pack width)
+    for (; vertex_index < vertex_count; ++vertex_index)
+    {
+        DirectX::XMFLOAT2 const mapped_normal = octahedron_map(normals[vertex_index]);
+
+        DirectX::PackedVector::XMSHORTN2 packed_normal;
+        DirectX::PackedVector::XMStoreShortN2(&packed_normal, DirectX::XMLoadFloat2(&mapped_normal));
+
+        out_vertex_varying_bindings[vertex_index].m_normal = packed_normal.v;
+
+        DirectX::XMFLOAT3 tangent_xyz(tangents[vertex_index].x, tangents[vertex_index].y, tangents[vertex_index].z);
+        float tangent_w = tangents[vertex_index].w;
+
+        out_vertex_varying_bindings[vertex_index].m_tangent = FLOAT3_to_R15G15B2_SNORM(octahedron_map(tangent_xyz), tangent_w);
+
+        DirectX::PackedVector::XMUSHORTN2 packed_texcoord;
+        DirectX::PackedVector::XMStoreUShortN2(&packed_texcoord, DirectX::XMLoadFloat2(&texcoords[vertex_index]));
+
+        out_vertex_varying_bindings[vertex_index].m_texcoord = packed_texcoord.v;
     }
 }
 
+static inline void import_gltf_scene_octahedron_map_soa(DirectX::FXMVECTOR x, DirectX::FXMVECTOR y, DirectX::FXMVECTOR z, DirectX::XMVECTOR *out_u, DirectX::XMVECTOR *out_v)
+{
+    // [Cigolle 2014] Zina Cigolle, Sam Donow, Daniel Evangelakos, Michael Mara, Morgan McGuire, Quirin Meyer. "A Survey of Efficient Representations for Independent Unit Vectors." JCGT 2014.
+    // the same mapping as the "octahedron_map" of the shared shader code but 4 vectors at a time
+    DirectX::XMVECTOR const zero = DirectX::XMVectorZero();
+    DirectX::XMVECTOR const one = DirectX::XMVectorSplatOne();
+
+    DirectX::XMVECTOR const l1_norm = DirectX::XMVectorAdd(DirectX::XMVectorAdd(DirectX::XMVectorAbs(x), DirectX::XMVectorAbs(y)), DirectX::XMVectorAbs(z));
+
+    DirectX::XMVECTOR const octahedron_x = DirectX::XMVectorDivide(x, l1_norm);
+    DirectX::XMVECTOR const octahedron_y = DirectX::XMVectorDivide(y, l1_norm);
+
+    // the lower hemisphere is folded onto the corners of the square: (1 - |y|, 1 - |x|) * sign_not_zero(x, y)
+    DirectX::XMVECTOR const sign_not_zero_x = DirectX::XMVectorSelect(DirectX::XMVectorNegate(one), one, DirectX::XMVectorGreaterOrEqual(octahedron_x, zero));
+    DirectX::XMVECTOR const sign_not_zero_y = DirectX::XMVectorSelect(DirectX::XMVectorNegate(one), one, DirectX::XMVectorGreaterOrEqual(octahedron_y, zero));
+    DirectX::XMVECTOR const folded_x = DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(one, DirectX::XMVectorAbs(octahedron_y)), sign_not_zero_x);
+    DirectX::XMVECTOR const folded_y = DirectX::XMVectorMultiply(DirectX::XMVectorSubtract(one, DirectX::XMVectorAbs(octahedron_x)), sign_not_zero_y);
+
+    DirectX::XMVECTOR const upper_hemisphere = DirectX::XMVectorGreaterOrEqual(z, zero);
+    (*out_u) = DirectX::XMVectorSelect(folded_x, octahedron_x, upper_hemisphere);
+    (*out_v) = DirectX::XMVectorSelect(folded_y, octahedron_y, upper_hemisphere);
+}
+
 static void import_gltf_scene_mesh_instance_asset(mcrt_vector<cgltf_node const *> &out_mesh_instance_nodes, mcrt_vector<DirectX::XMFLOAT4X4> &out_mesh_instance_node_world_transforms, cgltf_data const *data, cgltf_mesh const *mesh)
 {
     mcrt_vector<DirectX::XMFLOAT4X4> node_local_transforms(static_cast<size_t>(data->nodes_count));
@@ -1362,7 +1557,9 @@ static cgltf_result cgltf_custom_read_file(const struct cgltf_memory_options *me
     void (*const memory_free)(void *, void *) = memory_options->free_func;
     assert(NULL != memory_free);
 
-    import_asset_input_stream_factory *const input_stream_factory = static_cast<import_asset_input_stream_factory *>(file_options->user_data);
+    cgltf_custom_file_context *const file_context = static_cast<cgltf_custom_file_context *>(file_options->user_data);
+
+    import_asset_input_stream_factory *const input_stream_factory = file_context->m_input_stream_factory;
 
     import_asset_input_stream *file;
     if (NULL == (file = input_stream_factory->create_instance(path)))
@@ -1383,6 +1580,26 @@ static cgltf_result cgltf_custom_read_file(const struct cgltf_memory_options *me
         file_size = length;
     }
 
+    // point cgltf straight at the mapping when the input stream supports "map_range"
+    // NOTE: cgltf never writes to the file data
+    void const *mapped_file_data;
+    if ((file_size > 0) && (0 == file->map_range(0, file_size, &mapped_file_data)))
+    {
+        // each duplicate is tracked by its own input stream which is destroyed by the matching release
+        file_context->m_mapped_input_streams[mapped_file_data].push_back(file);
+
+        if (NULL != size)
+        {
+            *size = file_size;
+        }
+        if (NULL != data)
+        {
+            *data = const_cast<void *>(mapped_file_data);
+        }
+
+        return cgltf_result_success;
+    }
+
     void *file_data = memory_alloc(memory_options->user_data, file_size);
     if (NULL == file_data)
     {
@@ -1412,8 +1629,24 @@ static cgltf_result cgltf_custom_read_file(const struct cgltf_memory_options *me
     return cgltf_result_success;
 }
 
-static void cgltf_custom_file_release(const struct cgltf_memory_options *memory_options, const struct cgltf_file_options *, void *data)
+static void cgltf_custom_file_release(const struct cgltf_memory_options *memory_options, const struct cgltf_file_options *file_options, void *data)
 {
+    cgltf_custom_file_context *const file_context = static_cast<cgltf_custom_file_context *>(file_options->user_data);
+
+    auto found = file_context->m_mapped_input_streams.find(data);
+    if (file_context->m_mapped_input_streams.end() != found)
+    {
+        assert(!found->second.empty());
+        file_context->m_input_stream_factory->destory_instance(found->second.back());
+        found->second.pop_back();
+
+        if (found->second.empty())
+        {
+            file_context->m_mapped_input_streams.erase(found);
+        }
+        return;
+    }
+
     void (*const memory_free)(void *, void *) = memory_options->free_func;
     assert(NULL != memory_free);
 
@@ -1432,6 +1665,87 @@ static void cgltf_custom_free(void *, void *ptr)
     mcrt_free(ptr);
 }
 
+static inline import_gltf_scene_decode_arena *import_gltf_scene_decode_arena_acquire(import_gltf_scene_decode_arena_pool *arena_pool)
+{
+    {
+        std::lock_guard<std::mutex> lock_guard(arena_pool->m_mutex);
+
+        if (!arena_pool->m_arenas.empty())
+        {
+            import_gltf_scene_decode_arena *const arena = arena_pool->m_arenas.back();
+            arena_pool->m_arenas.pop_back();
+            return arena;
+        }
+    }
+
+    import_gltf_scene_decode_arena *const arena = static_cast<import_gltf_scene_decode_arena *>(mcrt_malloc(sizeof(import_gltf_scene_decode_arena), alignof(import_gltf_scene_decode_arena)));
+    assert(NULL != arena);
+
+    arena->m_base = NULL;
+    arena->m_capacity = 0U;
+    arena->m_size = 0U;
+
+    return arena;
+}
+
+static inline void import_gltf_scene_decode_arena_release(import_gltf_scene_decode_arena_pool *arena_pool, import_gltf_scene_decode_arena *arena)
+{
+    std::lock_guard<std::mutex> lock_guard(arena_pool->m_mutex);
+
+    arena_pool->m_arenas.push_back(arena);
+}
+
+static inline void import_gltf_scene_decode_arena_pool_destroy(import_gltf_scene_decode_arena_pool *arena_pool)
+{
+    // all arenas have been released when the decode tasks are completed
+    for (import_gltf_scene_decode_arena *const arena : arena_pool->m_arenas)
+    {
+        if (NULL != arena->m_base)
+        {
+            mcrt_free(arena->m_base);
+        }
+
+        mcrt_free(arena);
+    }
+
+    mcrt_vector<import_gltf_scene_decode_arena *>().swap(arena_pool->m_arenas);
+}
+
+static inline size_t import_gltf_scene_decode_arena_aligned_size(size_t size)
+{
+    return ((size + (k_decode_arena_alignment - 1U)) & (~(k_decode_arena_alignment - 1U)));
+}
+
+static inline void import_gltf_scene_decode_arena_reset(import_gltf_scene_decode_arena *arena, size_t capacity)
+{
+    // the previous allocations are discarded and thus the contents are not preserved when the arena grows
+    if (capacity > arena->m_capacity)
+    {
+        if (NULL != arena->m_base)
+        {
+            mcrt_free(arena->m_base);
+        }
+
+        // the geometric growth such that the arena is rarely reallocated by the subsequent (and usually similar sized) primitives
+        arena->m_capacity = std::max(capacity, arena->m_capacity * 2U);
+        arena->m_base = mcrt_malloc(arena->m_capacity, k_decode_arena_alignment);
+        assert(NULL != arena->m_base);
+    }
+
+    arena->m_size = 0U;
+}
+
+static inline void *import_gltf_scene_decode_arena_allocate(import_gltf_scene_decode_arena *arena, size_t size)
+{
+    assert(import_gltf_scene_decode_arena_aligned_size(size) == size);
+    assert((arena->m_size + size) <= arena->m_capacity);
+
+    void *const address = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(arena->m_base) + arena->m_size);
+    arena->m_size += size;
+
+    return address;
+}
+
 #if defined(__GNUC__)
 #if defined(__x86_64__) || defined(__i386__)
 #include <immintrin.h>
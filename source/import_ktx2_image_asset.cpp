@@ -0,0 +1,730 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include <stddef.h>
+#include <assert.h>
+#include <cstring>
+#include <algorithm>
+#include "../include/import_image_asset.h"
+#include "internal_import_image_subresource.h"
+#include <atomic>
+#include "../../McRT-Malloc/include/mcrt_vector.h"
+#include "../thirdparty/zstd/lib/zstd.h"
+
+//--------------------------------------------------------------------------------------
+// KTX2 file structure definitions
+//
+// https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+//--------------------------------------------------------------------------------------
+
+static constexpr uint8_t const KTX2_IDENTIFIER[12] = {0XAB, 0X4B, 0X54, 0X58, 0X20, 0X32, 0X30, 0XBB, 0X0D, 0X0A, 0X1A, 0X0A}; // "«KTX 20»\r\n\x1A\n"
+
+enum : uint32_t
+{
+    KTX2_SUPERCOMPRESSION_NONE = 0,
+    KTX2_SUPERCOMPRESSION_BASISLZ = 1,
+    KTX2_SUPERCOMPRESSION_ZSTD = 2,
+    KTX2_SUPERCOMPRESSION_ZLIB = 3
+};
+
+// the max number of the mip levels of the 32-bit dimension
+static constexpr uint32_t const KTX2_MAX_LEVEL_COUNT = 32U;
+
+struct KTX2_HEADER
+{
+    uint8_t identifier[12];
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t layerCount;
+    uint32_t faceCount;
+    uint32_t levelCount;
+    uint32_t supercompressionScheme;
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+    uint64_t sgdByteOffset;
+    uint64_t sgdByteLength;
+};
+static_assert(sizeof(KTX2_HEADER) == 80U, "");
+
+struct KTX2_LEVEL_INDEX
+{
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+static_assert(sizeof(KTX2_LEVEL_INDEX) == 24U, "");
+
+struct KTX2_ZSTD_LEVEL_CONTEXT
+{
+    import_asset_input_stream *input_stream;
+    IMPORT_ASSET_IMAGE_HEADER const *image_asset_header;
+    KTX2_LEVEL_INDEX const *level_indices;
+    uint32_t first_mip_level;
+    uint32_t block_width;
+    uint32_t block_height;
+    uint32_t block_size;
+    void *staging_upload_buffer_base;
+    size_t subresource_count;
+    BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests;
+    std::atomic_bool failed;
+};
+
+//--------------------------------------------------------------------------------------
+// the formats which can be imported (the values of the "vkFormat" are the same as the "VkFormat")
+static constexpr struct
+{
+    uint32_t vk_format;
+    BRX_SAMPLED_ASSET_IMAGE_FORMAT format;
+    uint32_t block_width;
+    uint32_t block_height;
+    uint32_t block_size;
+} const KTX2_FORMAT_MAPPINGS[] = {
+    {9U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8_UNORM, 1U, 1U, 1U},
+    {10U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8_SNORM, 1U, 1U, 1U},
+    {16U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8_UNORM, 1U, 1U, 2U},
+    {17U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8_SNORM, 1U, 1U, 2U},
+    {37U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_UNORM, 1U, 1U, 4U},
+    {38U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_SNORM, 1U, 1U, 4U},
+    {43U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_SRGB, 1U, 1U, 4U},
+    {44U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_B8G8R8A8_UNORM, 1U, 1U, 4U},
+    {50U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_B8G8R8A8_SRGB, 1U, 1U, 4U},
+    {64U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_A2B10G10R10_UNORM_PACK32, 1U, 1U, 4U},
+    {70U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R16_UNORM, 1U, 1U, 2U},
+    {76U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R16_SFLOAT, 1U, 1U, 2U},
+    {77U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R16G16_UNORM, 1U, 1U, 4U},
+    {83U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R16G16_SFLOAT, 1U, 1U, 4U},
+    {91U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R16G16B16A16_UNORM, 1U, 1U, 8U},
+    {97U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R16G16B16A16_SFLOAT, 1U, 1U, 8U},
+    {100U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R32_SFLOAT, 1U, 1U, 4U},
+    {103U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R32G32_SFLOAT, 1U, 1U, 8U},
+    {109U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R32G32B32A32_SFLOAT, 1U, 1U, 16U},
+    {122U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_B10G11R11_UFLOAT_PACK32, 1U, 1U, 4U},
+    {123U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_E5B9G9R9_UFLOAT_PACK32, 1U, 1U, 4U},
+    {133U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC1_RGBA_UNORM_BLOCK, 4U, 4U, 8U},
+    {134U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC1_RGBA_SRGB_BLOCK, 4U, 4U, 8U},
+    {135U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC2_UNORM_BLOCK, 4U, 4U, 16U},
+    {136U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC2_SRGB_BLOCK, 4U, 4U, 16U},
+    {137U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC3_UNORM_BLOCK, 4U, 4U, 16U},
+    {138U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC3_SRGB_BLOCK, 4U, 4U, 16U},
+    {139U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC4_UNORM_BLOCK, 4U, 4U, 8U},
+    {140U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC4_SNORM_BLOCK, 4U, 4U, 8U},
+    {141U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC5_UNORM_BLOCK, 4U, 4U, 16U},
+    {142U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC5_SNORM_BLOCK, 4U, 4U, 16U},
+    {143U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC6H_UFLOAT_BLOCK, 4U, 4U, 16U},
+    {144U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC6H_SFLOAT_BLOCK, 4U, 4U, 16U},
+    {145U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_UNORM_BLOCK, 4U, 4U, 16U},
+    {146U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_SRGB_BLOCK, 4U, 4U, 16U},
+    {147U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ETC2_R8G8B8_UNORM_BLOCK, 4U, 4U, 8U},
+    {148U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ETC2_R8G8B8_SRGB_BLOCK, 4U, 4U, 8U},
+    {149U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK, 4U, 4U, 8U},
+    {150U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK, 4U, 4U, 8U},
+    {151U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK, 4U, 4U, 16U},
+    {152U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK, 4U, 4U, 16U},
+    {157U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_4x4_UNORM_BLOCK, 4U, 4U, 16U},
+    {158U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_4x4_SRGB_BLOCK, 4U, 4U, 16U},
+    {159U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_5x4_UNORM_BLOCK, 5U, 4U, 16U},
+    {160U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_5x4_SRGB_BLOCK, 5U, 4U, 16U},
+    {161U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_5x5_UNORM_BLOCK, 5U, 5U, 16U},
+    {162U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_5x5_SRGB_BLOCK, 5U, 5U, 16U},
+    {163U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_6x5_UNORM_BLOCK, 6U, 5U, 16U},
+    {164U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_6x5_SRGB_BLOCK, 6U, 5U, 16U},
+    {165U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_6x6_UNORM_BLOCK, 6U, 6U, 16U},
+    {166U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_6x6_SRGB_BLOCK, 6U, 6U, 16U},
+    {167U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_8x5_UNORM_BLOCK, 8U, 5U, 16U},
+    {168U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_8x5_SRGB_BLOCK, 8U, 5U, 16U},
+    {169U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_8x6_UNORM_BLOCK, 8U, 6U, 16U},
+    {170U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_8x6_SRGB_BLOCK, 8U, 6U, 16U},
+    {171U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_8x8_UNORM_BLOCK, 8U, 8U, 16U},
+    {172U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_8x8_SRGB_BLOCK, 8U, 8U, 16U},
+    {173U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x5_UNORM_BLOCK, 10U, 5U, 16U},
+    {174U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x5_SRGB_BLOCK, 10U, 5U, 16U},
+    {175U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x6_UNORM_BLOCK, 10U, 6U, 16U},
+    {176U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x6_SRGB_BLOCK, 10U, 6U, 16U},
+    {177U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x8_UNORM_BLOCK, 10U, 8U, 16U},
+    {178U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x8_SRGB_BLOCK, 10U, 8U, 16U},
+    {179U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x10_UNORM_BLOCK, 10U, 10U, 16U},
+    {180U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x10_SRGB_BLOCK, 10U, 10U, 16U},
+    {181U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_12x10_UNORM_BLOCK, 12U, 10U, 16U},
+    {182U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_12x10_SRGB_BLOCK, 12U, 10U, 16U},
+    {183U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_12x12_UNORM_BLOCK, 12U, 12U, 16U},
+    {184U, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_12x12_SRGB_BLOCK, 12U, 12U, 16U},
+};
+
+//--------------------------------------------------------------------------------------
+static inline bool KTX2GetImageFormat(uint32_t vk_format, BRX_SAMPLED_ASSET_IMAGE_FORMAT *format);
+
+static inline bool KTX2GetBlockInfo(BRX_SAMPLED_ASSET_IMAGE_FORMAT format, uint32_t *block_width, uint32_t *block_height, uint32_t *block_size);
+
+static inline bool KTX2GetLevelInfo(IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, uint32_t mip_level, uint32_t block_width, uint32_t block_height, uint32_t block_size, size_t *row_bytes, size_t *num_rows, size_t *num_slices, size_t *level_bytes);
+
+static inline bool KTX2ReadLevelIndices(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, uint32_t *supercompression_scheme, KTX2_LEVEL_INDEX *level_indices);
+
+static inline bool KTX2ZstdLevelsFromInputStream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, KTX2_LEVEL_INDEX const *level_indices, uint32_t first_mip_level, uint32_t mip_level_count, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests, import_asset_task_scheduler *task_scheduler);
+
+static void KTX2ZstdLevelTaskFunction(uint32_t task_index, void *user_data);
+
+//--------------------------------------------------------------------------------------
+extern bool import_ktx2_image_asset_header_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER *image_asset_header, size_t *image_asset_data_offset)
+{
+    // the supercompression scheme is NOT returned
+    return import_ktx2_image_asset_header_and_supercompression_scheme_from_input_stream(input_stream, image_asset_header, NULL, image_asset_data_offset);
+}
+
+extern bool import_ktx2_image_asset_header_and_supercompression_scheme_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER *image_asset_header, IMPORT_ASSET_KTX2_SUPERCOMPRESSION_SCHEME *supercompression_scheme, size_t *image_asset_data_offset)
+{
+    assert(image_asset_header != NULL);
+    assert(image_asset_data_offset != NULL);
+
+    if (-1 == input_stream->seek(0, IMPORT_ASSET_INPUT_STREAM_SEEK_SET))
+    {
+        return false;
+    }
+
+    // the level index immediately follows the header
+    uint8_t ktx2DataBuf[sizeof(KTX2_HEADER) + sizeof(KTX2_LEVEL_INDEX) * KTX2_MAX_LEVEL_COUNT];
+    {
+        ptrdiff_t const BytesRead = input_stream->read(ktx2DataBuf, sizeof(KTX2_HEADER));
+        if (BytesRead == -1 || static_cast<size_t>(BytesRead) < sizeof(KTX2_HEADER))
+        {
+            return false;
+        }
+    }
+
+    KTX2_HEADER header;
+    std::memcpy(&header, ktx2DataBuf, sizeof(KTX2_HEADER));
+
+    if (0 != std::memcmp(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)))
+    {
+        return false;
+    }
+
+    // the Basis Universal (the BasisLZ supercompression and the UASTC with VK_FORMAT_UNDEFINED) requires the transcoder and is NOT supported
+    if ((KTX2_SUPERCOMPRESSION_NONE != header.supercompressionScheme) && (KTX2_SUPERCOMPRESSION_ZSTD != header.supercompressionScheme))
+    {
+        return false;
+    }
+
+    // VK_FORMAT_UNDEFINED is used by the Basis Universal
+    BRX_SAMPLED_ASSET_IMAGE_FORMAT format;
+    if (!KTX2GetImageFormat(header.vkFormat, &format))
+    {
+        return false;
+    }
+
+    if (0U == header.pixelWidth)
+    {
+        return false;
+    }
+
+    // the mip levels are generated at runtime if the level count is zero (only the base level is stored)
+    uint32_t const level_count = std::max(header.levelCount, 1U);
+    if (level_count > KTX2_MAX_LEVEL_COUNT)
+    {
+        return false;
+    }
+
+    if (0U == header.pixelDepth)
+    {
+        if (header.pixelHeight > 0U)
+        {
+            image_asset_header->type = IMPORT_ASSET_IMAGE_TYPE_2D;
+        }
+        else
+        {
+            image_asset_header->type = IMPORT_ASSET_IMAGE_TYPE_1D;
+        }
+    }
+    else
+    {
+        // the array of the 3D images is NOT supported by the graphics API
+        if ((header.pixelHeight == 0U) || (header.layerCount > 1U) || (1U != header.faceCount))
+        {
+            return false;
+        }
+
+        image_asset_header->type = IMPORT_ASSET_IMAGE_TYPE_3D;
+    }
+
+    if (1U == header.faceCount)
+    {
+        image_asset_header->is_cube_map = false;
+    }
+    else if (6U == header.faceCount)
+    {
+        if (header.pixelWidth != header.pixelHeight)
+        {
+            return false;
+        }
+
+        image_asset_header->is_cube_map = true;
+    }
+    else
+    {
+        return false;
+    }
+
+    image_asset_header->format = format;
+    image_asset_header->width = header.pixelWidth;
+    image_asset_header->height = std::max(header.pixelHeight, 1U);
+    image_asset_header->depth = std::max(header.pixelDepth, 1U);
+    image_asset_header->mip_levels = level_count;
+    image_asset_header->array_layers = std::max(header.layerCount, 1U) * header.faceCount;
+
+    {
+        ptrdiff_t const BytesRead = input_stream->read(ktx2DataBuf + sizeof(KTX2_HEADER), sizeof(KTX2_LEVEL_INDEX) * level_count);
+        if (BytesRead == -1 || static_cast<size_t>(BytesRead) < (sizeof(KTX2_LEVEL_INDEX) * level_count))
+        {
+            return false;
+        }
+    }
+
+    uint32_t block_width;
+    uint32_t block_height;
+    uint32_t block_size;
+    if (!KTX2GetBlockInfo(format, &block_width, &block_height, &block_size))
+    {
+        assert(false);
+        return false;
+    }
+
+    // the levels are stored from the smallest one (the last mip level) to the largest one (the base mip level)
+    // the data offset is the offset of the smallest level and the level index is verified against the layout which is computed from the header
+    KTX2_LEVEL_INDEX smallest_level_index;
+    std::memcpy(&smallest_level_index, ktx2DataBuf + sizeof(KTX2_HEADER) + sizeof(KTX2_LEVEL_INDEX) * (level_count - 1U), sizeof(KTX2_LEVEL_INDEX));
+
+    // lcm(texel block size, 4) (the supercompressed levels are NOT aligned)
+    uint64_t const level_alignment = (KTX2_SUPERCOMPRESSION_NONE != header.supercompressionScheme) ? 1U : ((0U == (block_size % 4U)) ? block_size : ((0U == (block_size % 2U)) ? (block_size * 2U) : (block_size * 4U)));
+
+    uint64_t level_offset = smallest_level_index.byteOffset;
+    for (uint32_t mip_level_plus_1 = level_count; mip_level_plus_1 > 0U; --mip_level_plus_1)
+    {
+        uint32_t const mip_level = mip_level_plus_1 - 1U;
+
+        size_t row_bytes;
+        size_t num_rows;
+        size_t num_slices;
+        size_t level_bytes;
+        if (!KTX2GetLevelInfo(image_asset_header, mip_level, block_width, block_height, block_size, &row_bytes, &num_rows, &num_slices, &level_bytes))
+        {
+            return false;
+        }
+
+        level_offset = ((level_offset + (level_alignment - 1U)) / level_alignment) * level_alignment;
+
+        KTX2_LEVEL_INDEX level_index;
+        std::memcpy(&level_index, ktx2DataBuf + sizeof(KTX2_HEADER) + sizeof(KTX2_LEVEL_INDEX) * mip_level, sizeof(KTX2_LEVEL_INDEX));
+
+        if ((level_offset != level_index.byteOffset) || (level_bytes != level_index.uncompressedByteLength) || ((KTX2_SUPERCOMPRESSION_NONE == header.supercompressionScheme) ? (level_bytes != level_index.byteLength) : (0U == level_index.byteLength)))
+        {
+            return false;
+        }
+
+        level_offset += level_index.byteLength;
+    }
+
+    if (NULL != supercompression_scheme)
+    {
+        (*supercompression_scheme) = (KTX2_SUPERCOMPRESSION_ZSTD == header.supercompressionScheme) ? IMPORT_ASSET_KTX2_SUPERCOMPRESSION_SCHEME_ZSTD : IMPORT_ASSET_KTX2_SUPERCOMPRESSION_SCHEME_NONE;
+    }
+
+    (*image_asset_data_offset) = static_cast<size_t>(smallest_level_index.byteOffset);
+    return true;
+}
+
+extern bool import_ktx2_image_asset_data_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests)
+{
+    return import_ktx2_image_asset_mip_range_data_from_input_stream(input_stream, image_asset_header, image_asset_data_offset, 0U, image_asset_header->mip_levels, staging_upload_buffer_base, subresource_count, subresource_memcpy_dests);
+}
+
+extern bool import_ktx2_image_asset_mip_range_data_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, uint32_t first_mip_level, uint32_t mip_level_count, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests)
+{
+#ifndef NDEBUG
+    IMPORT_ASSET_IMAGE_HEADER image_asset_header_for_validate;
+    size_t image_asset_data_offset_for_validate;
+    if (!import_ktx2_image_asset_header_from_input_stream(input_stream, &image_asset_header_for_validate, &image_asset_data_offset_for_validate))
+    {
+        return false;
+    }
+
+    assert(image_asset_header->is_cube_map == image_asset_header_for_validate.is_cube_map);
+    assert(image_asset_header->type == image_asset_header_for_validate.type);
+    assert(image_asset_header->format == image_asset_header_for_validate.format);
+    assert(image_asset_header->width == image_asset_header_for_validate.width);
+    assert(image_asset_header->height == image_asset_header_for_validate.height);
+    assert(image_asset_header->depth == image_asset_header_for_validate.depth);
+    assert(image_asset_header->mip_levels == image_asset_header_for_validate.mip_levels);
+    assert(image_asset_header->array_layers == image_asset_header_for_validate.array_layers);
+
+    assert(image_asset_data_offset == image_asset_data_offset_for_validate);
+#endif
+
+    uint32_t supercompression_scheme;
+    KTX2_LEVEL_INDEX level_indices[KTX2_MAX_LEVEL_COUNT];
+    if (!KTX2ReadLevelIndices(input_stream, image_asset_header, &supercompression_scheme, level_indices))
+    {
+        return false;
+    }
+
+    if (KTX2_SUPERCOMPRESSION_ZSTD == supercompression_scheme)
+    {
+        return KTX2ZstdLevelsFromInputStream(input_stream, image_asset_header, level_indices, first_mip_level, mip_level_count, staging_upload_buffer_base, subresource_count, subresource_memcpy_dests, NULL);
+    }
+
+    mcrt_vector<IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT> subresource_layouts(subresource_count);
+    if (!import_ktx2_image_asset_subresource_layouts(image_asset_header, IMPORT_ASSET_KTX2_SUPERCOMPRESSION_SCHEME_NONE, image_asset_data_offset, subresource_count, subresource_layouts.data()))
+    {
+        return false;
+    }
+
+    mcrt_vector<uint32_t> selected_subresource_indices;
+    if (!internal_import_image_select_mip_range(image_asset_header, first_mip_level, mip_level_count, subresource_count, &selected_subresource_indices))
+    {
+        return false;
+    }
+
+    return internal_import_image_subresources_from_input_stream(input_stream, image_asset_data_offset, staging_upload_buffer_base, subresource_count, subresource_layouts.data(), subresource_memcpy_dests, selected_subresource_indices.size(), selected_subresource_indices.data());
+}
+
+extern bool import_ktx2_image_asset_data_from_input_stream_parallel(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests, import_asset_task_scheduler *task_scheduler)
+{
+#ifndef NDEBUG
+    IMPORT_ASSET_IMAGE_HEADER image_asset_header_for_validate;
+    size_t image_asset_data_offset_for_validate;
+    if (!import_ktx2_image_asset_header_from_input_stream(input_stream, &image_asset_header_for_validate, &image_asset_data_offset_for_validate))
+    {
+        return false;
+    }
+
+    assert(image_asset_header->is_cube_map == image_asset_header_for_validate.is_cube_map);
+    assert(image_asset_header->type == image_asset_header_for_validate.type);
+    assert(image_asset_header->format == image_asset_header_for_validate.format);
+    assert(image_asset_header->width == image_asset_header_for_validate.width);
+    assert(image_asset_header->height == image_asset_header_for_validate.height);
+    assert(image_asset_header->depth == image_asset_header_for_validate.depth);
+    assert(image_asset_header->mip_levels == image_asset_header_for_validate.mip_levels);
+    assert(image_asset_header->array_layers == image_asset_header_for_validate.array_layers);
+
+    assert(image_asset_data_offset == image_asset_data_offset_for_validate);
+#endif
+
+    uint32_t supercompression_scheme;
+    KTX2_LEVEL_INDEX level_indices[KTX2_MAX_LEVEL_COUNT];
+    if (!KTX2ReadLevelIndices(input_stream, image_asset_header, &supercompression_scheme, level_indices))
+    {
+        return false;
+    }
+
+    if (KTX2_SUPERCOMPRESSION_ZSTD == supercompression_scheme)
+    {
+        return KTX2ZstdLevelsFromInputStream(input_stream, image_asset_header, level_indices, 0U, image_asset_header->mip_levels, staging_upload_buffer_base, subresource_count, subresource_memcpy_dests, task_scheduler);
+    }
+
+    mcrt_vector<IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT> subresource_layouts(subresource_count);
+    if (!import_ktx2_image_asset_subresource_layouts(image_asset_header, IMPORT_ASSET_KTX2_SUPERCOMPRESSION_SCHEME_NONE, image_asset_data_offset, subresource_count, subresource_layouts.data()))
+    {
+        return false;
+    }
+
+    mcrt_vector<uint32_t> selected_subresource_indices;
+    if (!internal_import_image_select_mip_range(image_asset_header, 0U, image_asset_header->mip_levels, subresource_count, &selected_subresource_indices))
+    {
+        return false;
+    }
+
+    return internal_import_image_subresources_from_input_stream_parallel(input_stream, image_asset_data_offset, staging_upload_buffer_base, subresource_count, subresource_layouts.data(), subresource_memcpy_dests, selected_subresource_indices.size(), selected_subresource_indices.data(), task_scheduler);
+}
+
+extern bool import_ktx2_image_asset_subresource_layouts(IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, IMPORT_ASSET_KTX2_SUPERCOMPRESSION_SCHEME supercompression_scheme, size_t image_asset_data_offset, size_t subresource_count, IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT *subresource_layouts)
+{
+    // the offsets of the supercompressed mip levels are NOT the offsets of the uncompressed data
+    if (IMPORT_ASSET_KTX2_SUPERCOMPRESSION_SCHEME_NONE != supercompression_scheme)
+    {
+        return false;
+    }
+
+    uint32_t block_width;
+    uint32_t block_height;
+    uint32_t block_size;
+    if (!KTX2GetBlockInfo(image_asset_header->format, &block_width, &block_height, &block_size))
+    {
+        return false;
+    }
+
+    size_t const numberOfResources = static_cast<size_t>(image_asset_header->array_layers) * static_cast<size_t>(image_asset_header->mip_levels);
+
+    if (numberOfResources != subresource_count)
+    {
+        return false;
+    }
+
+    // lcm(texel block size, 4)
+    size_t const level_alignment = (0U == (block_size % 4U)) ? block_size : ((0U == (block_size % 2U)) ? (block_size * 2U) : (block_size * 4U));
+
+    // the levels are stored from the smallest one to the largest one and the images of the array layers (and the faces) are tightly packed within each level
+    size_t level_offset = image_asset_data_offset;
+    for (uint32_t mip_level_plus_1 = image_asset_header->mip_levels; mip_level_plus_1 > 0U; --mip_level_plus_1)
+    {
+        uint32_t const mip_level = mip_level_plus_1 - 1U;
+
+        size_t row_bytes;
+        size_t num_rows;
+        size_t num_slices;
+        size_t level_bytes;
+        if (!KTX2GetLevelInfo(image_asset_header, mip_level, block_width, block_height, block_size, &row_bytes, &num_rows, &num_slices, &level_bytes))
+        {
+            return false;
+        }
+
+        if (row_bytes > UINT32_MAX || num_rows > UINT32_MAX || (row_bytes * num_rows) > UINT32_MAX || num_slices > UINT32_MAX)
+        {
+            return false;
+        }
+
+        level_offset = ((level_offset + (level_alignment - 1U)) / level_alignment) * level_alignment;
+
+        for (uint32_t array_layer = 0U; array_layer < image_asset_header->array_layers; ++array_layer)
+        {
+            uint32_t const dstSubresource = brx_sampled_asset_image_import_calculate_subresource_index(mip_level, array_layer, 0U, image_asset_header->mip_levels, image_asset_header->array_layers);
+            if (dstSubresource >= subresource_count)
+            {
+                return false;
+            }
+
+            subresource_layouts[dstSubresource].offset = level_offset + (row_bytes * num_rows * num_slices) * array_layer;
+            subresource_layouts[dstSubresource].row_size = static_cast<uint32_t>(row_bytes);
+            subresource_layouts[dstSubresource].row_count = static_cast<uint32_t>(num_rows);
+            subresource_layouts[dstSubresource].slice_size = static_cast<uint32_t>(row_bytes * num_rows);
+            subresource_layouts[dstSubresource].slice_count = static_cast<uint32_t>(num_slices);
+        }
+
+        level_offset += level_bytes;
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------
+static inline bool KTX2GetImageFormat(uint32_t vk_format, BRX_SAMPLED_ASSET_IMAGE_FORMAT *format)
+{
+    for (auto const &ktx2_format_mapping : KTX2_FORMAT_MAPPINGS)
+    {
+        if (vk_format == ktx2_format_mapping.vk_format)
+        {
+            (*format) = ktx2_format_mapping.format;
+            return true;
+        }
+    }
+
+    // TODO: support more format
+    return false;
+}
+
+static inline bool KTX2GetBlockInfo(BRX_SAMPLED_ASSET_IMAGE_FORMAT format, uint32_t *block_width, uint32_t *block_height, uint32_t *block_size)
+{
+    for (auto const &ktx2_format_mapping : KTX2_FORMAT_MAPPINGS)
+    {
+        if (format == ktx2_format_mapping.format)
+        {
+            (*block_width) = ktx2_format_mapping.block_width;
+            (*block_height) = ktx2_format_mapping.block_height;
+            (*block_size) = ktx2_format_mapping.block_size;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static inline bool KTX2GetLevelInfo(IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, uint32_t mip_level, uint32_t block_width, uint32_t block_height, uint32_t block_size, size_t *row_bytes, size_t *num_rows, size_t *num_slices, size_t *level_bytes)
+{
+    if (mip_level >= 32U)
+    {
+        return false;
+    }
+
+    size_t const width = std::max(static_cast<size_t>(image_asset_header->width >> mip_level), static_cast<size_t>(1U));
+    size_t const height = std::max(static_cast<size_t>(image_asset_header->height >> mip_level), static_cast<size_t>(1U));
+    size_t const depth = std::max(static_cast<size_t>(image_asset_header->depth >> mip_level), static_cast<size_t>(1U));
+
+    (*row_bytes) = ((width + (block_width - 1U)) / block_width) * block_size;
+    (*num_rows) = (height + (block_height - 1U)) / block_height;
+    (*num_slices) = depth;
+    (*level_bytes) = (*row_bytes) * (*num_rows) * (*num_slices) * image_asset_header->array_layers;
+    return true;
+}
+
+static inline bool KTX2ReadLevelIndices(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, uint32_t *supercompression_scheme, KTX2_LEVEL_INDEX *level_indices)
+{
+    // the header has been validated by "import_ktx2_image_asset_header_from_input_stream" and only the supercompression scheme and the level index are read again
+    uint32_t const level_count = image_asset_header->mip_levels;
+    if ((0U == level_count) || (level_count > KTX2_MAX_LEVEL_COUNT))
+    {
+        return false;
+    }
+
+    uint8_t ktx2DataBuf[sizeof(KTX2_HEADER) + sizeof(KTX2_LEVEL_INDEX) * KTX2_MAX_LEVEL_COUNT];
+    size_t const ktx2DataSize = sizeof(KTX2_HEADER) + sizeof(KTX2_LEVEL_INDEX) * level_count;
+    if (static_cast<intptr_t>(ktx2DataSize) != input_stream->read_at(0, ktx2DataBuf, ktx2DataSize))
+    {
+        return false;
+    }
+
+    KTX2_HEADER header;
+    std::memcpy(&header, ktx2DataBuf, sizeof(KTX2_HEADER));
+
+    if ((0 != std::memcmp(header.identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER))) || (std::max(header.levelCount, 1U) != level_count))
+    {
+        return false;
+    }
+
+    (*supercompression_scheme) = header.supercompressionScheme;
+    std::memcpy(level_indices, ktx2DataBuf + sizeof(KTX2_HEADER), sizeof(KTX2_LEVEL_INDEX) * level_count);
+    return true;
+}
+
+static inline bool KTX2ZstdLevelsFromInputStream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, KTX2_LEVEL_INDEX const *level_indices, uint32_t first_mip_level, uint32_t mip_level_count, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests, import_asset_task_scheduler *task_scheduler)
+{
+    if ((0U == mip_level_count) || (first_mip_level >= image_asset_header->mip_levels) || (mip_level_count > (image_asset_header->mip_levels - first_mip_level)))
+    {
+        return false;
+    }
+
+    if ((static_cast<size_t>(image_asset_header->array_layers) * static_cast<size_t>(image_asset_header->mip_levels)) != subresource_count)
+    {
+        return false;
+    }
+
+    KTX2_ZSTD_LEVEL_CONTEXT context;
+    context.input_stream = input_stream;
+    context.image_asset_header = image_asset_header;
+    context.level_indices = level_indices;
+    context.first_mip_level = first_mip_level;
+    if (!KTX2GetBlockInfo(image_asset_header->format, &context.block_width, &context.block_height, &context.block_size))
+    {
+        return false;
+    }
+    context.staging_upload_buffer_base = staging_upload_buffer_base;
+    context.subresource_count = subresource_count;
+    context.subresource_memcpy_dests = subresource_memcpy_dests;
+    context.failed.store(false, std::memory_order_relaxed);
+
+    // one task per mip level (each mip level is one Zstandard frame)
+    // fall back to the serial copy on the calling thread if "read_at" of the input stream is NOT safe to be called concurrently
+    if ((NULL != task_scheduler) && input_stream->is_read_at_thread_safe())
+    {
+        task_scheduler->parallel_for(mip_level_count, KTX2ZstdLevelTaskFunction, &context);
+    }
+    else
+    {
+        for (uint32_t mip_level_index = 0U; mip_level_index < mip_level_count; ++mip_level_index)
+        {
+            KTX2ZstdLevelTaskFunction(mip_level_index, &context);
+        }
+    }
+
+    return (!context.failed.load(std::memory_order_relaxed));
+}
+
+static void KTX2ZstdLevelTaskFunction(uint32_t task_index, void *user_data)
+{
+    KTX2_ZSTD_LEVEL_CONTEXT *const context = static_cast<KTX2_ZSTD_LEVEL_CONTEXT *>(user_data);
+
+    if (context->failed.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    IMPORT_ASSET_IMAGE_HEADER const *const image_asset_header = context->image_asset_header;
+    uint32_t const mip_level = context->first_mip_level + task_index;
+    KTX2_LEVEL_INDEX const &level_index = context->level_indices[mip_level];
+
+    size_t row_bytes;
+    size_t num_rows;
+    size_t num_slices;
+    size_t level_bytes;
+    if ((!KTX2GetLevelInfo(image_asset_header, mip_level, context->block_width, context->block_height, context->block_size, &row_bytes, &num_rows, &num_slices, &level_bytes)) || (level_bytes != level_index.uncompressedByteLength) || (level_index.byteOffset > static_cast<uint64_t>(INT64_MAX)) || (level_index.byteLength > static_cast<uint64_t>(SIZE_MAX)))
+    {
+        context->failed.store(true, std::memory_order_relaxed);
+        return;
+    }
+
+    size_t const compressed_size = static_cast<size_t>(level_index.byteLength);
+
+    // decompress directly from the mapping (e.g. the page cache) when the input stream supports "map_range"
+    void const *compressed_data = NULL;
+    mcrt_vector<uint8_t> compressed_level;
+    if (0 != context->input_stream->map_range(static_cast<int64_t>(level_index.byteOffset), compressed_size, &compressed_data))
+    {
+        compressed_level.resize(compressed_size);
+        if (static_cast<intptr_t>(compressed_size) != context->input_stream->read_at(static_cast<int64_t>(level_index.byteOffset), compressed_level.data(), compressed_size))
+        {
+            context->failed.store(true, std::memory_order_relaxed);
+            return;
+        }
+        compressed_data = compressed_level.data();
+    }
+
+    // the level is decompressed into the private memory (the staging upload buffer is usually the write-combined memory which is very slow to read)
+    mcrt_vector<uint8_t> level(level_bytes);
+    size_t const decompressed_size = ZSTD_decompress(level.data(), level_bytes, compressed_data, compressed_size);
+    if (ZSTD_isError(decompressed_size) || (level_bytes != decompressed_size))
+    {
+        context->failed.store(true, std::memory_order_relaxed);
+        return;
+    }
+
+    // the images of the array layers (and the faces) are tightly packed within each level
+    size_t const slice_bytes = row_bytes * num_rows;
+    for (uint32_t array_layer = 0U; array_layer < image_asset_header->array_layers; ++array_layer)
+    {
+        uint32_t const dstSubresource = brx_sampled_asset_image_import_calculate_subresource_index(mip_level, array_layer, 0U, image_asset_header->mip_levels, image_asset_header->array_layers);
+        if (dstSubresource >= context->subresource_count)
+        {
+            context->failed.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const &subresource_memcpy_dest = context->subresource_memcpy_dests[dstSubresource];
+        assert(num_slices == subresource_memcpy_dest.output_slice_count);
+        assert(num_rows == subresource_memcpy_dest.output_row_count);
+        assert(row_bytes == subresource_memcpy_dest.output_row_size);
+        assert(slice_bytes <= subresource_memcpy_dest.output_slice_pitch);
+        assert(row_bytes <= subresource_memcpy_dest.output_row_pitch);
+
+        uint8_t const *const input = level.data() + slice_bytes * num_slices * array_layer;
+        for (size_t z = 0; z < num_slices; ++z)
+        {
+            void *const output = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(context->staging_upload_buffer_base) + (subresource_memcpy_dest.staging_upload_buffer_offset + subresource_memcpy_dest.output_slice_pitch * z));
+
+            if (row_bytes == subresource_memcpy_dest.output_row_pitch)
+            {
+                std::memcpy(output, input + slice_bytes * z, slice_bytes);
+            }
+            else
+            {
+                for (size_t y = 0; y < num_rows; ++y)
+                {
+                    std::memcpy(reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(output) + subresource_memcpy_dest.output_row_pitch * y), input + (slice_bytes * z + row_bytes * y), row_bytes);
+                }
+            }
+        }
+    }
+}
@@ -16,8 +16,11 @@
 //
 #include <stddef.h>
 #include <assert.h>
+#include <cstring>
 #include <algorithm>
 #include "../include/import_image_asset.h"
+#include "internal_import_image_subresource.h"
+#include "../../McRT-Malloc/include/mcrt_vector.h"
 
 // https://github.com/powervr-graphics/Native_SDK/blob/master/framework/PVRCore/textureio/FileDefinesPVR.h
 // https://github.com/powervr-graphics/Native_SDK/blob/master/framework/PVRCore/textureio/TextureReaderPVR.h
@@ -197,6 +200,85 @@ struct Pvr_MetaData
     char _data[1];      // Data array, can be absolutely anything, the loader needs to know how to handle it based on fourCC and key.
 };
 
+// https://github.com/powervr-graphics/Native_SDK/blob/master/framework/PVRCore/texture/MetaData.h
+enum : uint32_t
+{
+    Pvr_MetaDataKey_TextureAtlasCoords = 0,
+    Pvr_MetaDataKey_BumpData = 1,
+    Pvr_MetaDataKey_CubeMapOrder = 2,
+    Pvr_MetaDataKey_TextureOrientation = 3,
+    Pvr_MetaDataKey_BorderData = 4,
+    Pvr_MetaDataKey_PaddingData = 5
+};
+
+// the flipped axis is stored in its own byte (x, y and z) as the corresponding flag
+enum : uint8_t
+{
+    Pvr_Orientation_Left = 1U << 0U,
+    Pvr_Orientation_Up = 1U << 1U,
+    Pvr_Orientation_Out = 1U << 2U
+};
+
+//--------------------------------------------------------------------------------------
+// the pixel formats which can be imported (both the header and the data)
+// NOTE: the channel type is only matched for the pixel formats of which the high part is NOT zero (the compressed formats are always "UnsignedByteNorm")
+static constexpr struct
+{
+    uint64_t pixel_format;
+    uint32_t color_space;
+    uint32_t channel_type;
+    BRX_SAMPLED_ASSET_IMAGE_FORMAT format;
+} const Pvr_FormatMappings[] = {
+    {Pvr_PixelTypeChar_R8, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8_UNORM},
+    {Pvr_PixelTypeChar_R8G8, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8_UNORM},
+    {Pvr_PixelTypeChar_R8G8B8A8, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_UNORM},
+    {Pvr_PixelTypeChar_R8G8B8A8, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_SRGB},
+    {Pvr_PixelTypeChar_R8G8B8A8, Pvr_ColorSpace_lRGB, Pvr_ChannelType_SignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_SNORM},
+    {Pvr_PixelTypeChar_B8G8R8A8, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_B8G8R8A8_UNORM},
+    {Pvr_PixelTypeChar_B8G8R8A8, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_B8G8R8A8_SRGB},
+    {Pvr_PixelTypeChar_R16, Pvr_ColorSpace_lRGB, Pvr_ChannelType_SignedFloat, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R16_SFLOAT},
+    {Pvr_PixelTypeChar_R16G16B16A16, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedShortNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R16G16B16A16_UNORM},
+    {Pvr_PixelTypeChar_R16G16B16A16, Pvr_ColorSpace_lRGB, Pvr_ChannelType_SignedFloat, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R16G16B16A16_SFLOAT},
+    {Pvr_PixelTypeChar_R32, Pvr_ColorSpace_lRGB, Pvr_ChannelType_SignedFloat, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R32_SFLOAT},
+    {Pvr_PixelTypeChar_R32G32B32A32, Pvr_ColorSpace_lRGB, Pvr_ChannelType_SignedFloat, BRX_SAMPLED_ASSET_IMAGE_FORMAT_R32G32B32A32_SFLOAT},
+    {Pvr_PixelTypeID_BC7, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_UNORM_BLOCK},
+    {Pvr_PixelTypeID_BC7, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ETC2_RGB, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ETC2_R8G8B8_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ETC2_RGB, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ETC2_R8G8B8_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ETC2_RGB_A1, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ETC2_RGB_A1, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ETC2_RGBA, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ETC2_RGBA, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ASTC_4x4, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_4x4_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ASTC_4x4, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_4x4_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ASTC_5x4, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_5x4_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ASTC_5x4, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_5x4_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ASTC_5x5, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_5x5_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ASTC_5x5, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_5x5_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ASTC_6x5, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_6x5_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ASTC_6x5, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_6x5_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ASTC_6x6, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_6x6_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ASTC_6x6, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_6x6_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ASTC_8x5, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_8x5_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ASTC_8x5, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_8x5_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ASTC_8x6, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_8x6_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ASTC_8x6, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_8x6_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ASTC_8x8, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_8x8_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ASTC_8x8, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_8x8_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ASTC_10x5, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x5_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ASTC_10x5, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x5_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ASTC_10x6, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x6_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ASTC_10x6, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x6_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ASTC_10x8, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x8_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ASTC_10x8, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x8_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ASTC_10x10, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x10_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ASTC_10x10, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_10x10_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ASTC_12x10, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_12x10_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ASTC_12x10, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_12x10_SRGB_BLOCK},
+    {Pvr_PixelTypeID_ASTC_12x12, Pvr_ColorSpace_lRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_12x12_UNORM_BLOCK},
+    {Pvr_PixelTypeID_ASTC_12x12, Pvr_ColorSpace_sRGB, Pvr_ChannelType_UnsignedByteNorm, BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_12x12_SRGB_BLOCK},
+};
+
 //--------------------------------------------------------------------------------------
 static inline uint32_t Pvr_GetPixelFormatPartHigh(uint64_t pixelFormat);
 
@@ -208,8 +290,20 @@ static inline uint32_t pvr_get_format_plane_count(uint64_t pixelFormat);
 
 static inline bool pvr_is_depth_stencil(uint64_t pixelFormat);
 
+static inline bool Pvr_ParseMetaData(uint8_t const *metaData, uint32_t metaDataSize, size_t metaDataOffset, IMPORT_ASSET_PVR_IMAGE_METADATA *image_asset_metadata);
+
+static inline bool Pvr_GetImageFormat(uint64_t pixelFormat, uint32_t colorSpace, uint32_t channelType, BRX_SAMPLED_ASSET_IMAGE_FORMAT *format);
+
+static inline uint64_t Pvr_GetPixelFormatFromImageFormat(BRX_SAMPLED_ASSET_IMAGE_FORMAT format);
+
 //--------------------------------------------------------------------------------------
 extern bool import_pvr_image_asset_header_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER *image_asset_header, size_t *image_asset_data_offset)
+{
+    // the metadata is NOT read at all
+    return import_pvr_image_asset_header_and_metadata_from_input_stream(input_stream, image_asset_header, NULL, image_asset_data_offset);
+}
+
+extern bool import_pvr_image_asset_header_and_metadata_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER *image_asset_header, IMPORT_ASSET_PVR_IMAGE_METADATA *image_asset_metadata, size_t *image_asset_data_offset)
 {
     assert(image_asset_header != NULL);
     assert(image_asset_data_offset != NULL);
@@ -233,38 +327,34 @@ extern bool import_pvr_image_asset_header_from_input_stream(import_asset_input_s
         return false;
     }
 
-#ifndef NDEBUG
-    // TODO: handle metadata
+    if (NULL != image_asset_metadata)
     {
-        uint32_t metaDataRead = 0U;
+        size_t const metaDataOffset = sizeof(header.version) + sizeof(header.flags) + sizeof(header.pixelFormat) + sizeof(header.colorSpace) + sizeof(header.channelType) + sizeof(header.height) + sizeof(header.width) + sizeof(header.depth) + sizeof(header.numSurfaces) + sizeof(header.numFaces) + sizeof(header.numMipMaps) + sizeof(header.metaDataSize);
 
-        while (metaDataRead < header.metaDataSize)
+        // the whole metadata section is read at once (rather than one "read" and one "seek" for each metadata block)
+        mcrt_vector<uint8_t> metaData;
+        if (header.metaDataSize > 0U)
         {
-            Pvr_MetaData metadata;
-            {
-                ptrdiff_t BytesRead = input_stream->read(&metadata, sizeof(metadata._fourCC) + sizeof(metadata._key) + sizeof(metadata._dataSize));
-                if (BytesRead == -1 || static_cast<size_t>(BytesRead) < (sizeof(metadata._fourCC) + sizeof(metadata._key) + sizeof(metadata._dataSize)))
-                {
-                    return false;
-                }
-            }
-            metaDataRead += (sizeof(metadata._fourCC) + sizeof(metadata._key) + sizeof(metadata._dataSize));
-
-            if (Pvr_HeaderVersionV3 != metadata._fourCC)
+            int64_t size;
+            if ((-1 == input_stream->stat_size(&size)) || (static_cast<int64_t>(metaDataOffset) + static_cast<int64_t>(header.metaDataSize) > size))
             {
                 return false;
             }
 
-            if (-1 == input_stream->seek(metadata._dataSize, IMPORT_ASSET_INPUT_STREAM_SEEK_CUR))
+            metaData.resize(header.metaDataSize);
+
+            ptrdiff_t const BytesRead = input_stream->read(metaData.data(), header.metaDataSize);
+            if (BytesRead == -1 || static_cast<size_t>(BytesRead) < header.metaDataSize)
             {
                 return false;
             }
-            metaDataRead += metadata._dataSize;
         }
 
-        assert(metaDataRead == header.metaDataSize);
+        if (!Pvr_ParseMetaData(metaData.data(), header.metaDataSize, metaDataOffset, image_asset_metadata))
+        {
+            return false;
+        }
     }
-#endif
 
     (*image_asset_data_offset) = (sizeof(header.version) + sizeof(header.flags) + sizeof(header.pixelFormat) + sizeof(header.colorSpace) + sizeof(header.channelType) + sizeof(header.height) + sizeof(header.width) + sizeof(header.depth) + sizeof(header.numSurfaces) + sizeof(header.numFaces) + sizeof(header.numMipMaps) + sizeof(header.metaDataSize) + header.metaDataSize);
 
@@ -305,48 +395,9 @@ extern bool import_pvr_image_asset_header_from_input_stream(import_asset_input_s
         return false;
     }
 
-    if (0U == Pvr_GetPixelFormatPartHigh(header.pixelFormat))
+    if (!Pvr_GetImageFormat(header.pixelFormat, header.colorSpace, header.channelType, &image_asset_header->format))
     {
-        switch (header.pixelFormat)
-        {
-        // TODO:
-        // case Pvr_PixelTypeID_BC6:
-        // {
-        //     image_asset_header->format = (Pvr_ChannelType_UnsignedFloat == header.channelType) ? BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC6H_UFLOAT_BLOCK : ((Pvr_ChannelType_SignedFloat == header.colorSpace) ? BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC6H_SFLOAT_BLOCK : static_cast<BRX_SAMPLED_ASSET_IMAGE_FORMAT>(-1));
-        // }
-        // break;
-        case Pvr_PixelTypeID_BC7:
-        {
-            image_asset_header->format = (Pvr_ColorSpace_lRGB == header.colorSpace) ? BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_UNORM_BLOCK : ((Pvr_ColorSpace_sRGB == header.colorSpace) ? static_cast<BRX_SAMPLED_ASSET_IMAGE_FORMAT>(BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_SRGB_BLOCK) : static_cast<BRX_SAMPLED_ASSET_IMAGE_FORMAT>(-1));
-        }
-        break;
-        case Pvr_PixelTypeID_ASTC_4x4:
-        {
-            image_asset_header->format = (Pvr_ColorSpace_lRGB == header.colorSpace) ? BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_4x4_UNORM_BLOCK : ((Pvr_ColorSpace_sRGB == header.colorSpace) ? static_cast<BRX_SAMPLED_ASSET_IMAGE_FORMAT>(BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_4x4_SRGB_BLOCK) : static_cast<BRX_SAMPLED_ASSET_IMAGE_FORMAT>(-1));
-        }
-        break;
-        default:
-            // TODO: support more format
-            assert(false);
-            image_asset_header->format = static_cast<BRX_SAMPLED_ASSET_IMAGE_FORMAT>(-1);
-            return false;
-        }
-    }
-    else
-    {
-        switch (header.pixelFormat)
-        {
-        case Pvr_PixelTypeChar_R8G8B8A8:
-        {
-            image_asset_header->format = (Pvr_ChannelType_UnsignedByteNorm == header.channelType) ? ((Pvr_ColorSpace_lRGB == header.colorSpace) ? BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_UNORM : static_cast<BRX_SAMPLED_ASSET_IMAGE_FORMAT>(BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_SRGB)) : static_cast<BRX_SAMPLED_ASSET_IMAGE_FORMAT>(-1);
-        }
-        break;
-        default:
-            // TODO: support more format
-            assert(false);
-            image_asset_header->format = static_cast<BRX_SAMPLED_ASSET_IMAGE_FORMAT>(-1);
-            return false;
-        }
+        return false;
     }
 
     image_asset_header->width = header.width;
@@ -359,6 +410,11 @@ extern bool import_pvr_image_asset_header_from_input_stream(import_asset_input_s
 }
 
 extern bool import_pvr_image_asset_data_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests)
+{
+    return import_pvr_image_asset_mip_range_data_from_input_stream(input_stream, image_asset_header, image_asset_data_offset, 0U, image_asset_header->mip_levels, staging_upload_buffer_base, subresource_count, subresource_memcpy_dests);
+}
+
+extern bool import_pvr_image_asset_mip_range_data_from_input_stream(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, uint32_t first_mip_level, uint32_t mip_level_count, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests)
 {
 #ifndef NDEBUG
     IMPORT_ASSET_IMAGE_HEADER image_asset_header_for_validate;
@@ -380,27 +436,69 @@ extern bool import_pvr_image_asset_data_from_input_stream(import_asset_input_str
     assert(image_asset_data_offset == image_asset_data_offset_for_validate);
 #endif
 
-    uint64_t pixel_format;
-    switch (image_asset_header->format)
-    {
-    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_UNORM:
-    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_R8G8B8A8_SRGB:
-        pixel_format = Pvr_PixelTypeChar_R8G8B8A8;
-        break;
-    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_UNORM_BLOCK:
-    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_SRGB_BLOCK:
-        pixel_format = Pvr_PixelTypeID_BC7;
-        break;
-    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_4x4_UNORM_BLOCK:
-    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_ASTC_4x4_SRGB_BLOCK:
-        pixel_format = Pvr_PixelTypeID_ASTC_4x4;
-        break;
-    default:
-        assert(false);
-        pixel_format = -1;
+    mcrt_vector<IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT> subresource_layouts(subresource_count);
+    if (!import_pvr_image_asset_subresource_layouts(image_asset_header, image_asset_data_offset, subresource_count, subresource_layouts.data()))
+    {
+        return false;
+    }
+
+    // only the selected mip levels are read (e.g. the mip tail is loaded first and the higher mip levels are streamed on demand)
+    mcrt_vector<uint32_t> selected_subresource_indices;
+    if (!internal_import_image_select_mip_range(image_asset_header, first_mip_level, mip_level_count, subresource_count, &selected_subresource_indices))
+    {
+        return false;
     }
 
-    uint32_t numberOfPlanes = pvr_get_format_plane_count(pixel_format);
+    return internal_import_image_subresources_from_input_stream(input_stream, image_asset_data_offset, staging_upload_buffer_base, subresource_count, subresource_layouts.data(), subresource_memcpy_dests, selected_subresource_indices.size(), selected_subresource_indices.data());
+}
+
+extern bool import_pvr_image_asset_data_from_input_stream_parallel(import_asset_input_stream *input_stream, IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests, import_asset_task_scheduler *task_scheduler)
+{
+#ifndef NDEBUG
+    IMPORT_ASSET_IMAGE_HEADER image_asset_header_for_validate;
+    size_t image_asset_data_offset_for_validate;
+    if (!import_pvr_image_asset_header_from_input_stream(input_stream, &image_asset_header_for_validate, &image_asset_data_offset_for_validate))
+    {
+        return false;
+    }
+
+    assert(image_asset_header->is_cube_map == image_asset_header_for_validate.is_cube_map);
+    assert(image_asset_header->type == image_asset_header_for_validate.type);
+    assert(image_asset_header->format == image_asset_header_for_validate.format);
+    assert(image_asset_header->width == image_asset_header_for_validate.width);
+    assert(image_asset_header->height == image_asset_header_for_validate.height);
+    assert(image_asset_header->depth == image_asset_header_for_validate.depth);
+    assert(image_asset_header->mip_levels == image_asset_header_for_validate.mip_levels);
+    assert(image_asset_header->array_layers == image_asset_header_for_validate.array_layers);
+
+    assert(image_asset_data_offset == image_asset_data_offset_for_validate);
+#endif
+
+    // the offset of each subresource is computed up front and the subresources are independent of each other
+    mcrt_vector<IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT> subresource_layouts(subresource_count);
+    if (!import_pvr_image_asset_subresource_layouts(image_asset_header, image_asset_data_offset, subresource_count, subresource_layouts.data()))
+    {
+        return false;
+    }
+
+    mcrt_vector<uint32_t> selected_subresource_indices;
+    if (!internal_import_image_select_mip_range(image_asset_header, 0U, image_asset_header->mip_levels, subresource_count, &selected_subresource_indices))
+    {
+        return false;
+    }
+
+    return internal_import_image_subresources_from_input_stream_parallel(input_stream, image_asset_data_offset, staging_upload_buffer_base, subresource_count, subresource_layouts.data(), subresource_memcpy_dests, selected_subresource_indices.size(), selected_subresource_indices.data(), task_scheduler);
+}
+
+extern bool import_pvr_image_asset_subresource_layouts(IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, size_t image_asset_data_offset, size_t subresource_count, IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT *subresource_layouts)
+{
+    uint64_t const pixel_format = Pvr_GetPixelFormatFromImageFormat(image_asset_header->format);
+    if (static_cast<uint64_t>(-1) == pixel_format)
+    {
+        return false;
+    }
+
+    uint32_t const numberOfPlanes = pvr_get_format_plane_count(pixel_format);
     if (0U == numberOfPlanes)
     {
         return false;
@@ -419,6 +517,12 @@ extern bool import_pvr_image_asset_data_from_input_stream(import_asset_input_str
         return false;
     }
 
+    // TODO: support more than one plane
+    if (1U != numberOfPlanes)
+    {
+        return false;
+    }
+
     uint32_t uiSmallestWidth;
     uint32_t uiSmallestHeight;
     uint32_t uiSmallestDepth;
@@ -429,12 +533,13 @@ extern bool import_pvr_image_asset_data_from_input_stream(import_asset_input_str
 
     size_t inputSkipBytes = image_asset_data_offset;
 
-    // Write the texture data
+    // the subresources of the same mip level are adjacent
     for (uint32_t mipMap = 0; mipMap < image_asset_header->mip_levels; ++mipMap)
     {
-        uint32_t uiWidth;
-        uint32_t uiHeight;
-        uint32_t uiDepth;
+        // NOTE: the 64-bit arithmetic is used since the padded dimensions and the sizes may overflow the 32-bit integer
+        uint64_t uiWidth;
+        uint64_t uiHeight;
+        uint64_t uiDepth;
         {
             // Get the dimensions of the current MIP Map level.
             uiWidth = std::max<uint32_t>(image_asset_header->width >> mipMap, 1);
@@ -444,15 +549,16 @@ extern bool import_pvr_image_asset_data_from_input_stream(import_asset_input_str
             // If pixel format is compressed, the dimensions need to be padded.
             if (0U == Pvr_GetPixelFormatPartHigh(pixel_format))
             {
-                uiWidth = uiWidth + ((-1 * uiWidth) % uiSmallestWidth);
-                uiHeight = uiHeight + ((-1 * uiHeight) % uiSmallestHeight);
-                uiDepth = uiDepth + ((-1 * uiDepth) % uiSmallestDepth);
+                // NOTE: "(-1 * uiWidth) % uiSmallestWidth" is NOT correct for the block size which is NOT power of 2 (e.g. ASTC 5x5) since the unsigned arithmetic is modulo 2^32
+                uiWidth = ((uiWidth + (uiSmallestWidth - 1U)) / uiSmallestWidth) * uiSmallestWidth;
+                uiHeight = ((uiHeight + (uiSmallestHeight - 1U)) / uiSmallestHeight) * uiSmallestHeight;
+                uiDepth = ((uiDepth + (uiSmallestDepth - 1U)) / uiSmallestDepth) * uiSmallestDepth;
             }
         }
 
-        uint32_t uiRowBytes;
-        uint32_t uiNumRows;
-        uint32_t uiNumSlices;
+        uint64_t uiRowBytes;
+        uint64_t uiNumRows;
+        uint64_t uiNumSlices;
         if (pixel_format >= Pvr_PixelTypeID_ASTC_4x4 && pixel_format <= Pvr_PixelTypeID_ASTC_6x6x6)
         {
             uiRowBytes = (128U / 8U) * (uiWidth / uiSmallestWidth);
@@ -461,87 +567,215 @@ extern bool import_pvr_image_asset_data_from_input_stream(import_asset_input_str
         }
         else
         {
-            uint32_t const bpp = Pvr_GetBitsPerPixel(pixel_format);
+            uint64_t const bpp = Pvr_GetBitsPerPixel(pixel_format);
 
             uiRowBytes = ((bpp * uiWidth) / 8U) * uiSmallestHeight * uiSmallestDepth;
             uiNumRows = (uiHeight / uiSmallestHeight);
             uiNumSlices = (uiDepth / uiSmallestDepth);
         }
 
-        size_t inputRowSize = uiRowBytes;
-        size_t inputNumRows = uiNumRows;
-        size_t inputSliceSize = uiRowBytes * uiNumRows;
-        size_t inputNumSlices = uiNumSlices;
+        uint64_t const uiSliceBytes = uiRowBytes * uiNumRows;
+
+        if (uiSliceBytes > UINT32_MAX || uiRowBytes > UINT32_MAX || uiNumRows > UINT32_MAX || uiNumSlices > UINT32_MAX)
+        {
+            return false;
+        }
+
+        size_t inputRowSize = static_cast<size_t>(uiRowBytes);
+        size_t inputNumRows = static_cast<size_t>(uiNumRows);
+        size_t inputSliceSize = static_cast<size_t>(uiSliceBytes);
+        size_t inputNumSlices = static_cast<size_t>(uiNumSlices);
 
         for (uint32_t arrayIndex = 0U; arrayIndex < image_asset_header->array_layers; ++arrayIndex)
         {
 
-            // TODO: support more than one plane
-            assert(1 == numberOfPlanes);
-            for (uint32_t planeIndex = 0; planeIndex < 1U; ++planeIndex)
+            for (uint32_t planeIndex = 0; planeIndex < numberOfPlanes; ++planeIndex)
             {
                 uint32_t dstSubresource = brx_sampled_asset_image_import_calculate_subresource_index(mipMap, arrayIndex, planeIndex, image_asset_header->mip_levels, image_asset_header->array_layers);
-                assert(dstSubresource < subresource_count);
+                if (dstSubresource >= subresource_count)
+                {
+                    return false;
+                }
 
-                assert(inputNumSlices == subresource_memcpy_dests[dstSubresource].output_slice_count);
-                assert(inputNumRows == subresource_memcpy_dests[dstSubresource].output_row_count);
-                assert(inputRowSize == subresource_memcpy_dests[dstSubresource].output_row_size);
+                subresource_layouts[dstSubresource].offset = inputSkipBytes;
+                subresource_layouts[dstSubresource].row_size = static_cast<uint32_t>(inputRowSize);
+                subresource_layouts[dstSubresource].row_count = static_cast<uint32_t>(inputNumRows);
+                subresource_layouts[dstSubresource].slice_size = static_cast<uint32_t>(inputSliceSize);
+                subresource_layouts[dstSubresource].slice_count = static_cast<uint32_t>(inputNumSlices);
+            }
+
+            uint64_t const inputArrayLayerSize = uiSliceBytes * uiNumSlices;
+            if (inputArrayLayerSize > (static_cast<uint64_t>(SIZE_MAX) - inputSkipBytes))
+            {
+                return false;
+            }
 
-                if (inputSliceSize == subresource_memcpy_dests[dstSubresource].output_slice_pitch && inputRowSize == subresource_memcpy_dests[dstSubresource].output_row_pitch)
+            inputSkipBytes += static_cast<size_t>(inputArrayLayerSize);
+        }
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------
+static inline bool Pvr_ParseMetaData(uint8_t const *metaData, uint32_t metaDataSize, size_t metaDataOffset, IMPORT_ASSET_PVR_IMAGE_METADATA *image_asset_metadata)
+{
+    // the default values are used if the metadata block is NOT present
+    image_asset_metadata->orientation_left = false;
+    image_asset_metadata->orientation_up = false;
+    image_asset_metadata->orientation_out = false;
+    for (uint32_t face_index = 0U; face_index < 6U; ++face_index)
+    {
+        image_asset_metadata->cube_map_face_order[face_index] = face_index;
+    }
+    image_asset_metadata->border_width = 0U;
+    image_asset_metadata->border_height = 0U;
+    image_asset_metadata->border_depth = 0U;
+    image_asset_metadata->padding_size = 0U;
+    image_asset_metadata->texture_atlas_coords_offset = 0U;
+    image_asset_metadata->texture_atlas_coords_count = 0U;
+
+    uint32_t metaDataRead = 0U;
+
+    while (metaDataRead < metaDataSize)
+    {
+        Pvr_MetaData metadata;
+        if ((metaDataSize - metaDataRead) < (sizeof(metadata._fourCC) + sizeof(metadata._key) + sizeof(metadata._dataSize)))
+        {
+            return false;
+        }
+        std::memcpy(&metadata, metaData + metaDataRead, sizeof(metadata._fourCC) + sizeof(metadata._key) + sizeof(metadata._dataSize));
+        metaDataRead += (sizeof(metadata._fourCC) + sizeof(metadata._key) + sizeof(metadata._dataSize));
+
+        if (metadata._dataSize > (metaDataSize - metaDataRead))
+        {
+            return false;
+        }
+
+        uint8_t const *const data = metaData + metaDataRead;
+
+        // the metadata blocks of the other creators are skipped
+        if (Pvr_HeaderVersionV3 == metadata._fourCC)
+        {
+            switch (metadata._key)
+            {
+            case Pvr_MetaDataKey_TextureAtlasCoords:
+            {
+                // the coordinates are NOT copied and can be read by the caller by the offset
+                image_asset_metadata->texture_atlas_coords_offset = metaDataOffset + metaDataRead;
+                image_asset_metadata->texture_atlas_coords_count = metadata._dataSize / sizeof(float);
+            }
+            break;
+            case Pvr_MetaDataKey_CubeMapOrder:
+            {
+                // e.g. "XxYyZz": the upper case is the positive axis and the lower case is the negative axis
+                if (6U != metadata._dataSize)
                 {
-                    assert(input_stream->seek(0, IMPORT_ASSET_INPUT_STREAM_SEEK_CUR) == inputSkipBytes);
+                    return false;
+                }
 
-                    ptrdiff_t BytesRead = input_stream->read(reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(staging_upload_buffer_base) + subresource_memcpy_dests[dstSubresource].staging_upload_buffer_offset), inputSliceSize * inputNumSlices);
-                    if (BytesRead == -1 || static_cast<size_t>(BytesRead) < (inputSliceSize * inputNumSlices))
+                for (uint32_t face_index = 0U; face_index < 6U; ++face_index)
+                {
+                    switch (data[face_index])
                     {
+                    case 'X':
+                        image_asset_metadata->cube_map_face_order[face_index] = 0U;
+                        break;
+                    case 'x':
+                        image_asset_metadata->cube_map_face_order[face_index] = 1U;
+                        break;
+                    case 'Y':
+                        image_asset_metadata->cube_map_face_order[face_index] = 2U;
+                        break;
+                    case 'y':
+                        image_asset_metadata->cube_map_face_order[face_index] = 3U;
+                        break;
+                    case 'Z':
+                        image_asset_metadata->cube_map_face_order[face_index] = 4U;
+                        break;
+                    case 'z':
+                        image_asset_metadata->cube_map_face_order[face_index] = 5U;
+                        break;
+                    default:
                         return false;
                     }
                 }
-                else if (inputRowSize == subresource_memcpy_dests[dstSubresource].output_row_pitch)
+            }
+            break;
+            case Pvr_MetaDataKey_TextureOrientation:
+            {
+                if (3U != metadata._dataSize)
                 {
-                    assert(inputSliceSize <= subresource_memcpy_dests[dstSubresource].output_slice_pitch);
-
-                    for (size_t z = 0; z < inputNumSlices; ++z)
-                    {
-                        assert(input_stream->seek(0, IMPORT_ASSET_INPUT_STREAM_SEEK_CUR) == (inputSkipBytes + inputSliceSize * z));
-
-                        ptrdiff_t BytesRead = input_stream->read(reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(staging_upload_buffer_base) + (subresource_memcpy_dests[dstSubresource].staging_upload_buffer_offset + subresource_memcpy_dests[dstSubresource].output_slice_pitch * z)), inputSliceSize);
-                        if (BytesRead == -1 || static_cast<size_t>(BytesRead) < inputSliceSize)
-                        {
-                            return false;
-                        }
-                    }
+                    return false;
                 }
-                else
-                {
-                    assert(inputSliceSize <= subresource_memcpy_dests[dstSubresource].output_slice_pitch);
-                    assert(inputRowSize <= subresource_memcpy_dests[dstSubresource].output_row_pitch);
 
-                    for (size_t z = 0; z < inputNumSlices; ++z)
-                    {
-                        for (size_t y = 0; y < inputNumRows; ++y)
-                        {
-                            assert(input_stream->seek(0, IMPORT_ASSET_INPUT_STREAM_SEEK_CUR) == (inputSkipBytes + inputSliceSize * z + inputRowSize * y));
-
-                            ptrdiff_t BytesRead = input_stream->read(reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(staging_upload_buffer_base) + (subresource_memcpy_dests[dstSubresource].staging_upload_buffer_offset + subresource_memcpy_dests[dstSubresource].output_slice_pitch * z + subresource_memcpy_dests[dstSubresource].output_row_pitch * y)), inputRowSize);
-                            if (BytesRead == -1 || static_cast<size_t>(BytesRead) < inputRowSize)
-                            {
-                                return false;
-                            }
-                        }
-                    }
-                }
+                image_asset_metadata->orientation_left = (Pvr_Orientation_Left == data[0]);
+                image_asset_metadata->orientation_up = (Pvr_Orientation_Up == data[1]);
+                image_asset_metadata->orientation_out = (Pvr_Orientation_Out == data[2]);
             }
+            break;
+            case Pvr_MetaDataKey_BorderData:
+            {
+                if ((sizeof(uint32_t) * 3U) != metadata._dataSize)
+                {
+                    return false;
+                }
 
-            inputSkipBytes += inputSliceSize * inputNumSlices;
+                std::memcpy(&image_asset_metadata->border_width, data, sizeof(uint32_t));
+                std::memcpy(&image_asset_metadata->border_height, data + sizeof(uint32_t), sizeof(uint32_t));
+                std::memcpy(&image_asset_metadata->border_depth, data + sizeof(uint32_t) * 2U, sizeof(uint32_t));
+            }
+            break;
+            case Pvr_MetaDataKey_PaddingData:
+            {
+                image_asset_metadata->padding_size += metadata._dataSize;
+            }
+            break;
+            default:
+                // e.g. "BumpData"
+                break;
+            }
         }
+
+        metaDataRead += metadata._dataSize;
     }
 
-    uint8_t u_assert_only[1];
-    assert(input_stream->read(u_assert_only, sizeof(uint8_t)) == 0);
+    assert(metaDataRead == metaDataSize);
     return true;
 }
 
+//--------------------------------------------------------------------------------------
+static inline bool Pvr_GetImageFormat(uint64_t pixelFormat, uint32_t colorSpace, uint32_t channelType, BRX_SAMPLED_ASSET_IMAGE_FORMAT *format)
+{
+    // the channel type is only meaningful for the uncompressed pixel formats
+    bool const match_channel_type = (0U != Pvr_GetPixelFormatPartHigh(pixelFormat));
+
+    for (auto const &format_mapping : Pvr_FormatMappings)
+    {
+        if ((pixelFormat == format_mapping.pixel_format) && (colorSpace == format_mapping.color_space) && ((!match_channel_type) || (channelType == format_mapping.channel_type)))
+        {
+            (*format) = format_mapping.format;
+            return true;
+        }
+    }
+
+    // TODO: support more format
+    return false;
+}
+
+static inline uint64_t Pvr_GetPixelFormatFromImageFormat(BRX_SAMPLED_ASSET_IMAGE_FORMAT format)
+{
+    for (auto const &format_mapping : Pvr_FormatMappings)
+    {
+        if (format == format_mapping.format)
+        {
+            return format_mapping.pixel_format;
+        }
+    }
+
+    return static_cast<uint64_t>(-1);
+}
+
 //--------------------------------------------------------------------------------------
 static inline uint32_t Pvr_GetPixelFormatPartHigh(uint64_t pixelFormat)
 {
@@ -772,6 +1006,8 @@ static inline uint32_t Pvr_GetBitsPerPixel(uint64_t pixelFormat)
         case Pvr_PixelTypeID_BC5:
         case Pvr_PixelTypeID_EAC_RG11:
         case Pvr_PixelTypeID_ETC2_RGBA:
+        case Pvr_PixelTypeID_BC6:
+        case Pvr_PixelTypeID_BC7:
             return 8U;
         case Pvr_PixelTypeID_YUY2:
         case Pvr_PixelTypeID_UYVY:
@@ -0,0 +1,423 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "internal_import_gltf_accessor.h"
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+template <typename out_t>
+static inline bool internal_gltf_accessor_read(cgltf_accessor const *accessor, size_t first_element_index, size_t element_count, uint32_t component_count, bool normalized, out_t *out_base, size_t out_stride);
+
+template <typename out_t>
+static inline bool internal_gltf_read_components(cgltf_component_type component_type, uint32_t component_count, bool normalized, uintptr_t element_base, size_t element_stride, size_t element_count, out_t *out_base, size_t out_stride);
+
+template <typename out_t, bool normalized, uint32_t component_count>
+static inline bool internal_gltf_read_typed_components(cgltf_component_type component_type, uintptr_t element_base, size_t element_stride, size_t element_count, out_t *out_base, size_t out_stride);
+
+template <typename component_t, typename out_t, bool normalized, uint32_t component_count>
+static inline void internal_gltf_read_elements(uintptr_t element_base, size_t element_stride, size_t element_count, out_t *out_base, size_t out_stride);
+
+template <typename component_t, typename out_t, bool normalized>
+static inline out_t internal_gltf_convert_component(component_t component);
+
+template <typename component_t>
+static inline size_t internal_gltf_convert_normalized_components(component_t const *components, size_t component_count, float *out_components);
+
+extern bool internal_import_gltf_accessor_read_float(cgltf_accessor const *accessor, uint32_t component_count, bool always_normalized, float *out_base, size_t out_stride)
+{
+    return internal_gltf_accessor_read(accessor, 0U, accessor->count, component_count, (always_normalized || accessor->normalized), out_base, out_stride);
+}
+
+extern bool internal_import_gltf_accessor_read_float_range(cgltf_accessor const *accessor, size_t first_element_index, size_t element_count, uint32_t component_count, bool always_normalized, float *out_base, size_t out_stride)
+{
+    return internal_gltf_accessor_read(accessor, first_element_index, element_count, component_count, (always_normalized || accessor->normalized), out_base, out_stride);
+}
+
+extern bool internal_import_gltf_accessor_read_uint(cgltf_accessor const *accessor, uint32_t component_count, uint32_t *out_base, size_t out_stride)
+{
+    return internal_gltf_accessor_read(accessor, 0U, accessor->count, component_count, false, out_base, out_stride);
+}
+
+extern bool internal_import_gltf_accessor_read_ushort(cgltf_accessor const *accessor, uint32_t component_count, uint16_t *out_base, size_t out_stride)
+{
+    return internal_gltf_accessor_read(accessor, 0U, accessor->count, component_count, false, out_base, out_stride);
+}
+
+template <typename out_t>
+static inline bool internal_gltf_accessor_read(cgltf_accessor const *accessor, size_t first_element_index, size_t element_count, uint32_t component_count, bool normalized, out_t *out_base, size_t out_stride)
+{
+    if ((cgltf_num_components(accessor->type) != component_count) || (first_element_index > accessor->count) || (element_count > (accessor->count - first_element_index)))
+    {
+        return false;
+    }
+
+    if (NULL != accessor->buffer_view)
+    {
+        cgltf_buffer_view const *const buffer_view = accessor->buffer_view;
+        size_t const element_stride = (0 != buffer_view->stride) ? buffer_view->stride : accessor->stride;
+        uintptr_t const element_base = reinterpret_cast<uintptr_t>(buffer_view->buffer->data) + buffer_view->offset + accessor->offset + element_stride * first_element_index;
+
+        if (!internal_gltf_read_components(accessor->component_type, component_count, normalized, element_base, element_stride, element_count, out_base, out_stride))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        // the sparse accessor without the buffer view is initialized with zeros
+        for (size_t element_index = 0U; element_index < element_count; ++element_index)
+        {
+            std::memset(reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(out_base) + out_stride * element_index), 0, sizeof(out_t) * component_count);
+        }
+    }
+
+    if (accessor->is_sparse)
+    {
+        cgltf_accessor_sparse const *const sparse = &accessor->sparse;
+
+        uintptr_t const sparse_index_base = reinterpret_cast<uintptr_t>(sparse->indices_buffer_view->buffer->data) + sparse->indices_buffer_view->offset + sparse->indices_byte_offset;
+        size_t const sparse_index_stride = cgltf_component_size(sparse->indices_component_type);
+
+        // the sparse values are always tightly packed
+        uintptr_t const sparse_value_base = reinterpret_cast<uintptr_t>(sparse->values_buffer_view->buffer->data) + sparse->values_buffer_view->offset + sparse->values_byte_offset;
+        size_t const sparse_value_stride = cgltf_component_size(accessor->component_type) * component_count;
+
+        for (size_t sparse_index = 0U; sparse_index < sparse->count; ++sparse_index)
+        {
+            uintptr_t const sparse_index_address = sparse_index_base + sparse_index_stride * sparse_index;
+
+            size_t element_index;
+            switch (sparse->indices_component_type)
+            {
+            case cgltf_component_type_r_8u:
+                element_index = *reinterpret_cast<uint8_t const *>(sparse_index_address);
+                break;
+            case cgltf_component_type_r_16u:
+                element_index = *reinterpret_cast<uint16_t const *>(sparse_index_address);
+                break;
+            case cgltf_component_type_r_32u:
+                element_index = *reinterpret_cast<uint32_t const *>(sparse_index_address);
+                break;
+            default:
+                return false;
+            }
+
+            if (element_index >= accessor->count)
+            {
+                return false;
+            }
+
+            // only the sparse values within the range are substituted
+            if ((element_index < first_element_index) || (element_index >= (first_element_index + element_count)))
+            {
+                continue;
+            }
+
+            out_t *const out_element = reinterpret_cast<out_t *>(reinterpret_cast<uintptr_t>(out_base) + out_stride * (element_index - first_element_index));
+
+            if (!internal_gltf_read_components(accessor->component_type, component_count, normalized, sparse_value_base + sparse_value_stride * sparse_index, sparse_value_stride, 1U, out_element, out_stride))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+template <typename out_t>
+static inline bool internal_gltf_read_components(cgltf_component_type component_type, uint32_t component_count, bool normalized, uintptr_t element_base, size_t element_stride, size_t element_count, out_t *out_base, size_t out_stride)
+{
+    // both the component count and the normalization are resolved at compile time such that the inner loop can be vectorized by the compiler
+    switch (component_count)
+    {
+    case 1U:
+        return normalized ? internal_gltf_read_typed_components<out_t, true, 1U>(component_type, element_base, element_stride, element_count, out_base, out_stride) : internal_gltf_read_typed_components<out_t, false, 1U>(component_type, element_base, element_stride, element_count, out_base, out_stride);
+    case 2U:
+        return normalized ? internal_gltf_read_typed_components<out_t, true, 2U>(component_type, element_base, element_stride, element_count, out_base, out_stride) : internal_gltf_read_typed_components<out_t, false, 2U>(component_type, element_base, element_stride, element_count, out_base, out_stride);
+    case 3U:
+        return normalized ? internal_gltf_read_typed_components<out_t, true, 3U>(component_type, element_base, element_stride, element_count, out_base, out_stride) : internal_gltf_read_typed_components<out_t, false, 3U>(component_type, element_base, element_stride, element_count, out_base, out_stride);
+    case 4U:
+        return normalized ? internal_gltf_read_typed_components<out_t, true, 4U>(component_type, element_base, element_stride, element_count, out_base, out_stride) : internal_gltf_read_typed_components<out_t, false, 4U>(component_type, element_base, element_stride, element_count, out_base, out_stride);
+    default:
+        return false;
+    }
+}
+
+template <typename out_t, bool normalized, uint32_t component_count>
+static inline bool internal_gltf_read_typed_components(cgltf_component_type component_type, uintptr_t element_base, size_t element_stride, size_t element_count, out_t *out_base, size_t out_stride)
+{
+    // the signed and the floating point components can only be read as the floating point
+    constexpr bool const out_float = std::is_same<out_t, float>::value;
+
+    switch (component_type)
+    {
+    case cgltf_component_type_r_8:
+    {
+        if constexpr (out_float)
+        {
+            internal_gltf_read_elements<int8_t, out_t, normalized, component_count>(element_base, element_stride, element_count, out_base, out_stride);
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    case cgltf_component_type_r_8u:
+    {
+        internal_gltf_read_elements<uint8_t, out_t, normalized, component_count>(element_base, element_stride, element_count, out_base, out_stride);
+        return true;
+    }
+    case cgltf_component_type_r_16:
+    {
+        if constexpr (out_float)
+        {
+            internal_gltf_read_elements<int16_t, out_t, normalized, component_count>(element_base, element_stride, element_count, out_base, out_stride);
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    case cgltf_component_type_r_16u:
+    {
+        internal_gltf_read_elements<uint16_t, out_t, normalized, component_count>(element_base, element_stride, element_count, out_base, out_stride);
+        return true;
+    }
+    case cgltf_component_type_r_32u:
+    {
+        if constexpr (sizeof(out_t) >= sizeof(uint32_t))
+        {
+            internal_gltf_read_elements<uint32_t, out_t, normalized, component_count>(element_base, element_stride, element_count, out_base, out_stride);
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    case cgltf_component_type_r_32f:
+    {
+        if constexpr (out_float)
+        {
+            internal_gltf_read_elements<float, out_t, normalized, component_count>(element_base, element_stride, element_count, out_base, out_stride);
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    default:
+        return false;
+    }
+}
+
+template <typename component_t, typename out_t, bool normalized, uint32_t component_count>
+static inline void internal_gltf_read_elements(uintptr_t element_base, size_t element_stride, size_t element_count, out_t *out_base, size_t out_stride)
+{
+    if constexpr (std::is_same<component_t, out_t>::value)
+    {
+        // the tightly packed elements, of which the layout is the same as the output, are copied directly
+        if ((element_stride == (sizeof(component_t) * component_count)) && (out_stride == element_stride))
+        {
+            std::memcpy(out_base, reinterpret_cast<void const *>(element_base), element_stride * element_count);
+            return;
+        }
+    }
+    else if constexpr (std::is_same<out_t, float>::value && std::is_integral<component_t>::value && (sizeof(component_t) <= sizeof(uint16_t)) && normalized)
+    {
+        // the tightly packed quantized elements (e.g. the KHR_mesh_quantization) are converted as a flat array of the components by the SSE2 or NEON
+        if ((element_stride == (sizeof(component_t) * component_count)) && (out_stride == (sizeof(float) * component_count)))
+        {
+            component_t const *const components = reinterpret_cast<component_t const *>(element_base);
+            size_t const total_component_count = component_count * element_count;
+
+            size_t component_index = internal_gltf_convert_normalized_components(components, total_component_count, out_base);
+
+            for (; component_index < total_component_count; ++component_index)
+            {
+                out_base[component_index] = internal_gltf_convert_component<component_t, out_t, normalized>(components[component_index]);
+            }
+            return;
+        }
+    }
+
+    for (size_t element_index = 0U; element_index < element_count; ++element_index)
+    {
+        component_t const *const element = reinterpret_cast<component_t const *>(element_base + element_stride * element_index);
+        out_t *const out_element = reinterpret_cast<out_t *>(reinterpret_cast<uintptr_t>(out_base) + out_stride * element_index);
+
+        for (uint32_t component_index = 0U; component_index < component_count; ++component_index)
+        {
+            out_element[component_index] = internal_gltf_convert_component<component_t, out_t, normalized>(element[component_index]);
+        }
+    }
+}
+
+template <typename component_t, typename out_t, bool normalized>
+static inline out_t internal_gltf_convert_component(component_t component)
+{
+    if constexpr (std::is_same<out_t, float>::value && (!std::is_same<component_t, float>::value) && normalized)
+    {
+        // glTF 2.0: f = max(c / (2^(b-1) - 1), -1.0) for the signed normalized integers and f = c / (2^b - 1) for the unsigned normalized integers
+        constexpr float const max_component = static_cast<float>(std::numeric_limits<component_t>::max());
+        return std::max(static_cast<float>(component) / max_component, -1.0F);
+    }
+    else
+    {
+        return static_cast<out_t>(component);
+    }
+}
+
+#if defined(__GNUC__)
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(__arm__)
+#include <arm_neon.h>
+#else
+#error Unknown Architecture
+#endif
+#elif defined(_MSC_VER)
+#if defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#elif defined(_M_ARM64) || defined(_M_ARM)
+#include <arm_neon.h>
+#else
+#error Unknown Architecture
+#endif
+#else
+#error Unknown Compiler
+#endif
+
+template <typename component_t>
+static inline size_t internal_gltf_convert_normalized_components(component_t const *components, size_t component_count, float *out_components)
+{
+    static_assert(std::is_integral<component_t>::value && (sizeof(component_t) <= sizeof(uint16_t)), "");
+
+    // 8 components are converted at a time and the number of the converted components is returned (the remaining components are converted by the caller)
+    // the division (rather than the multiplication by the reciprocal) is used such that the result is exactly the same as the "internal_gltf_convert_component"
+    size_t component_index = 0U;
+
+#if (defined(__GNUC__) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+    __m128 const max_component = _mm_set1_ps(static_cast<float>(std::numeric_limits<component_t>::max()));
+    __m128 const min_value = _mm_set1_ps(-1.0F);
+    __m128i const zero = _mm_setzero_si128();
+
+    for (; (component_index + 8U) <= component_count; component_index += 8U)
+    {
+        __m128i low_components;
+        __m128i high_components;
+        if constexpr (std::is_same<component_t, uint8_t>::value)
+        {
+            __m128i const components_16 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<__m128i const *>(components + component_index)), zero);
+            low_components = _mm_unpacklo_epi16(components_16, zero);
+            high_components = _mm_unpackhi_epi16(components_16, zero);
+        }
+        else if constexpr (std::is_same<component_t, int8_t>::value)
+        {
+            // SSE2 has no sign extension and thus each component is duplicated into the high half and arithmetically shifted back
+            __m128i const components_8 = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(components + component_index));
+            __m128i const components_16 = _mm_srai_epi16(_mm_unpacklo_epi8(components_8, components_8), 8);
+            low_components = _mm_srai_epi32(_mm_unpacklo_epi16(components_16, components_16), 16);
+            high_components = _mm_srai_epi32(_mm_unpackhi_epi16(components_16, components_16), 16);
+        }
+        else if constexpr (std::is_same<component_t, uint16_t>::value)
+        {
+            __m128i const components_16 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(components + component_index));
+            low_components = _mm_unpacklo_epi16(components_16, zero);
+            high_components = _mm_unpackhi_epi16(components_16, zero);
+        }
+        else
+        {
+            static_assert(std::is_same<component_t, int16_t>::value, "");
+            __m128i const components_16 = _mm_loadu_si128(reinterpret_cast<__m128i const *>(components + component_index));
+            low_components = _mm_srai_epi32(_mm_unpacklo_epi16(components_16, components_16), 16);
+            high_components = _mm_srai_epi32(_mm_unpackhi_epi16(components_16, components_16), 16);
+        }
+
+        __m128 low_out_components = _mm_div_ps(_mm_cvtepi32_ps(low_components), max_component);
+        __m128 high_out_components = _mm_div_ps(_mm_cvtepi32_ps(high_components), max_component);
+
+        if constexpr (std::is_signed<component_t>::value)
+        {
+            low_out_components = _mm_max_ps(low_out_components, min_value);
+            high_out_components = _mm_max_ps(high_out_components, min_value);
+        }
+
+        _mm_storeu_ps(out_components + component_index, low_out_components);
+        _mm_storeu_ps(out_components + component_index + 4U, high_out_components);
+    }
+#elif (defined(__GNUC__) && defined(__aarch64__)) || (defined(_MSC_VER) && defined(_M_ARM64))
+    float32x4_t const max_component = vdupq_n_f32(static_cast<float>(std::numeric_limits<component_t>::max()));
+    float32x4_t const min_value = vdupq_n_f32(-1.0F);
+
+    for (; (component_index + 8U) <= component_count; component_index += 8U)
+    {
+        float32x4_t low_out_components;
+        float32x4_t high_out_components;
+        if constexpr (std::is_same<component_t, uint8_t>::value)
+        {
+            uint16x8_t const components_16 = vmovl_u8(vld1_u8(components + component_index));
+            low_out_components = vcvtq_f32_u32(vmovl_u16(vget_low_u16(components_16)));
+            high_out_components = vcvtq_f32_u32(vmovl_u16(vget_high_u16(components_16)));
+        }
+        else if constexpr (std::is_same<component_t, int8_t>::value)
+        {
+            int16x8_t const components_16 = vmovl_s8(vld1_s8(components + component_index));
+            low_out_components = vcvtq_f32_s32(vmovl_s16(vget_low_s16(components_16)));
+            high_out_components = vcvtq_f32_s32(vmovl_s16(vget_high_s16(components_16)));
+        }
+        else if constexpr (std::is_same<component_t, uint16_t>::value)
+        {
+            uint16x8_t const components_16 = vld1q_u16(components + component_index);
+            low_out_components = vcvtq_f32_u32(vmovl_u16(vget_low_u16(components_16)));
+            high_out_components = vcvtq_f32_u32(vmovl_u16(vget_high_u16(components_16)));
+        }
+        else
+        {
+            static_assert(std::is_same<component_t, int16_t>::value, "");
+            int16x8_t const components_16 = vld1q_s16(components + component_index);
+            low_out_components = vcvtq_f32_s32(vmovl_s16(vget_low_s16(components_16)));
+            high_out_components = vcvtq_f32_s32(vmovl_s16(vget_high_s16(components_16)));
+        }
+
+        low_out_components = vdivq_f32(low_out_components, max_component);
+        high_out_components = vdivq_f32(high_out_components, max_component);
+
+        if constexpr (std::is_signed<component_t>::value)
+        {
+            low_out_components = vmaxq_f32(low_out_components, min_value);
+            high_out_components = vmaxq_f32(high_out_components, min_value);
+        }
+
+        vst1q_f32(out_components + component_index, low_out_components);
+        vst1q_f32(out_components + component_index + 4U, high_out_components);
+    }
+#else
+    // the 32-bit ARM has no vector division and the components are converted by the caller
+    (void)components;
+    (void)component_count;
+    (void)out_components;
+#endif
+
+    return component_index;
+}
@@ -0,0 +1,40 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _INTERNAL_IMPORT_GLTF_ACCESSOR_H_
+#define _INTERNAL_IMPORT_GLTF_ACCESSOR_H_ 1
+
+#include <cstddef>
+#include <cstdint>
+#include "../thirdparty/cgltf/cgltf.h"
+
+// read the elements [0, accessor->count) of the accessor (each of which has "component_count" components) into the "out_base" (with "out_stride" bytes between the consecutive elements)
+// all component types are supported (e.g. the quantized attributes of the KHR_mesh_quantization) and the integer components are normalized when the accessor is normalized or when "always_normalized" is true (e.g. the texcoord and the joint weights of the glTF 2.0 core)
+// the sparse accessor is supported (the elements, which are not substituted by the sparse values, are zero when the accessor has no buffer view)
+extern bool internal_import_gltf_accessor_read_float(cgltf_accessor const *accessor, uint32_t component_count, bool always_normalized, float *out_base, size_t out_stride);
+
+// only the elements [first_element_index, first_element_index + element_count) are read (e.g. decoding block by block) and the element "first_element_index" is written at the "out_base"
+// every sparse value is visited for each range and thus the sparse accessor is expected to be read at once
+extern bool internal_import_gltf_accessor_read_float_range(cgltf_accessor const *accessor, size_t first_element_index, size_t element_count, uint32_t component_count, bool always_normalized, float *out_base, size_t out_stride);
+
+// the unsigned integer components (e.g. the indices) are read without any conversion
+extern bool internal_import_gltf_accessor_read_uint(cgltf_accessor const *accessor, uint32_t component_count, uint32_t *out_base, size_t out_stride);
+
+// the "r_32u" components are not supported (e.g. the joint indices)
+extern bool internal_import_gltf_accessor_read_ushort(cgltf_accessor const *accessor, uint32_t component_count, uint16_t *out_base, size_t out_stride);
+
+#endif
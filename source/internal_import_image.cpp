@@ -20,41 +20,136 @@
 #include "internal_import_png_image.h"
 #include "internal_import_jpeg_image.h"
 #include "internal_import_webp_image.h"
+#include "internal_import_image_resize.h"
 #include <cassert>
+#include <cfloat>
+#include <cmath>
 #include <algorithm>
 
-#define CV_IGNORE_DEBUG_BUILD_GUARD 1
-#if defined(__GNUC__)
-// GCC or CLANG
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-#pragma GCC diagnostic ignored "-Wdeprecated-anon-enum-enum-conversion"
-#include <opencv2/opencv.hpp>
-#pragma GCC diagnostic pop
-#elif defined(_MSC_VER)
-#if defined(__clang__)
-// CLANG-CL
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-#pragma GCC diagnostic ignored "-Wdeprecated-anon-enum-enum-conversion"
-#pragma GCC diagnostic ignored "-Winvalid-noreturn"
-#pragma GCC diagnostic ignored "-Wunused-but-set-variable"
-#include <opencv2/opencv.hpp>
-#pragma GCC diagnostic pop
-#else
-// MSVC
-#include <opencv2/opencv.hpp>
-#endif
-#else
-#error Unknown Compiler
-#endif
+// the JPEG is decoded at the reduced resolution "jpeg_scale_num / 8" by the libjpeg DCT scaling
+static constexpr uint32_t const k_jpeg_scale_denom = 8U;
 
-extern bool internal_import_image(void const *data_base, size_t data_size, mcrt_vector<uint32_t> &out_rgba_data, uint32_t *out_width, uint32_t *out_height)
+enum INTERNAL_IMPORT_IMAGE_CONTAINER
+{
+    INTERNAL_IMPORT_IMAGE_CONTAINER_UNKNOWN = 0,
+    INTERNAL_IMPORT_IMAGE_CONTAINER_WEBP = 1,
+    INTERNAL_IMPORT_IMAGE_CONTAINER_PNG = 2,
+    INTERNAL_IMPORT_IMAGE_CONTAINER_JPEG = 3
+};
+
+static inline INTERNAL_IMPORT_IMAGE_CONTAINER internal_import_image_container(void const *data_base, size_t data_size);
+
+static inline bool internal_import_image_container_header(INTERNAL_IMPORT_IMAGE_CONTAINER container, void const *data_base, size_t data_size, uint32_t *out_width, uint32_t *out_height, uint32_t *out_channel_count);
+
+static inline bool internal_import_image_container_into(INTERNAL_IMPORT_IMAGE_CONTAINER container, void const *data_base, size_t data_size, uint32_t jpeg_scale_num, uint32_t width, uint32_t height, void *out_rgba_data_base, size_t out_row_pitch, import_asset_task_scheduler *task_scheduler);
+
+static inline void internal_import_image_target_size(uint32_t origin_width, uint32_t origin_height, uint32_t *out_target_width, uint32_t *out_target_height);
+
+extern bool internal_import_image_header(void const *data_base, size_t data_size, uint32_t *out_width, uint32_t *out_height, uint32_t *out_channel_count, uint32_t *out_target_width, uint32_t *out_target_height)
 {
-    mcrt_vector<uint32_t> origin_rgba_data;
     uint32_t origin_width = 0;
     uint32_t origin_height = 0;
-    bool status_internal_import_image;
+    uint32_t origin_channel_count = 0;
+    if (!internal_import_image_container_header(internal_import_image_container(data_base, data_size), data_base, data_size, &origin_width, &origin_height, &origin_channel_count))
+    {
+        return false;
+    }
+
+    (*out_width) = origin_width;
+    (*out_height) = origin_height;
+    (*out_channel_count) = origin_channel_count;
+    internal_import_image_target_size(origin_width, origin_height, out_target_width, out_target_height);
+    return true;
+}
+
+extern bool internal_import_image(void const *data_base, size_t data_size, mcrt_vector<uint32_t> &out_rgba_data, uint32_t *out_width, uint32_t *out_height)
+{
+    return internal_import_image(data_base, data_size, false, out_rgba_data, out_width, out_height);
+}
+
+extern bool internal_import_image(void const *data_base, size_t data_size, bool srgb, mcrt_vector<uint32_t> &out_rgba_data, uint32_t *out_width, uint32_t *out_height)
+{
+    uint32_t origin_width;
+    uint32_t origin_height;
+    uint32_t origin_channel_count;
+    uint32_t target_width;
+    uint32_t target_height;
+    if (!internal_import_image_header(data_base, data_size, &origin_width, &origin_height, &origin_channel_count, &target_width, &target_height))
+    {
+        return false;
+    }
+
+    out_rgba_data.resize(static_cast<size_t>(target_width) * static_cast<size_t>(target_height));
+
+    if (!internal_import_image_into(data_base, data_size, srgb, target_width, target_height, out_rgba_data.data(), sizeof(uint32_t) * static_cast<size_t>(target_width), NULL))
+    {
+        return false;
+    }
+
+    (*out_width) = target_width;
+    (*out_height) = target_height;
+    return true;
+}
+
+extern bool internal_import_image_into(void const *data_base, size_t data_size, bool srgb, uint32_t target_width, uint32_t target_height, void *out_rgba_data_base, size_t out_row_pitch, import_asset_task_scheduler *task_scheduler)
+{
+    if ((0U == target_width) || (target_width > k_max_width_or_height) || (0U == target_height) || (target_height > k_max_width_or_height) || (out_row_pitch < (sizeof(uint32_t) * static_cast<size_t>(target_width))))
+    {
+        return false;
+    }
+
+    INTERNAL_IMPORT_IMAGE_CONTAINER const container = internal_import_image_container(data_base, data_size);
+
+    uint32_t origin_width;
+    uint32_t origin_height;
+    uint32_t origin_channel_count;
+    if (!internal_import_image_container_header(container, data_base, data_size, &origin_width, &origin_height, &origin_channel_count))
+    {
+        return false;
+    }
+
+    // the JPEG which will be downsampled is decoded at the smallest DCT scale which is still NOT smaller than the target size (the full resolution decoding is wasted)
+    uint32_t jpeg_scale_num = k_jpeg_scale_denom;
+    uint32_t decode_width = origin_width;
+    uint32_t decode_height = origin_height;
+    if (INTERNAL_IMPORT_IMAGE_CONTAINER_JPEG == container)
+    {
+        for (uint32_t scale_num = 1U; scale_num < k_jpeg_scale_denom; ++scale_num)
+        {
+            uint32_t scaled_width;
+            uint32_t scaled_height;
+            internal_import_jpeg_image_scaled_size(origin_width, origin_height, scale_num, &scaled_width, &scaled_height);
+            if ((scaled_width >= target_width) && (scaled_height >= target_height))
+            {
+                jpeg_scale_num = scale_num;
+                decode_width = scaled_width;
+                decode_height = scaled_height;
+                break;
+            }
+        }
+    }
+
+    if ((target_width == decode_width) && (target_height == decode_height))
+    {
+        // the pixels are decoded directly into the output (NO intermediate image)
+        return internal_import_image_container_into(container, data_base, data_size, jpeg_scale_num, decode_width, decode_height, out_rgba_data_base, out_row_pitch, task_scheduler);
+    }
+    else
+    {
+        // the decoded image is stored in the private memory (the staging upload buffer is usually the write-combined memory which is very slow to read) and only the resampled image is written into the output
+        mcrt_vector<uint32_t> decode_rgba_data(static_cast<size_t>(decode_width) * static_cast<size_t>(decode_height));
+        if (!internal_import_image_container_into(container, data_base, data_size, jpeg_scale_num, decode_width, decode_height, decode_rgba_data.data(), sizeof(uint32_t) * static_cast<size_t>(decode_width), task_scheduler))
+        {
+            return false;
+        }
+
+        internal_import_image_resize(decode_rgba_data.data(), decode_width, decode_height, srgb, out_rgba_data_base, out_row_pitch, target_width, target_height);
+        return true;
+    }
+}
+
+static inline INTERNAL_IMPORT_IMAGE_CONTAINER internal_import_image_container(void const *data_base, size_t data_size)
+{
     if (data_size >= 12U &&
         (82U == reinterpret_cast<uint8_t const *>(data_base)[0]) &&
         (73U == reinterpret_cast<uint8_t const *>(data_base)[1]) &&
@@ -70,7 +165,7 @@ extern bool internal_import_image(void const *data_base, size_t data_size, mcrt_
         // 82 73 70 70 _ _ _ _ 87 69 66 80
         // R  I  F  F  _ _ _ _ W  E  B  P
 
-        status_internal_import_image = internal_import_webp_image(data_base, data_size, origin_rgba_data, &origin_width, &origin_height);
+        return INTERNAL_IMPORT_IMAGE_CONTAINER_WEBP;
     }
     else if (data_size >= 8U &&
              (137U == reinterpret_cast<uint8_t const *>(data_base)[0]) &&
@@ -86,7 +181,7 @@ extern bool internal_import_image(void const *data_base, size_t data_size, mcrt_
         // 137 80 78 71 13 10 26  10
         // N/A P  N  G  CR LF EOF LF
 
-        status_internal_import_image = internal_import_png_image(data_base, data_size, origin_rgba_data, &origin_width, &origin_height);
+        return INTERNAL_IMPORT_IMAGE_CONTAINER_PNG;
     }
     else if (data_size >= 2U &&
              (0XFFU == reinterpret_cast<uint8_t const *>(data_base)[0]) &&
@@ -96,134 +191,124 @@ extern bool internal_import_image(void const *data_base, size_t data_size, mcrt_
         // 0XFF 0XD8
         // N/A  SOI
 
-        status_internal_import_image = internal_import_jpeg_image(data_base, data_size, origin_rgba_data, &origin_width, &origin_height);
+        return INTERNAL_IMPORT_IMAGE_CONTAINER_JPEG;
     }
     else
     {
-        status_internal_import_image = false;
+        return INTERNAL_IMPORT_IMAGE_CONTAINER_UNKNOWN;
     }
+}
 
-    if (status_internal_import_image)
+static inline bool internal_import_image_container_header(INTERNAL_IMPORT_IMAGE_CONTAINER container, void const *data_base, size_t data_size, uint32_t *out_width, uint32_t *out_height, uint32_t *out_channel_count)
+{
+    switch (container)
     {
-        uint32_t target_width;
-        uint32_t target_height;
-        {
-            assert((origin_width > 0U) && (origin_width <= k_max_width_or_height) && (origin_height > 0U) && (origin_height <= k_max_width_or_height));
+    case INTERNAL_IMPORT_IMAGE_CONTAINER_WEBP:
+        return internal_import_webp_image_header(data_base, data_size, out_width, out_height, out_channel_count);
+    case INTERNAL_IMPORT_IMAGE_CONTAINER_PNG:
+        return internal_import_png_image_header(data_base, data_size, out_width, out_height, out_channel_count);
+    case INTERNAL_IMPORT_IMAGE_CONTAINER_JPEG:
+        return internal_import_jpeg_image_header(data_base, data_size, out_width, out_height, out_channel_count);
+    default:
+        return false;
+    }
+}
+
+static inline bool internal_import_image_container_into(INTERNAL_IMPORT_IMAGE_CONTAINER container, void const *data_base, size_t data_size, uint32_t jpeg_scale_num, uint32_t width, uint32_t height, void *out_rgba_data_base, size_t out_row_pitch, import_asset_task_scheduler *task_scheduler)
+{
+    switch (container)
+    {
+    case INTERNAL_IMPORT_IMAGE_CONTAINER_WEBP:
+        assert(k_jpeg_scale_denom == jpeg_scale_num);
+        return internal_import_webp_image_into(data_base, data_size, width, height, out_rgba_data_base, out_row_pitch);
+    case INTERNAL_IMPORT_IMAGE_CONTAINER_PNG:
+        assert(k_jpeg_scale_denom == jpeg_scale_num);
+        return internal_import_png_image_into(data_base, data_size, width, height, out_rgba_data_base, out_row_pitch);
+    case INTERNAL_IMPORT_IMAGE_CONTAINER_JPEG:
+        return internal_import_jpeg_image_scaled_into_parallel(data_base, data_size, jpeg_scale_num, width, height, out_rgba_data_base, out_row_pitch, task_scheduler);
+    default:
+        return false;
+    }
+}
 
-            if ((0U == (origin_width & (origin_width - 1U))) && (0U == (origin_height & (origin_height - 1U))))
+static inline void internal_import_image_target_size(uint32_t origin_width, uint32_t origin_height, uint32_t *out_target_width, uint32_t *out_target_height)
+{
+    assert((origin_width > 0U) && (origin_width <= k_max_width_or_height) && (origin_height > 0U) && (origin_height <= k_max_width_or_height));
+
+    if ((0U == (origin_width & (origin_width - 1U))) && (0U == (origin_height & (origin_height - 1U))))
+    {
+        (*out_target_width) = origin_width;
+        (*out_target_height) = origin_height;
+    }
+    else
+    {
+        // DirectXTex/texconv.cpp: FitPowerOf2
+
+        if (origin_width > origin_height)
+        {
+            if (0U == (origin_width & (origin_width - 1U)))
             {
-                target_width = origin_width;
-                target_height = origin_height;
+                (*out_target_width) = origin_width;
             }
             else
             {
-                // DirectXTex/texconv.cpp: FitPowerOf2
-
-                if (origin_width > origin_height)
+                uint32_t w;
+                for (w = k_max_width_or_height; w > 1; w >>= 1)
                 {
-                    if (0U == (origin_width & (origin_width - 1U)))
+                    if (w <= origin_width)
                     {
-                        target_width = origin_width;
-                    }
-                    else
-                    {
-                        uint32_t w;
-                        for (w = k_max_width_or_height; w > 1; w >>= 1)
-                        {
-                            if (w <= origin_width)
-                            {
-                                break;
-                            }
-                        }
-                        target_width = w;
+                        break;
                     }
+                }
+                (*out_target_width) = w;
+            }
 
+            {
+                float const origin_aspect_ratio = static_cast<float>(origin_width) / static_cast<float>(origin_height);
+                float best_score = FLT_MAX;
+                for (uint32_t h = k_max_width_or_height; h > 0; h >>= 1)
+                {
+                    float const score = std::abs((static_cast<float>(*out_target_width) / static_cast<float>(h)) - origin_aspect_ratio);
+                    if (score < best_score)
                     {
-                        float const origin_aspect_ratio = static_cast<float>(origin_width) / static_cast<float>(origin_height);
-                        float best_score = FLT_MAX;
-                        for (uint32_t h = k_max_width_or_height; h > 0; h >>= 1)
-                        {
-                            float const score = std::abs((static_cast<float>(target_width) / static_cast<float>(h)) - origin_aspect_ratio);
-                            if (score < best_score)
-                            {
-                                best_score = score;
-                                target_height = h;
-                            }
-                        }
+                        best_score = score;
+                        (*out_target_height) = h;
                     }
                 }
-                else
+            }
+        }
+        else
+        {
+            if (0U == (origin_height & (origin_height - 1U)))
+            {
+                (*out_target_height) = origin_height;
+            }
+            else
+            {
+                uint32_t h;
+                for (h = k_max_width_or_height; h > 1; h >>= 1)
                 {
-                    if (0U == (origin_height & (origin_height - 1U)))
-                    {
-                        target_height = origin_height;
-                    }
-                    else
+                    if (h <= origin_height)
                     {
-                        uint32_t h;
-                        for (h = k_max_width_or_height; h > 1; h >>= 1)
-                        {
-                            if (h <= origin_height)
-                            {
-                                break;
-                            }
-                        }
-                        target_height = h;
+                        break;
                     }
+                }
+                (*out_target_height) = h;
+            }
 
+            {
+                float const rcp_origin_aspect_ratio = static_cast<float>(origin_height) / static_cast<float>(origin_width);
+                float best_score = FLT_MAX;
+                for (uint32_t w = k_max_width_or_height; w > 0; w >>= 1)
+                {
+                    float const score = std::abs((static_cast<float>(*out_target_height) / static_cast<float>((w))) - rcp_origin_aspect_ratio);
+                    if (score < best_score)
                     {
-                        float const rcp_origin_aspect_ratio = static_cast<float>(origin_height) / static_cast<float>(origin_width);
-                        float best_score = FLT_MAX;
-                        for (uint32_t w = k_max_width_or_height; w > 0; w >>= 1)
-                        {
-                            float const score = std::abs((static_cast<float>(target_height) / static_cast<float>((w))) - rcp_origin_aspect_ratio);
-                            if (score < best_score)
-                            {
-                                best_score = score;
-                                target_width = w;
-                            }
-                        }
+                        best_score = score;
+                        (*out_target_width) = w;
                     }
                 }
             }
         }
-
-        if ((target_width == origin_width) && (target_height == origin_height))
-        {
-            out_rgba_data = std::move(origin_rgba_data);
-            (*out_width) = origin_width;
-            (*out_height) = origin_height;
-        }
-        else
-        {
-            // mediapipe/framework/formats/image_frame_opencv.cc
-            int const dims = 2;
-            int const origin_sizes[dims] = {static_cast<int>(origin_height), static_cast<int>(origin_width)};
-            int const type = CV_MAKETYPE(CV_8U, 4);
-            size_t const origin_stride = static_cast<size_t>(k_channel_size) * static_cast<size_t>(k_num_channels) * static_cast<uint64_t>(origin_width);
-            size_t const origin_steps[dims] = {origin_stride, 8U};
-
-            cv::Mat origin_image(dims, origin_sizes, type, reinterpret_cast<uint8_t *>(origin_rgba_data.data()), origin_steps);
-
-            cv::Mat target_image;
-            int const interpolation = ((target_width <= origin_width) && (target_height <= origin_height)) ? cv::INTER_AREA : cv::INTER_LANCZOS4;
-            cv::resize(origin_image, target_image, cv::Size(static_cast<int>(target_width), static_cast<int>(target_height)), 0.0, 0.0, interpolation);
-            assert(origin_image.isContinuous());
-
-            size_t const target_stride = static_cast<size_t>(k_channel_size) * static_cast<size_t>(k_num_channels) * static_cast<uint64_t>(target_width);
-            assert(target_image.type() == type);
-            assert(target_image.step[0] == target_stride);
-            assert(target_width == target_image.cols);
-            assert(target_height == target_image.rows);
-            assert(target_image.isContinuous());
-
-            out_rgba_data.resize(static_cast<size_t>(target_width) * static_cast<size_t>(target_height));
-            std::memcpy(out_rgba_data.data(), target_image.data, target_image.step[0] * target_image.rows);
-
-            (*out_width) = target_width;
-            (*out_height) = target_height;
-        }
     }
-
-    return status_internal_import_image;
 }
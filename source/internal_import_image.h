@@ -18,6 +18,7 @@
 #ifndef _INTERNAL_IMPORT_IMAGE_H_
 #define _INTERNAL_IMPORT_IMAGE_H_ 1
 
+#include "../include/import_asset_task_scheduler.h"
 #include "../../McRT-Malloc/include/mcrt_vector.h"
 #include <cstddef>
 #include <cstdint>
@@ -25,6 +26,19 @@
 // D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION	16384
 constexpr size_t const max_width_or_height = 16384;
 
+// read the header only and NO pixel is decoded (e.g. to allocate the memory before decoding)
+// the channel count is the count of the channels stored in the file (the decoded image is always RGBA8)
+// the target size is the size of the image returned by the "internal_import_image" (the non power of 2 image is resampled)
+extern bool internal_import_image_header(void const *data_base, size_t data_size, uint32_t *out_width, uint32_t *out_height, uint32_t *out_channel_count, uint32_t *out_target_width, uint32_t *out_target_height);
+
 extern bool internal_import_image(void const *data_base, size_t data_size, mcrt_vector<uint32_t> &out_rgba_data, uint32_t *out_width, uint32_t *out_height);
 
+// the non power of 2 image is resampled in the linear space when "srgb" is true
+extern bool internal_import_image(void const *data_base, size_t data_size, bool srgb, mcrt_vector<uint32_t> &out_rgba_data, uint32_t *out_width, uint32_t *out_height);
+
+// decode (and resample if the target size is NOT the same as the origin size) the RGBA8 pixels directly into the caller provided memory (e.g. the staging upload buffer)
+// the target size is usually returned by the "internal_import_image_header"
+// the JPEG with the restart markers is decoded in parallel on the "task_scheduler" (or on the calling thread if the "task_scheduler" is NULL)
+extern bool internal_import_image_into(void const *data_base, size_t data_size, bool srgb, uint32_t target_width, uint32_t target_height, void *out_rgba_data_base, size_t out_row_pitch, import_asset_task_scheduler *task_scheduler);
+
 #endif
\ No newline at end of file
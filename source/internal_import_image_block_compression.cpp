@@ -0,0 +1,908 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include "internal_import_image_block_compression.h"
+#include <assert.h>
+#include <cstring>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+// https://learn.microsoft.com/en-us/windows/win32/direct3d10/d3d10-graphics-programming-guide-resources-block-compression
+// https://learn.microsoft.com/en-us/windows/win32/direct3d11/bc7-format
+
+// the number of the rows of the blocks encoded by each task
+static constexpr uint32_t const k_block_rows_per_task = 4U;
+
+// the interpolation weights of the 2-bit, 3-bit and 4-bit indices
+static constexpr uint32_t const k_bc7_weights_2[4] = {0U, 21U, 43U, 64U};
+static constexpr uint32_t const k_bc7_weights_3[8] = {0U, 9U, 18U, 27U, 37U, 46U, 55U, 64U};
+static constexpr uint32_t const k_bc7_weights_4[16] = {0U, 4U, 9U, 13U, 17U, 21U, 26U, 30U, 34U, 38U, 43U, 47U, 51U, 55U, 60U, 64U};
+
+// the partitions of the two subsets (the bit "i" is set when the texel "i" belongs to the subset 1)
+static constexpr uint16_t const k_bc7_partition_masks_2[64] = {
+    0XCCCCU, 0X8888U, 0XEEEEU, 0XECC8U, 0XC880U, 0XFEECU, 0XFEC8U, 0XEC80U,
+    0XC800U, 0XFFECU, 0XFE80U, 0XE800U, 0XFFE8U, 0XFF00U, 0XFFF0U, 0XF000U,
+    0XF710U, 0X008EU, 0X7100U, 0X08CEU, 0X008CU, 0X7310U, 0X3100U, 0X8CCEU,
+    0X088CU, 0X3110U, 0X6666U, 0X366CU, 0X17E8U, 0X0FF0U, 0X718EU, 0X399CU,
+    0XAAAAU, 0XF0F0U, 0X5A5AU, 0X33CCU, 0X3C3CU, 0X55AAU, 0X9696U, 0XA55AU,
+    0X73CEU, 0X13C8U, 0X324CU, 0X3BDCU, 0X6996U, 0XC33CU, 0X9966U, 0X0660U,
+    0X0272U, 0X04E4U, 0X4E40U, 0X2720U, 0XC936U, 0X936CU, 0X39C6U, 0X639CU,
+    0X9336U, 0X9CC6U, 0X817EU, 0XE718U, 0XCCF0U, 0X0FCCU, 0X7744U, 0XEE22U,
+};
+
+// the anchor texel of the subset 1 (the anchor texel of the subset 0 is always the texel 0)
+static constexpr uint8_t const k_bc7_partition_anchors_2[64] = {
+    15U, 15U, 15U, 15U, 15U, 15U, 15U, 15U, 15U, 15U, 15U, 15U, 15U, 15U, 15U, 15U,
+    15U, 2U, 8U, 2U, 2U, 8U, 8U, 15U, 2U, 8U, 2U, 2U, 8U, 8U, 2U, 2U,
+    15U, 15U, 6U, 8U, 2U, 8U, 15U, 15U, 2U, 8U, 2U, 2U, 2U, 15U, 15U, 6U,
+    6U, 2U, 6U, 8U, 15U, 15U, 2U, 2U, 15U, 15U, 15U, 15U, 15U, 2U, 2U, 15U,
+};
+
+enum INTERNAL_BC7_P_BIT_MODE
+{
+    INTERNAL_BC7_P_BIT_MODE_NONE = 0,
+    INTERNAL_BC7_P_BIT_MODE_SHARED = 1,
+    INTERNAL_BC7_P_BIT_MODE_UNIQUE = 2
+};
+
+enum INTERNAL_BLOCK_COMPRESSION_MODE
+{
+    INTERNAL_BLOCK_COMPRESSION_MODE_BC1 = 0,
+    INTERNAL_BLOCK_COMPRESSION_MODE_BC4 = 1,
+    INTERNAL_BLOCK_COMPRESSION_MODE_BC5 = 2,
+    INTERNAL_BLOCK_COMPRESSION_MODE_BC7 = 3
+};
+
+struct internal_block_compress_context
+{
+    uint8_t const *rgba_data;
+    uint32_t width;
+    uint32_t height;
+    INTERNAL_BLOCK_COMPRESSION_MODE mode;
+    uint32_t block_size;
+    uint32_t block_count_x;
+    uint32_t block_count_y;
+    uint8_t *output_base;
+    uint32_t output_row_pitch;
+};
+
+static void internal_block_compress_task_function(uint32_t task_index, void *user_data);
+
+static inline void internal_load_block(uint8_t const *rgba_data, uint32_t width, uint32_t height, uint32_t block_x, uint32_t block_y, uint8_t (*pixels)[4]);
+
+static inline void internal_principal_axis(float const (*pixels)[4], uint32_t pixel_mask, uint32_t channel_begin, uint32_t channel_count, float *mean, float *axis);
+
+static inline void internal_encode_bc1_block(uint8_t const (*pixels)[4], uint8_t *block);
+
+static inline void internal_encode_bc4_block(uint8_t const (*pixels)[4], uint32_t channel_index, uint8_t *block);
+
+static inline void internal_encode_bc7_block(uint8_t const (*pixels)[4], uint8_t *block);
+
+static inline int32_t internal_encode_bc7_mode1(uint8_t const (*pixels)[4], float const (*pixels_float)[4], uint64_t *bits);
+
+static inline int32_t internal_encode_bc7_mode5(uint8_t const (*pixels)[4], float const (*pixels_float)[4], uint64_t *bits);
+
+static inline int32_t internal_encode_bc7_mode6(uint8_t const (*pixels)[4], float const (*pixels_float)[4], uint64_t *bits);
+
+static inline int32_t internal_encode_bc7_subset(uint8_t const (*pixels)[4], float const (*pixels_float)[4], uint32_t pixel_mask, uint32_t anchor_index, uint32_t channel_begin, uint32_t channel_count, uint32_t endpoint_bits, INTERNAL_BC7_P_BIT_MODE p_bit_mode, uint32_t index_bits, uint32_t (*endpoints_quantized)[4], uint32_t *p_bits, uint32_t *indices);
+
+static inline int32_t internal_fit_bc7_subset(uint8_t const (*pixels)[4], uint32_t pixel_mask, uint32_t channel_begin, uint32_t channel_count, uint32_t endpoint_bits, INTERNAL_BC7_P_BIT_MODE p_bit_mode, uint32_t index_bits, float const (*endpoints_float)[4], uint32_t (*endpoints_quantized)[4], uint32_t *p_bits, uint32_t *indices);
+
+static inline uint32_t internal_unquantize_bc7_endpoint(uint32_t value, uint32_t bit_count);
+
+static inline void internal_write_bits(uint64_t *bits, uint32_t *bit_offset, uint32_t value, uint32_t bit_count);
+
+extern bool internal_import_image_block_compress(uint32_t const *rgba_data, uint32_t width, uint32_t height, BRX_SAMPLED_ASSET_IMAGE_FORMAT format, void *staging_upload_buffer_base, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dest, import_asset_task_scheduler *task_scheduler)
+{
+    INTERNAL_BLOCK_COMPRESSION_MODE mode;
+    uint32_t block_size;
+    switch (format)
+    {
+    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        mode = INTERNAL_BLOCK_COMPRESSION_MODE_BC1;
+        block_size = 8U;
+        break;
+    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC4_UNORM_BLOCK:
+        mode = INTERNAL_BLOCK_COMPRESSION_MODE_BC4;
+        block_size = 8U;
+        break;
+    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC5_UNORM_BLOCK:
+        mode = INTERNAL_BLOCK_COMPRESSION_MODE_BC5;
+        block_size = 16U;
+        break;
+    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_UNORM_BLOCK:
+    case BRX_SAMPLED_ASSET_IMAGE_FORMAT_BC7_SRGB_BLOCK:
+        mode = INTERNAL_BLOCK_COMPRESSION_MODE_BC7;
+        block_size = 16U;
+        break;
+    default:
+        return false;
+    }
+
+    if ((0U == width) || (0U == height))
+    {
+        return false;
+    }
+
+    uint32_t const block_count_x = (width + 3U) / 4U;
+    uint32_t const block_count_y = (height + 3U) / 4U;
+
+    if ((subresource_memcpy_dest->output_row_size != (block_count_x * block_size)) || (subresource_memcpy_dest->output_row_count != block_count_y) || (subresource_memcpy_dest->output_row_pitch < subresource_memcpy_dest->output_row_size) || (1U != subresource_memcpy_dest->output_slice_count))
+    {
+        return false;
+    }
+
+    internal_block_compress_context context;
+    context.rgba_data = reinterpret_cast<uint8_t const *>(rgba_data);
+    context.width = width;
+    context.height = height;
+    context.mode = mode;
+    context.block_size = block_size;
+    context.block_count_x = block_count_x;
+    context.block_count_y = block_count_y;
+    context.output_base = static_cast<uint8_t *>(staging_upload_buffer_base) + subresource_memcpy_dest->staging_upload_buffer_offset;
+    context.output_row_pitch = subresource_memcpy_dest->output_row_pitch;
+
+    // the tasks are independent of each other since each task writes the different rows of the blocks
+    uint32_t const task_count = (block_count_y + (k_block_rows_per_task - 1U)) / k_block_rows_per_task;
+
+    if (NULL != task_scheduler)
+    {
+        task_scheduler->parallel_for(task_count, internal_block_compress_task_function, &context);
+    }
+    else
+    {
+        for (uint32_t task_index = 0U; task_index < task_count; ++task_index)
+        {
+            internal_block_compress_task_function(task_index, &context);
+        }
+    }
+
+    return true;
+}
+
+static void internal_block_compress_task_function(uint32_t task_index, void *user_data)
+{
+    internal_block_compress_context const *const context = static_cast<internal_block_compress_context const *>(user_data);
+
+    uint32_t const block_y_begin = task_index * k_block_rows_per_task;
+    uint32_t const block_y_end = std::min(block_y_begin + k_block_rows_per_task, context->block_count_y);
+
+    for (uint32_t block_y = block_y_begin; block_y < block_y_end; ++block_y)
+    {
+        uint8_t *const output_row = context->output_base + static_cast<size_t>(context->output_row_pitch) * block_y;
+
+        for (uint32_t block_x = 0U; block_x < context->block_count_x; ++block_x)
+        {
+            uint8_t pixels[16][4];
+            internal_load_block(context->rgba_data, context->width, context->height, block_x, block_y, pixels);
+
+            uint8_t *const block = output_row + static_cast<size_t>(context->block_size) * block_x;
+
+            switch (context->mode)
+            {
+            case INTERNAL_BLOCK_COMPRESSION_MODE_BC1:
+                internal_encode_bc1_block(pixels, block);
+                break;
+            case INTERNAL_BLOCK_COMPRESSION_MODE_BC4:
+                internal_encode_bc4_block(pixels, 0U, block);
+                break;
+            case INTERNAL_BLOCK_COMPRESSION_MODE_BC5:
+                internal_encode_bc4_block(pixels, 0U, block);
+                internal_encode_bc4_block(pixels, 1U, block + 8U);
+                break;
+            case INTERNAL_BLOCK_COMPRESSION_MODE_BC7:
+                internal_encode_bc7_block(pixels, block);
+                break;
+            default:
+                assert(false);
+            }
+        }
+    }
+}
+
+static inline void internal_load_block(uint8_t const *rgba_data, uint32_t width, uint32_t height, uint32_t block_x, uint32_t block_y, uint8_t (*pixels)[4])
+{
+    // the texels outside the image (when the width or height is NOT multiple of 4) replicate the edge
+    for (uint32_t y = 0U; y < 4U; ++y)
+    {
+        uint32_t const image_y = std::min(block_y * 4U + y, height - 1U);
+        for (uint32_t x = 0U; x < 4U; ++x)
+        {
+            uint32_t const image_x = std::min(block_x * 4U + x, width - 1U);
+            std::memcpy(pixels[y * 4U + x], rgba_data + (static_cast<size_t>(width) * image_y + image_x) * 4U, 4U);
+        }
+    }
+}
+
+static inline void internal_principal_axis(float const (*pixels)[4], uint32_t pixel_mask, uint32_t channel_begin, uint32_t channel_count, float *mean, float *axis)
+{
+    // only the texels of which the bit is set in the "pixel_mask" are used and the "mean" and the "axis" are relative to the "channel_begin"
+    float pixel_count = 0.0F;
+    for (uint32_t channel_index = 0U; channel_index < channel_count; ++channel_index)
+    {
+        mean[channel_index] = 0.0F;
+    }
+    for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+    {
+        if (0U != (pixel_mask & (1U << pixel_index)))
+        {
+            for (uint32_t channel_index = 0U; channel_index < channel_count; ++channel_index)
+            {
+                mean[channel_index] += pixels[pixel_index][channel_begin + channel_index];
+            }
+            pixel_count += 1.0F;
+        }
+    }
+    assert(pixel_count > 0.0F);
+    for (uint32_t channel_index = 0U; channel_index < channel_count; ++channel_index)
+    {
+        mean[channel_index] /= pixel_count;
+    }
+
+    float covariance[4][4] = {};
+    for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+    {
+        if (0U != (pixel_mask & (1U << pixel_index)))
+        {
+            for (uint32_t i = 0U; i < channel_count; ++i)
+            {
+                float const d_i = pixels[pixel_index][channel_begin + i] - mean[i];
+                for (uint32_t j = 0U; j < channel_count; ++j)
+                {
+                    covariance[i][j] += d_i * (pixels[pixel_index][channel_begin + j] - mean[j]);
+                }
+            }
+        }
+    }
+
+    // power iteration (the start vector is the diagonal of the covariance which is never orthogonal to the principal axis in practice)
+    for (uint32_t channel_index = 0U; channel_index < channel_count; ++channel_index)
+    {
+        axis[channel_index] = covariance[channel_index][channel_index];
+    }
+
+    for (uint32_t iteration = 0U; iteration < 8U; ++iteration)
+    {
+        float new_axis[4] = {};
+        for (uint32_t i = 0U; i < channel_count; ++i)
+        {
+            for (uint32_t j = 0U; j < channel_count; ++j)
+            {
+                new_axis[i] += covariance[i][j] * axis[j];
+            }
+        }
+
+        float length_square = 0.0F;
+        for (uint32_t channel_index = 0U; channel_index < channel_count; ++channel_index)
+        {
+            length_square += new_axis[channel_index] * new_axis[channel_index];
+        }
+
+        if (length_square < 1E-12F)
+        {
+            break;
+        }
+
+        float const rcp_length = 1.0F / std::sqrt(length_square);
+        for (uint32_t channel_index = 0U; channel_index < channel_count; ++channel_index)
+        {
+            axis[channel_index] = new_axis[channel_index] * rcp_length;
+        }
+    }
+}
+
+static inline uint16_t internal_quantize_rgb565(float const *color)
+{
+    uint32_t const r = static_cast<uint32_t>(std::min(std::max(color[0] * (31.0F / 255.0F) + 0.5F, 0.0F), 31.0F));
+    uint32_t const g = static_cast<uint32_t>(std::min(std::max(color[1] * (63.0F / 255.0F) + 0.5F, 0.0F), 63.0F));
+    uint32_t const b = static_cast<uint32_t>(std::min(std::max(color[2] * (31.0F / 255.0F) + 0.5F, 0.0F), 31.0F));
+    return static_cast<uint16_t>((r << 11U) | (g << 5U) | b);
+}
+
+static inline void internal_unquantize_rgb565(uint16_t color, uint32_t *rgb)
+{
+    uint32_t const r = (color >> 11U) & 0X1FU;
+    uint32_t const g = (color >> 5U) & 0X3FU;
+    uint32_t const b = color & 0X1FU;
+    rgb[0] = (r << 3U) | (r >> 2U);
+    rgb[1] = (g << 2U) | (g >> 4U);
+    rgb[2] = (b << 3U) | (b >> 2U);
+}
+
+static inline void internal_encode_bc1_block(uint8_t const (*pixels)[4], uint8_t *block)
+{
+    float pixels_float[16][4];
+    bool has_transparent = false;
+    for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+    {
+        for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+        {
+            pixels_float[pixel_index][channel_index] = static_cast<float>(pixels[pixel_index][channel_index]);
+        }
+        has_transparent = has_transparent || (pixels[pixel_index][3] < 128U);
+    }
+
+    float mean[4];
+    float axis[4];
+    internal_principal_axis(pixels_float, 0XFFFFU, 0U, 3U, mean, axis);
+
+    // the endpoints are the extents of the projections of the opaque texels onto the principal axis
+    float min_t = 0.0F;
+    float max_t = 0.0F;
+    for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+    {
+        if ((!has_transparent) || (pixels[pixel_index][3] >= 128U))
+        {
+            float const t = (pixels_float[pixel_index][0] - mean[0]) * axis[0] + (pixels_float[pixel_index][1] - mean[1]) * axis[1] + (pixels_float[pixel_index][2] - mean[2]) * axis[2];
+            min_t = std::min(min_t, t);
+            max_t = std::max(max_t, t);
+        }
+    }
+
+    float endpoint_0[3];
+    float endpoint_1[3];
+    for (uint32_t channel_index = 0U; channel_index < 3U; ++channel_index)
+    {
+        endpoint_0[channel_index] = mean[channel_index] + axis[channel_index] * max_t;
+        endpoint_1[channel_index] = mean[channel_index] + axis[channel_index] * min_t;
+    }
+
+    uint16_t color_0 = internal_quantize_rgb565(endpoint_0);
+    uint16_t color_1 = internal_quantize_rgb565(endpoint_1);
+
+    // four colors if "color_0 > color_1" and three colors with the transparent black otherwise
+    if (has_transparent ? (color_0 > color_1) : (color_0 < color_1))
+    {
+        std::swap(color_0, color_1);
+    }
+
+    uint32_t palette[4][3];
+    internal_unquantize_rgb565(color_0, palette[0]);
+    internal_unquantize_rgb565(color_1, palette[1]);
+    uint32_t palette_count;
+    if (color_0 > color_1)
+    {
+        for (uint32_t channel_index = 0U; channel_index < 3U; ++channel_index)
+        {
+            palette[2][channel_index] = (2U * palette[0][channel_index] + palette[1][channel_index] + 1U) / 3U;
+            palette[3][channel_index] = (palette[0][channel_index] + 2U * palette[1][channel_index] + 1U) / 3U;
+        }
+        palette_count = 4U;
+    }
+    else
+    {
+        for (uint32_t channel_index = 0U; channel_index < 3U; ++channel_index)
+        {
+            palette[2][channel_index] = (palette[0][channel_index] + palette[1][channel_index]) / 2U;
+            palette[3][channel_index] = 0U;
+        }
+        palette_count = 3U;
+    }
+
+    uint32_t indices = 0U;
+    for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+    {
+        uint32_t best_index;
+        if (has_transparent && (pixels[pixel_index][3] < 128U))
+        {
+            best_index = 3U;
+        }
+        else
+        {
+            best_index = 0U;
+            int32_t best_error = INT32_MAX;
+            for (uint32_t palette_index = 0U; palette_index < palette_count; ++palette_index)
+            {
+                int32_t error = 0;
+                for (uint32_t channel_index = 0U; channel_index < 3U; ++channel_index)
+                {
+                    int32_t const d = static_cast<int32_t>(pixels[pixel_index][channel_index]) - static_cast<int32_t>(palette[palette_index][channel_index]);
+                    error += d * d;
+                }
+
+                if (error < best_error)
+                {
+                    best_error = error;
+                    best_index = palette_index;
+                }
+            }
+        }
+
+        indices |= (best_index << (2U * pixel_index));
+    }
+
+    block[0] = static_cast<uint8_t>(color_0 & 0XFFU);
+    block[1] = static_cast<uint8_t>(color_0 >> 8U);
+    block[2] = static_cast<uint8_t>(color_1 & 0XFFU);
+    block[3] = static_cast<uint8_t>(color_1 >> 8U);
+    block[4] = static_cast<uint8_t>(indices & 0XFFU);
+    block[5] = static_cast<uint8_t>((indices >> 8U) & 0XFFU);
+    block[6] = static_cast<uint8_t>((indices >> 16U) & 0XFFU);
+    block[7] = static_cast<uint8_t>(indices >> 24U);
+}
+
+static inline void internal_encode_bc4_block(uint8_t const (*pixels)[4], uint32_t channel_index, uint8_t *block)
+{
+    uint32_t min_value = 255U;
+    uint32_t max_value = 0U;
+    for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+    {
+        min_value = std::min(min_value, static_cast<uint32_t>(pixels[pixel_index][channel_index]));
+        max_value = std::max(max_value, static_cast<uint32_t>(pixels[pixel_index][channel_index]));
+    }
+
+    // eight values if "value_0 > value_1" (when all values are the same, the index 0 is used for all texels)
+    uint32_t const value_0 = max_value;
+    uint32_t const value_1 = min_value;
+
+    uint32_t palette[8];
+    palette[0] = value_0;
+    palette[1] = value_1;
+    for (uint32_t palette_index = 2U; palette_index < 8U; ++palette_index)
+    {
+        palette[palette_index] = ((8U - palette_index) * value_0 + (palette_index - 1U) * value_1 + 3U) / 7U;
+    }
+
+    uint64_t indices = 0U;
+    if (value_0 > value_1)
+    {
+        for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+        {
+            uint32_t best_index = 0U;
+            uint32_t best_error = UINT32_MAX;
+            for (uint32_t palette_index = 0U; palette_index < 8U; ++palette_index)
+            {
+                uint32_t const value = pixels[pixel_index][channel_index];
+                uint32_t const error = (value > palette[palette_index]) ? (value - palette[palette_index]) : (palette[palette_index] - value);
+                if (error < best_error)
+                {
+                    best_error = error;
+                    best_index = palette_index;
+                }
+            }
+
+            indices |= (static_cast<uint64_t>(best_index) << (3U * pixel_index));
+        }
+    }
+
+    block[0] = static_cast<uint8_t>(value_0);
+    block[1] = static_cast<uint8_t>(value_1);
+    for (uint32_t byte_index = 0U; byte_index < 6U; ++byte_index)
+    {
+        block[2U + byte_index] = static_cast<uint8_t>((indices >> (8U * byte_index)) & 0XFFU);
+    }
+}
+
+static inline void internal_encode_bc7_block(uint8_t const (*pixels)[4], uint8_t *block)
+{
+    // the mode 6 (one subset, RGBA 7.7.7.7 endpoints with the unique p-bit and 4-bit indices) is always tried
+    // the mode 1 (two subsets, RGB 6.6.6 endpoints with the shared p-bit and 3-bit indices) is also tried for the opaque blocks (e.g. the edges)
+    // the mode 5 (one subset, RGB 7.7.7 endpoints and 8-bit alpha endpoints with separate 2-bit indices) is also tried for the other blocks (e.g. the alpha which is NOT correlated with the color)
+    // the modes 0, 2, 3, 4 and 7, the partitions of the three subsets and the channel rotations of the modes 4 and 5 are NOT used
+    float pixels_float[16][4];
+    bool opaque = true;
+    for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+    {
+        for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+        {
+            pixels_float[pixel_index][channel_index] = static_cast<float>(pixels[pixel_index][channel_index]);
+        }
+        opaque = opaque && (255U == pixels[pixel_index][3]);
+    }
+
+    uint64_t bits[2];
+    int32_t const error = internal_encode_bc7_mode6(pixels, pixels_float, bits);
+
+    if (error > 0)
+    {
+        uint64_t candidate_bits[2];
+        int32_t const candidate_error = opaque ? internal_encode_bc7_mode1(pixels, pixels_float, candidate_bits) : internal_encode_bc7_mode5(pixels, pixels_float, candidate_bits);
+
+        if (candidate_error < error)
+        {
+            bits[0] = candidate_bits[0];
+            bits[1] = candidate_bits[1];
+        }
+    }
+
+    // the bits are stored from the least significant bit of the first byte
+    for (uint32_t byte_index = 0U; byte_index < 16U; ++byte_index)
+    {
+        block[byte_index] = static_cast<uint8_t>((bits[byte_index >> 3U] >> (8U * (byte_index & 7U))) & 0XFFU);
+    }
+}
+
+static inline int32_t internal_encode_bc7_mode1(uint8_t const (*pixels)[4], float const (*pixels_float)[4], uint64_t *bits)
+{
+    // the partition is selected by the error estimated by the principal axis of each subset (the variance which is NOT along the principal axis)
+    uint32_t best_partition_index = 0U;
+    float best_estimated_error = FLT_MAX;
+    for (uint32_t partition_index = 0U; partition_index < 64U; ++partition_index)
+    {
+        float estimated_error = 0.0F;
+        for (uint32_t subset_index = 0U; subset_index < 2U; ++subset_index)
+        {
+            uint32_t const pixel_mask = (0U == subset_index) ? (0XFFFFU & (~static_cast<uint32_t>(k_bc7_partition_masks_2[partition_index]))) : static_cast<uint32_t>(k_bc7_partition_masks_2[partition_index]);
+
+            float mean[3];
+            float axis[3];
+            internal_principal_axis(pixels_float, pixel_mask, 0U, 3U, mean, axis);
+
+            for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+            {
+                if (0U != (pixel_mask & (1U << pixel_index)))
+                {
+                    float length_square = 0.0F;
+                    float t = 0.0F;
+                    for (uint32_t channel_index = 0U; channel_index < 3U; ++channel_index)
+                    {
+                        float const d = pixels_float[pixel_index][channel_index] - mean[channel_index];
+                        length_square += d * d;
+                        t += d * axis[channel_index];
+                    }
+                    estimated_error += (length_square - t * t);
+                }
+            }
+        }
+
+        if (estimated_error < best_estimated_error)
+        {
+            best_estimated_error = estimated_error;
+            best_partition_index = partition_index;
+        }
+    }
+
+    uint32_t const subset_1_mask = k_bc7_partition_masks_2[best_partition_index];
+    uint32_t const subset_0_mask = 0XFFFFU & (~subset_1_mask);
+    uint32_t const subset_1_anchor_index = k_bc7_partition_anchors_2[best_partition_index];
+
+    uint32_t endpoints_quantized[4][4];
+    uint32_t p_bits[4];
+    uint32_t indices[16];
+    int32_t error = 0;
+    error += internal_encode_bc7_subset(pixels, pixels_float, subset_0_mask, 0U, 0U, 3U, 6U, INTERNAL_BC7_P_BIT_MODE_SHARED, 3U, &endpoints_quantized[0], &p_bits[0], indices);
+    error += internal_encode_bc7_subset(pixels, pixels_float, subset_1_mask, subset_1_anchor_index, 0U, 3U, 6U, INTERNAL_BC7_P_BIT_MODE_SHARED, 3U, &endpoints_quantized[2], &p_bits[2], indices);
+
+    bits[0] = 0U;
+    bits[1] = 0U;
+    uint32_t bit_offset = 0U;
+
+    // mode 1: one zero bit followed by one bit
+    internal_write_bits(bits, &bit_offset, 1U << 1U, 2U);
+
+    internal_write_bits(bits, &bit_offset, best_partition_index, 6U);
+
+    for (uint32_t channel_index = 0U; channel_index < 3U; ++channel_index)
+    {
+        for (uint32_t endpoint_index = 0U; endpoint_index < 4U; ++endpoint_index)
+        {
+            internal_write_bits(bits, &bit_offset, endpoints_quantized[endpoint_index][channel_index], 6U);
+        }
+    }
+
+    // the p-bit is shared by both endpoints of each subset
+    internal_write_bits(bits, &bit_offset, p_bits[0], 1U);
+    internal_write_bits(bits, &bit_offset, p_bits[2], 1U);
+
+    for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+    {
+        internal_write_bits(bits, &bit_offset, indices[pixel_index], ((0U == pixel_index) || (subset_1_anchor_index == pixel_index)) ? 2U : 3U);
+    }
+
+    assert(128U == bit_offset);
+
+    // the alpha is always decoded as 255 (the block is opaque)
+    return error;
+}
+
+static inline int32_t internal_encode_bc7_mode5(uint8_t const (*pixels)[4], float const (*pixels_float)[4], uint64_t *bits)
+{
+    uint32_t color_endpoints_quantized[2][4];
+    uint32_t color_p_bits[2];
+    uint32_t color_indices[16];
+    int32_t error = internal_encode_bc7_subset(pixels, pixels_float, 0XFFFFU, 0U, 0U, 3U, 7U, INTERNAL_BC7_P_BIT_MODE_NONE, 2U, color_endpoints_quantized, color_p_bits, color_indices);
+
+    uint32_t alpha_endpoints_quantized[2][4];
+    uint32_t alpha_p_bits[2];
+    uint32_t alpha_indices[16];
+    error += internal_encode_bc7_subset(pixels, pixels_float, 0XFFFFU, 0U, 3U, 1U, 8U, INTERNAL_BC7_P_BIT_MODE_NONE, 2U, alpha_endpoints_quantized, alpha_p_bits, alpha_indices);
+
+    bits[0] = 0U;
+    bits[1] = 0U;
+    uint32_t bit_offset = 0U;
+
+    // mode 5: five zero bits followed by one bit
+    internal_write_bits(bits, &bit_offset, 1U << 5U, 6U);
+
+    // rotation 0: the alpha is NOT swapped with any color channel
+    internal_write_bits(bits, &bit_offset, 0U, 2U);
+
+    for (uint32_t channel_index = 0U; channel_index < 3U; ++channel_index)
+    {
+        internal_write_bits(bits, &bit_offset, color_endpoints_quantized[0][channel_index], 7U);
+        internal_write_bits(bits, &bit_offset, color_endpoints_quantized[1][channel_index], 7U);
+    }
+
+    internal_write_bits(bits, &bit_offset, alpha_endpoints_quantized[0][3], 8U);
+    internal_write_bits(bits, &bit_offset, alpha_endpoints_quantized[1][3], 8U);
+
+    for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+    {
+        internal_write_bits(bits, &bit_offset, color_indices[pixel_index], (0U == pixel_index) ? 1U : 2U);
+    }
+
+    for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+    {
+        internal_write_bits(bits, &bit_offset, alpha_indices[pixel_index], (0U == pixel_index) ? 1U : 2U);
+    }
+
+    assert(128U == bit_offset);
+
+    return error;
+}
+
+static inline int32_t internal_encode_bc7_mode6(uint8_t const (*pixels)[4], float const (*pixels_float)[4], uint64_t *bits)
+{
+    uint32_t endpoints_quantized[2][4];
+    uint32_t p_bits[2];
+    uint32_t indices[16];
+    int32_t const error = internal_encode_bc7_subset(pixels, pixels_float, 0XFFFFU, 0U, 0U, 4U, 7U, INTERNAL_BC7_P_BIT_MODE_UNIQUE, 4U, endpoints_quantized, p_bits, indices);
+
+    bits[0] = 0U;
+    bits[1] = 0U;
+    uint32_t bit_offset = 0U;
+
+    // mode 6: six zero bits followed by one bit
+    internal_write_bits(bits, &bit_offset, 1U << 6U, 7U);
+
+    for (uint32_t channel_index = 0U; channel_index < 4U; ++channel_index)
+    {
+        internal_write_bits(bits, &bit_offset, endpoints_quantized[0][channel_index], 7U);
+        internal_write_bits(bits, &bit_offset, endpoints_quantized[1][channel_index], 7U);
+    }
+
+    internal_write_bits(bits, &bit_offset, p_bits[0], 1U);
+    internal_write_bits(bits, &bit_offset, p_bits[1], 1U);
+
+    for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+    {
+        internal_write_bits(bits, &bit_offset, indices[pixel_index], (0U == pixel_index) ? 3U : 4U);
+    }
+
+    assert(128U == bit_offset);
+
+    return error;
+}
+
+static inline int32_t internal_encode_bc7_subset(uint8_t const (*pixels)[4], float const (*pixels_float)[4], uint32_t pixel_mask, uint32_t anchor_index, uint32_t channel_begin, uint32_t channel_count, uint32_t endpoint_bits, INTERNAL_BC7_P_BIT_MODE p_bit_mode, uint32_t index_bits, uint32_t (*endpoints_quantized)[4], uint32_t *p_bits, uint32_t *indices)
+{
+    // the endpoints are initialized by the extent of the texels along the principal axis
+    float mean[4];
+    float axis[4];
+    internal_principal_axis(pixels_float, pixel_mask, channel_begin, channel_count, mean, axis);
+
+    float min_t = 0.0F;
+    float max_t = 0.0F;
+    for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+    {
+        if (0U != (pixel_mask & (1U << pixel_index)))
+        {
+            float t = 0.0F;
+            for (uint32_t channel_index = 0U; channel_index < channel_count; ++channel_index)
+            {
+                t += (pixels_float[pixel_index][channel_begin + channel_index] - mean[channel_index]) * axis[channel_index];
+            }
+            min_t = std::min(min_t, t);
+            max_t = std::max(max_t, t);
+        }
+    }
+
+    float endpoints_float[2][4];
+    for (uint32_t channel_index = 0U; channel_index < channel_count; ++channel_index)
+    {
+        endpoints_float[0][channel_begin + channel_index] = mean[channel_index] + axis[channel_index] * min_t;
+        endpoints_float[1][channel_begin + channel_index] = mean[channel_index] + axis[channel_index] * max_t;
+    }
+
+    int32_t error = internal_fit_bc7_subset(pixels, pixel_mask, channel_begin, channel_count, endpoint_bits, p_bit_mode, index_bits, endpoints_float, endpoints_quantized, p_bits, indices);
+
+    uint32_t const *const weights = (2U == index_bits) ? k_bc7_weights_2 : ((3U == index_bits) ? k_bc7_weights_3 : k_bc7_weights_4);
+
+    // refine the endpoints by the least squares with the indices fixed
+    if (error > 0)
+    {
+        float a = 0.0F;
+        float b = 0.0F;
+        float c = 0.0F;
+        float rx_0[4] = {};
+        float rx_1[4] = {};
+        for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+        {
+            if (0U != (pixel_mask & (1U << pixel_index)))
+            {
+                float const w = static_cast<float>(weights[indices[pixel_index]]) * (1.0F / 64.0F);
+                a += (1.0F - w) * (1.0F - w);
+                b += (1.0F - w) * w;
+                c += w * w;
+                for (uint32_t channel_index = channel_begin; channel_index < (channel_begin + channel_count); ++channel_index)
+                {
+                    rx_0[channel_index] += (1.0F - w) * pixels_float[pixel_index][channel_index];
+                    rx_1[channel_index] += w * pixels_float[pixel_index][channel_index];
+                }
+            }
+        }
+
+        float const determinant = a * c - b * b;
+        if (std::abs(determinant) > 1E-6F)
+        {
+            float const rcp_determinant = 1.0F / determinant;
+            float refined_endpoints_float[2][4];
+            for (uint32_t channel_index = channel_begin; channel_index < (channel_begin + channel_count); ++channel_index)
+            {
+                refined_endpoints_float[0][channel_index] = (c * rx_0[channel_index] - b * rx_1[channel_index]) * rcp_determinant;
+                refined_endpoints_float[1][channel_index] = (a * rx_1[channel_index] - b * rx_0[channel_index]) * rcp_determinant;
+            }
+
+            uint32_t refined_endpoints_quantized[2][4];
+            uint32_t refined_p_bits[2];
+            uint32_t refined_indices[16];
+            std::memcpy(refined_indices, indices, sizeof(refined_indices));
+            int32_t const refined_error = internal_fit_bc7_subset(pixels, pixel_mask, channel_begin, channel_count, endpoint_bits, p_bit_mode, index_bits, refined_endpoints_float, refined_endpoints_quantized, refined_p_bits, refined_indices);
+
+            if (refined_error < error)
+            {
+                error = refined_error;
+                std::memcpy(endpoints_quantized, refined_endpoints_quantized, sizeof(refined_endpoints_quantized));
+                std::memcpy(p_bits, refined_p_bits, sizeof(refined_p_bits));
+                std::memcpy(indices, refined_indices, sizeof(refined_indices));
+            }
+        }
+    }
+
+    // the most significant bit of the index of the anchor texel is implicitly zero
+    uint32_t const max_index = (1U << index_bits) - 1U;
+    if (0U != (indices[anchor_index] & (1U << (index_bits - 1U))))
+    {
+        for (uint32_t channel_index = channel_begin; channel_index < (channel_begin + channel_count); ++channel_index)
+        {
+            std::swap(endpoints_quantized[0][channel_index], endpoints_quantized[1][channel_index]);
+        }
+        std::swap(p_bits[0], p_bits[1]);
+
+        for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+        {
+            if (0U != (pixel_mask & (1U << pixel_index)))
+            {
+                indices[pixel_index] = max_index - indices[pixel_index];
+            }
+        }
+    }
+
+    return error;
+}
+
+static inline int32_t internal_fit_bc7_subset(uint8_t const (*pixels)[4], uint32_t pixel_mask, uint32_t channel_begin, uint32_t channel_count, uint32_t endpoint_bits, INTERNAL_BC7_P_BIT_MODE p_bit_mode, uint32_t index_bits, float const (*endpoints_float)[4], uint32_t (*endpoints_quantized)[4], uint32_t *p_bits, uint32_t *indices)
+{
+    // quantize each endpoint to "endpoint_bits" bits per channel and choose the p-bit (if any) with the lower error
+    // only the channels [channel_begin, channel_begin + channel_count) and the texels of which the bit is set in the "pixel_mask" are written
+    uint32_t const bit_count = endpoint_bits + ((INTERNAL_BC7_P_BIT_MODE_NONE != p_bit_mode) ? 1U : 0U);
+    uint32_t const max_quantized = (1U << endpoint_bits) - 1U;
+    float const scale = static_cast<float>((1U << bit_count) - 1U) * (1.0F / 255.0F);
+    uint32_t const p_bit_count = (INTERNAL_BC7_P_BIT_MODE_NONE != p_bit_mode) ? 2U : 1U;
+
+    float best_errors[2] = {FLT_MAX, FLT_MAX};
+    uint32_t endpoints[2][4];
+    for (uint32_t p_bit = 0U; p_bit < p_bit_count; ++p_bit)
+    {
+        uint32_t quantized[2][4];
+        float errors[2] = {0.0F, 0.0F};
+        for (uint32_t endpoint_index = 0U; endpoint_index < 2U; ++endpoint_index)
+        {
+            for (uint32_t channel_index = channel_begin; channel_index < (channel_begin + channel_count); ++channel_index)
+            {
+                float const endpoint = std::min(std::max(endpoints_float[endpoint_index][channel_index], 0.0F), 255.0F) * scale;
+                float const value = (INTERNAL_BC7_P_BIT_MODE_NONE != p_bit_mode) ? ((endpoint - static_cast<float>(p_bit)) * 0.5F) : endpoint;
+                quantized[endpoint_index][channel_index] = static_cast<uint32_t>(std::min(std::max(value + 0.5F, 0.0F), static_cast<float>(max_quantized)));
+
+                uint32_t const with_p_bit = (INTERNAL_BC7_P_BIT_MODE_NONE != p_bit_mode) ? ((quantized[endpoint_index][channel_index] << 1U) | p_bit) : quantized[endpoint_index][channel_index];
+                float const d = static_cast<float>(internal_unquantize_bc7_endpoint(with_p_bit, bit_count)) - std::min(std::max(endpoints_float[endpoint_index][channel_index], 0.0F), 255.0F);
+                errors[endpoint_index] += d * d;
+            }
+        }
+
+        // the shared p-bit is chosen by the sum of the errors of both endpoints
+        if (INTERNAL_BC7_P_BIT_MODE_SHARED == p_bit_mode)
+        {
+            errors[0] += errors[1];
+            errors[1] = errors[0];
+        }
+
+        for (uint32_t endpoint_index = 0U; endpoint_index < 2U; ++endpoint_index)
+        {
+            if (errors[endpoint_index] < best_errors[endpoint_index])
+            {
+                best_errors[endpoint_index] = errors[endpoint_index];
+                p_bits[endpoint_index] = (INTERNAL_BC7_P_BIT_MODE_NONE != p_bit_mode) ? p_bit : 0U;
+                for (uint32_t channel_index = channel_begin; channel_index < (channel_begin + channel_count); ++channel_index)
+                {
+                    endpoints_quantized[endpoint_index][channel_index] = quantized[endpoint_index][channel_index];
+                    uint32_t const with_p_bit = (INTERNAL_BC7_P_BIT_MODE_NONE != p_bit_mode) ? ((quantized[endpoint_index][channel_index] << 1U) | p_bit) : quantized[endpoint_index][channel_index];
+                    endpoints[endpoint_index][channel_index] = internal_unquantize_bc7_endpoint(with_p_bit, bit_count);
+                }
+            }
+        }
+    }
+
+    uint32_t const *const weights = (2U == index_bits) ? k_bc7_weights_2 : ((3U == index_bits) ? k_bc7_weights_3 : k_bc7_weights_4);
+    uint32_t const palette_count = 1U << index_bits;
+
+    uint32_t palette[16][4];
+    for (uint32_t palette_index = 0U; palette_index < palette_count; ++palette_index)
+    {
+        for (uint32_t channel_index = channel_begin; channel_index < (channel_begin + channel_count); ++channel_index)
+        {
+            palette[palette_index][channel_index] = ((64U - weights[palette_index]) * endpoints[0][channel_index] + weights[palette_index] * endpoints[1][channel_index] + 32U) >> 6U;
+        }
+    }
+
+    int32_t total_error = 0;
+    for (uint32_t pixel_index = 0U; pixel_index < 16U; ++pixel_index)
+    {
+        if (0U != (pixel_mask & (1U << pixel_index)))
+        {
+            uint32_t best_index = 0U;
+            int32_t best_error = INT32_MAX;
+            for (uint32_t palette_index = 0U; palette_index < palette_count; ++palette_index)
+            {
+                int32_t error = 0;
+                for (uint32_t channel_index = channel_begin; channel_index < (channel_begin + channel_count); ++channel_index)
+                {
+                    int32_t const d = static_cast<int32_t>(pixels[pixel_index][channel_index]) - static_cast<int32_t>(palette[palette_index][channel_index]);
+                    error += d * d;
+                }
+
+                if (error < best_error)
+                {
+                    best_error = error;
+                    best_index = palette_index;
+                }
+            }
+            indices[pixel_index] = best_index;
+            total_error += best_error;
+        }
+    }
+
+    return total_error;
+}
+
+static inline uint32_t internal_unquantize_bc7_endpoint(uint32_t value, uint32_t bit_count)
+{
+    // the endpoint (including the p-bit) is expanded to 8 bits by replicating the most significant bits
+    assert((bit_count >= 5U) && (bit_count <= 8U));
+    return (8U == bit_count) ? value : (((value << (8U - bit_count)) | (value >> (2U * bit_count - 8U))) & 0XFFU);
+}
+
+static inline void internal_write_bits(uint64_t *bits, uint32_t *bit_offset, uint32_t value, uint32_t bit_count)
+{
+    for (uint32_t bit_index = 0U; bit_index < bit_count; ++bit_index)
+    {
+        bits[(*bit_offset) >> 6U] |= (static_cast<uint64_t>((value >> bit_index) & 1U) << ((*bit_offset) & 63U));
+        ++(*bit_offset);
+    }
+}
@@ -0,0 +1,31 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _INTERNAL_IMPORT_IMAGE_BLOCK_COMPRESSION_H_
+#define _INTERNAL_IMPORT_IMAGE_BLOCK_COMPRESSION_H_ 1
+
+#include "../include/import_image_asset.h"
+#include <cstddef>
+#include <cstdint>
+
+// encode the RGBA8 image (e.g. decoded by "internal_import_image") into the block compressed format and write the blocks into the "subresource_memcpy_dest"
+// the "format" should be one of BC1 (color with 1-bit alpha), BC4 (single channel, the red channel is used), BC5 (two channels, e.g. the normal map, the red and green channels are used) and BC7 (color)
+// the BC7 blocks are encoded by the mode 6 or by the mode 1 (the opaque blocks, two subsets) or the mode 5 (the other blocks, separate alpha) whichever has the lower error (the other modes and the channel rotations are NOT used)
+// the rows of the blocks are encoded in parallel on the "task_scheduler" (or on the calling thread if the "task_scheduler" is NULL)
+extern bool internal_import_image_block_compress(uint32_t const *rgba_data, uint32_t width, uint32_t height, BRX_SAMPLED_ASSET_IMAGE_FORMAT format, void *staging_upload_buffer_base, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dest, import_asset_task_scheduler *task_scheduler);
+
+#endif
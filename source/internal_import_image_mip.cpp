@@ -0,0 +1,294 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include "internal_import_image_mip.h"
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#endif
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+#include <assert.h>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include "../../McRT-Malloc/include/mcrt_vector.h"
+
+// DirectXTex/DirectXTexMipmaps.cpp
+// NVIDIA Texture Tools: nvimage/Filter.cpp
+
+// the destination texel "i" is filtered from the source texels "2 * i + offset"
+struct internal_mip_filter_tap
+{
+    int32_t offset;
+    float weight;
+};
+
+// Kaiser-windowed sinc: the width is 3 destination texels (6 source texels) on each side and the alpha is 4
+static constexpr uint32_t const k_kaiser_tap_count = 12U;
+static constexpr float const k_kaiser_width = 3.0F;
+static constexpr float const k_kaiser_alpha = 4.0F;
+
+// the horizontally filtered rows which may be used by the following destination rows are cached (at least the tap count)
+static constexpr uint32_t const k_row_cache_count = 16U;
+
+static inline uint32_t internal_mip_filter_taps(INTERNAL_IMPORT_IMAGE_MIP_FILTER filter, uint32_t source_size, internal_mip_filter_tap *taps);
+
+static inline void internal_load_row(uint8_t const *source_row, uint32_t width, bool srgb, DirectX::XMVECTOR *row);
+
+static inline void internal_store_row(DirectX::XMVECTOR const *row, uint32_t width, bool srgb, uint8_t *destination_row);
+
+extern uint32_t internal_import_image_mip_levels(uint32_t width, uint32_t height)
+{
+    uint32_t mip_levels = 1U;
+    uint32_t size = std::max(width, height);
+    while (size > 1U)
+    {
+        size >>= 1U;
+        ++mip_levels;
+    }
+    return mip_levels;
+}
+
+extern bool internal_import_image_generate_mips(uint32_t const *rgba_data, uint32_t width, uint32_t height, bool srgb, INTERNAL_IMPORT_IMAGE_MIP_FILTER filter, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests)
+{
+    if ((0U == width) || (0U == height) || (0U == subresource_count) || (subresource_count > internal_import_image_mip_levels(width, height)))
+    {
+        return false;
+    }
+
+    uint32_t const mip_levels = static_cast<uint32_t>(subresource_count);
+
+    for (uint32_t mip_level = 0U; mip_level < mip_levels; ++mip_level)
+    {
+        uint32_t const mip_width = std::max(width >> mip_level, 1U);
+        uint32_t const mip_height = std::max(height >> mip_level, 1U);
+
+        BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const &subresource_memcpy_dest = subresource_memcpy_dests[brx_sampled_asset_image_import_calculate_subresource_index(mip_level, 0U, 0U, mip_levels, 1U)];
+        if ((subresource_memcpy_dest.output_row_size != (sizeof(uint32_t) * mip_width)) || (subresource_memcpy_dest.output_row_count != mip_height) || (subresource_memcpy_dest.output_row_pitch < subresource_memcpy_dest.output_row_size) || (1U != subresource_memcpy_dest.output_slice_count))
+        {
+            return false;
+        }
+    }
+
+    // mip level 0
+    {
+        BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const &subresource_memcpy_dest = subresource_memcpy_dests[brx_sampled_asset_image_import_calculate_subresource_index(0U, 0U, 0U, mip_levels, 1U)];
+        for (uint32_t y = 0U; y < height; ++y)
+        {
+            std::memcpy(static_cast<uint8_t *>(staging_upload_buffer_base) + subresource_memcpy_dest.staging_upload_buffer_offset + static_cast<size_t>(subresource_memcpy_dest.output_row_pitch) * y, rgba_data + static_cast<size_t>(width) * y, sizeof(uint32_t) * width);
+        }
+    }
+
+    if (mip_levels <= 1U)
+    {
+        return true;
+    }
+
+    // the previous mip level is read from the private memory (the staging upload buffer is usually the write-combined memory which is very slow to read)
+    mcrt_vector<uint32_t> mip_data[2];
+    mip_data[0].resize(static_cast<size_t>(std::max(width >> 1U, 1U)) * static_cast<size_t>(std::max(height >> 1U, 1U)));
+    if (mip_levels > 2U)
+    {
+        mip_data[1].resize(static_cast<size_t>(std::max(width >> 2U, 1U)) * static_cast<size_t>(std::max(height >> 2U, 1U)));
+    }
+
+    mcrt_vector<DirectX::XMVECTOR> source_row(width);
+    mcrt_vector<DirectX::XMVECTOR> row_cache(static_cast<size_t>(std::max(width >> 1U, 1U)) * k_row_cache_count);
+    mcrt_vector<DirectX::XMVECTOR> destination_row(std::max(width >> 1U, 1U));
+
+    uint32_t const *source_data = rgba_data;
+    for (uint32_t mip_level = 1U; mip_level < mip_levels; ++mip_level)
+    {
+        uint32_t const source_width = std::max(width >> (mip_level - 1U), 1U);
+        uint32_t const source_height = std::max(height >> (mip_level - 1U), 1U);
+        uint32_t const destination_width = std::max(width >> mip_level, 1U);
+        uint32_t const destination_height = std::max(height >> mip_level, 1U);
+
+        internal_mip_filter_tap horizontal_taps[k_kaiser_tap_count];
+        uint32_t const horizontal_tap_count = internal_mip_filter_taps(filter, source_width, horizontal_taps);
+
+        internal_mip_filter_tap vertical_taps[k_kaiser_tap_count];
+        uint32_t const vertical_tap_count = internal_mip_filter_taps(filter, source_height, vertical_taps);
+
+        uint32_t *const destination_data = mip_data[(mip_level - 1U) & 1U].data();
+
+        BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const &subresource_memcpy_dest = subresource_memcpy_dests[brx_sampled_asset_image_import_calculate_subresource_index(mip_level, 0U, 0U, mip_levels, 1U)];
+
+        int32_t cached_source_y[k_row_cache_count];
+        for (uint32_t cache_index = 0U; cache_index < k_row_cache_count; ++cache_index)
+        {
+            cached_source_y[cache_index] = -1;
+        }
+
+        for (uint32_t destination_y = 0U; destination_y < destination_height; ++destination_y)
+        {
+            DirectX::XMVECTOR const *horizontal_rows[k_kaiser_tap_count];
+            for (uint32_t vertical_tap_index = 0U; vertical_tap_index < vertical_tap_count; ++vertical_tap_index)
+            {
+                int32_t const source_y = std::min(std::max(static_cast<int32_t>(2U * destination_y) + vertical_taps[vertical_tap_index].offset, 0), static_cast<int32_t>(source_height) - 1);
+
+                // the rows used by the consecutive destination rows are consecutive (the window moves by 2 source rows) and the cache can NOT be thrashed
+                uint32_t const cache_index = static_cast<uint32_t>(source_y) % k_row_cache_count;
+                DirectX::XMVECTOR *const horizontal_row = row_cache.data() + static_cast<size_t>(destination_width) * cache_index;
+
+                if (source_y != cached_source_y[cache_index])
+                {
+                    internal_load_row(reinterpret_cast<uint8_t const *>(source_data + static_cast<size_t>(source_width) * source_y), source_width, srgb, source_row.data());
+
+                    for (uint32_t destination_x = 0U; destination_x < destination_width; ++destination_x)
+                    {
+                        DirectX::XMVECTOR sum = DirectX::XMVectorZero();
+                        for (uint32_t horizontal_tap_index = 0U; horizontal_tap_index < horizontal_tap_count; ++horizontal_tap_index)
+                        {
+                            int32_t const source_x = std::min(std::max(static_cast<int32_t>(2U * destination_x) + horizontal_taps[horizontal_tap_index].offset, 0), static_cast<int32_t>(source_width) - 1);
+                            sum = DirectX::XMVectorMultiplyAdd(source_row[source_x], DirectX::XMVectorReplicate(horizontal_taps[horizontal_tap_index].weight), sum);
+                        }
+                        horizontal_row[destination_x] = sum;
+                    }
+
+                    cached_source_y[cache_index] = source_y;
+                }
+
+                horizontal_rows[vertical_tap_index] = horizontal_row;
+            }
+
+            for (uint32_t destination_x = 0U; destination_x < destination_width; ++destination_x)
+            {
+                DirectX::XMVECTOR sum = DirectX::XMVectorZero();
+                for (uint32_t vertical_tap_index = 0U; vertical_tap_index < vertical_tap_count; ++vertical_tap_index)
+                {
+                    sum = DirectX::XMVectorMultiplyAdd(horizontal_rows[vertical_tap_index][destination_x], DirectX::XMVectorReplicate(vertical_taps[vertical_tap_index].weight), sum);
+                }
+                destination_row[destination_x] = sum;
+            }
+
+            uint8_t *const destination_private_row = reinterpret_cast<uint8_t *>(destination_data + static_cast<size_t>(destination_width) * destination_y);
+            internal_store_row(destination_row.data(), destination_width, srgb, destination_private_row);
+
+            std::memcpy(static_cast<uint8_t *>(staging_upload_buffer_base) + subresource_memcpy_dest.staging_upload_buffer_offset + static_cast<size_t>(subresource_memcpy_dest.output_row_pitch) * destination_y, destination_private_row, sizeof(uint32_t) * destination_width);
+        }
+
+        source_data = destination_data;
+    }
+
+    return true;
+}
+
+static inline float internal_bessel_i0(float x)
+{
+    // the power series converges quickly for the small argument
+    float sum = 1.0F;
+    float term = 1.0F;
+    float const x_square_quarter = x * x * 0.25F;
+    for (uint32_t k = 1U; k < 32U; ++k)
+    {
+        term *= x_square_quarter / static_cast<float>(k * k);
+        sum += term;
+        if (term < sum * 1E-7F)
+        {
+            break;
+        }
+    }
+    return sum;
+}
+
+static inline uint32_t internal_mip_filter_taps(INTERNAL_IMPORT_IMAGE_MIP_FILTER filter, uint32_t source_size, internal_mip_filter_tap *taps)
+{
+    if (1U == source_size)
+    {
+        // this dimension is NOT downsampled any more
+        taps[0].offset = 0;
+        taps[0].weight = 1.0F;
+        return 1U;
+    }
+
+    switch (filter)
+    {
+    case INTERNAL_IMPORT_IMAGE_MIP_FILTER_BOX:
+    {
+        taps[0].offset = 0;
+        taps[0].weight = 0.5F;
+        taps[1].offset = 1;
+        taps[1].weight = 0.5F;
+        return 2U;
+    }
+    case INTERNAL_IMPORT_IMAGE_MIP_FILTER_KAISER:
+    {
+        // the center of the destination texel "i" is at "2 * i + 1" of the source and the center of the source texel "2 * i + offset" is at "2 * i + offset + 0.5"
+        float weight_sum = 0.0F;
+        for (uint32_t tap_index = 0U; tap_index < k_kaiser_tap_count; ++tap_index)
+        {
+            int32_t const offset = static_cast<int32_t>(tap_index) - static_cast<int32_t>(k_kaiser_tap_count / 2U - 1U);
+            float const t = (static_cast<float>(offset) - 0.5F) * 0.5F;
+
+            float const pi_t = 3.14159265358979323846F * t;
+            float const sinc = std::sin(pi_t) / pi_t;
+
+            float const x = t / k_kaiser_width;
+            float const window = internal_bessel_i0(k_kaiser_alpha * std::sqrt(std::max(1.0F - x * x, 0.0F))) / internal_bessel_i0(k_kaiser_alpha);
+
+            taps[tap_index].offset = offset;
+            taps[tap_index].weight = sinc * window;
+            weight_sum += taps[tap_index].weight;
+        }
+
+        for (uint32_t tap_index = 0U; tap_index < k_kaiser_tap_count; ++tap_index)
+        {
+            taps[tap_index].weight /= weight_sum;
+        }
+
+        return k_kaiser_tap_count;
+    }
+    default:
+    {
+        assert(false);
+        taps[0].offset = 0;
+        taps[0].weight = 1.0F;
+        return 1U;
+    }
+    }
+}
+
+static inline void internal_load_row(uint8_t const *source_row, uint32_t width, bool srgb, DirectX::XMVECTOR *row)
+{
+    for (uint32_t x = 0U; x < width; ++x)
+    {
+        DirectX::XMVECTOR texel = DirectX::PackedVector::XMLoadUByteN4(reinterpret_cast<DirectX::PackedVector::XMUBYTEN4 const *>(source_row + sizeof(uint32_t) * x));
+        if (srgb)
+        {
+            texel = DirectX::XMColorSRGBToRGB(texel);
+        }
+        row[x] = texel;
+    }
+}
+
+static inline void internal_store_row(DirectX::XMVECTOR const *row, uint32_t width, bool srgb, uint8_t *destination_row)
+{
+    for (uint32_t x = 0U; x < width; ++x)
+    {
+        // the Kaiser filter has the negative lobes and the result may be out of [0, 1]
+        DirectX::XMVECTOR texel = DirectX::XMVectorSaturate(row[x]);
+        if (srgb)
+        {
+            texel = DirectX::XMColorRGBToSRGB(texel);
+        }
+        DirectX::PackedVector::XMStoreUByteN4(reinterpret_cast<DirectX::PackedVector::XMUBYTEN4 *>(destination_row + sizeof(uint32_t) * x), texel);
+    }
+}
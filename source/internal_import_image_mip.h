@@ -0,0 +1,39 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _INTERNAL_IMPORT_IMAGE_MIP_H_
+#define _INTERNAL_IMPORT_IMAGE_MIP_H_ 1
+
+#include "../include/import_image_asset.h"
+#include <cstddef>
+#include <cstdint>
+
+enum INTERNAL_IMPORT_IMAGE_MIP_FILTER
+{
+    INTERNAL_IMPORT_IMAGE_MIP_FILTER_BOX = 0,
+    INTERNAL_IMPORT_IMAGE_MIP_FILTER_KAISER = 1
+};
+
+// the number of the mip levels of the full mip chain (down to 1x1)
+extern uint32_t internal_import_image_mip_levels(uint32_t width, uint32_t height);
+
+// generate the mip levels [0, subresource_count) of the RGBA8 image (e.g. decoded by "internal_import_image") and write each mip level into the "subresource_memcpy_dests" (indexed by the same subresource index as the DDS and PVR with one array layer)
+// the mip level 0 is the image itself and each following mip level is downsampled from the previous mip level (the width and height are expected to be power of 2)
+// the filtering is performed in the linear space when "srgb" is true (the alpha channel is always linear)
+extern bool internal_import_image_generate_mips(uint32_t const *rgba_data, uint32_t width, uint32_t height, bool srgb, INTERNAL_IMPORT_IMAGE_MIP_FILTER filter, void *staging_upload_buffer_base, size_t subresource_count, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests);
+
+#endif
@@ -0,0 +1,263 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+#include "internal_import_image_resize.h"
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#endif
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+#include <assert.h>
+#include <cmath>
+#include <algorithm>
+#include "../../McRT-Malloc/include/mcrt_vector.h"
+
+// stb_image_resize2.h
+// OpenCV: modules/imgproc/src/resize.cpp (INTER_AREA and INTER_LANCZOS4)
+
+// the destination texel is filtered from the source texels [first, first + count) and the weights are stored at [weight_offset, weight_offset + count)
+struct internal_resize_contribution
+{
+    uint32_t first;
+    uint32_t count;
+    uint32_t weight_offset;
+};
+
+// Lanczos: the window is 4 source texels on each side when upsampling
+static constexpr int32_t const k_lanczos_a = 4;
+
+// the color is NOT restored from the premultiplied color when the alpha is too small (the color precision has been lost anyway)
+static constexpr float const k_min_unpremultiply_alpha = 1.0F / 512.0F;
+
+static inline uint32_t internal_resize_contributions(uint32_t source_size, uint32_t target_size, mcrt_vector<internal_resize_contribution> &contributions, mcrt_vector<float> &weights);
+
+static inline void internal_load_row(uint32_t const *source_row, uint32_t width, bool srgb, DirectX::XMVECTOR *row);
+
+static inline void internal_store_row(DirectX::XMVECTOR const *row, uint32_t width, bool srgb, uint32_t *target_row);
+
+extern void internal_import_image_resize(uint32_t const *source_rgba_data, uint32_t source_width, uint32_t source_height, bool srgb, void *target_rgba_data_base, size_t target_row_pitch, uint32_t target_width, uint32_t target_height)
+{
+    assert((source_width > 0U) && (source_height > 0U) && (target_width > 0U) && (target_height > 0U));
+    assert(target_row_pitch >= (sizeof(uint32_t) * target_width));
+
+    mcrt_vector<internal_resize_contribution> horizontal_contributions;
+    mcrt_vector<float> horizontal_weights;
+    internal_resize_contributions(source_width, target_width, horizontal_contributions, horizontal_weights);
+
+    mcrt_vector<internal_resize_contribution> vertical_contributions;
+    mcrt_vector<float> vertical_weights;
+    uint32_t const max_vertical_contribution_count = internal_resize_contributions(source_height, target_height, vertical_contributions, vertical_weights);
+
+    // the horizontally filtered rows are cached: the source rows used by the consecutive target rows never move backward and the window is NOT larger than the max contribution count
+    uint32_t const row_cache_count = max_vertical_contribution_count;
+
+    mcrt_vector<DirectX::XMVECTOR> source_row(source_width);
+    mcrt_vector<DirectX::XMVECTOR> row_cache(static_cast<size_t>(target_width) * row_cache_count);
+    mcrt_vector<int32_t> cached_source_y(row_cache_count, -1);
+    mcrt_vector<DirectX::XMVECTOR> target_row(target_width);
+
+    for (uint32_t target_y = 0U; target_y < target_height; ++target_y)
+    {
+        internal_resize_contribution const &vertical_contribution = vertical_contributions[target_y];
+
+        for (uint32_t source_y = vertical_contribution.first; source_y < (vertical_contribution.first + vertical_contribution.count); ++source_y)
+        {
+            uint32_t const cache_index = source_y % row_cache_count;
+            if (static_cast<int32_t>(source_y) != cached_source_y[cache_index])
+            {
+                internal_load_row(source_rgba_data + static_cast<size_t>(source_width) * source_y, source_width, srgb, source_row.data());
+
+                DirectX::XMVECTOR *const horizontal_row = row_cache.data() + static_cast<size_t>(target_width) * cache_index;
+                for (uint32_t target_x = 0U; target_x < target_width; ++target_x)
+                {
+                    internal_resize_contribution const &horizontal_contribution = horizontal_contributions[target_x];
+                    DirectX::XMVECTOR const *const source_texels = source_row.data() + horizontal_contribution.first;
+                    float const *const weights = horizontal_weights.data() + horizontal_contribution.weight_offset;
+
+                    DirectX::XMVECTOR sum = DirectX::XMVectorZero();
+                    for (uint32_t contribution_index = 0U; contribution_index < horizontal_contribution.count; ++contribution_index)
+                    {
+                        sum = DirectX::XMVectorMultiplyAdd(source_texels[contribution_index], DirectX::XMVectorReplicate(weights[contribution_index]), sum);
+                    }
+                    horizontal_row[target_x] = sum;
+                }
+
+                cached_source_y[cache_index] = static_cast<int32_t>(source_y);
+            }
+        }
+
+        {
+            float const *const weights = vertical_weights.data() + vertical_contribution.weight_offset;
+
+            for (uint32_t target_x = 0U; target_x < target_width; ++target_x)
+            {
+                target_row[target_x] = DirectX::XMVectorZero();
+            }
+
+            for (uint32_t contribution_index = 0U; contribution_index < vertical_contribution.count; ++contribution_index)
+            {
+                uint32_t const cache_index = (vertical_contribution.first + contribution_index) % row_cache_count;
+                assert(static_cast<int32_t>(vertical_contribution.first + contribution_index) == cached_source_y[cache_index]);
+
+                DirectX::XMVECTOR const *const horizontal_row = row_cache.data() + static_cast<size_t>(target_width) * cache_index;
+                DirectX::XMVECTOR const weight = DirectX::XMVectorReplicate(weights[contribution_index]);
+
+                for (uint32_t target_x = 0U; target_x < target_width; ++target_x)
+                {
+                    target_row[target_x] = DirectX::XMVectorMultiplyAdd(horizontal_row[target_x], weight, target_row[target_x]);
+                }
+            }
+        }
+
+        // the target is written once and never read (the staging upload buffer is usually the write-combined memory)
+        internal_store_row(target_row.data(), target_width, srgb, reinterpret_cast<uint32_t *>(static_cast<uint8_t *>(target_rgba_data_base) + target_row_pitch * target_y));
+    }
+}
+
+static inline float internal_lanczos(float x)
+{
+    if (std::abs(x) < 1E-6F)
+    {
+        return 1.0F;
+    }
+    else if (std::abs(x) >= static_cast<float>(k_lanczos_a))
+    {
+        return 0.0F;
+    }
+    else
+    {
+        float const pi_x = 3.14159265358979323846F * x;
+        float const pi_x_div_a = pi_x / static_cast<float>(k_lanczos_a);
+        return (std::sin(pi_x) / pi_x) * (std::sin(pi_x_div_a) / pi_x_div_a);
+    }
+}
+
+static inline uint32_t internal_resize_contributions(uint32_t source_size, uint32_t target_size, mcrt_vector<internal_resize_contribution> &contributions, mcrt_vector<float> &weights)
+{
+    contributions.resize(target_size);
+    weights.clear();
+
+    uint32_t max_contribution_count = 1U;
+
+    double const scale = static_cast<double>(source_size) / static_cast<double>(target_size);
+
+    for (uint32_t target_index = 0U; target_index < target_size; ++target_index)
+    {
+        uint32_t first;
+        uint32_t last;
+        uint32_t const weight_offset = static_cast<uint32_t>(weights.size());
+
+        if (target_size <= source_size)
+        {
+            // area: the target texel covers the source interval [begin, end) and each source texel is weighted by the covered length
+            double const begin = scale * static_cast<double>(target_index);
+            double const end = std::min(scale * static_cast<double>(target_index + 1U), static_cast<double>(source_size));
+
+            first = std::min(static_cast<uint32_t>(std::floor(begin)), source_size - 1U);
+            last = std::max(std::min(static_cast<uint32_t>(std::ceil(end)), source_size), first + 1U) - 1U;
+
+            for (uint32_t source_index = first; source_index <= last; ++source_index)
+            {
+                double const covered = std::min(end, static_cast<double>(source_index + 1U)) - std::max(begin, static_cast<double>(source_index));
+                weights.push_back(static_cast<float>(std::max(covered, 0.0) / scale));
+            }
+        }
+        else
+        {
+            // Lanczos: the center of the target texel is mapped into the source and the out of range source texels are clamped to the edge (the weights are merged into the edge texel)
+            double const center = (static_cast<double>(target_index) + 0.5) * scale - 0.5;
+            int32_t const floor_center = static_cast<int32_t>(std::floor(center));
+
+            int32_t const window_first = floor_center - (k_lanczos_a - 1);
+            int32_t const window_last = floor_center + k_lanczos_a;
+
+            first = static_cast<uint32_t>(std::min(std::max(window_first, 0), static_cast<int32_t>(source_size) - 1));
+            last = static_cast<uint32_t>(std::min(std::max(window_last, 0), static_cast<int32_t>(source_size) - 1));
+
+            weights.resize(static_cast<size_t>(weight_offset) + (last - first + 1U), 0.0F);
+
+            for (int32_t source_index = window_first; source_index <= window_last; ++source_index)
+            {
+                uint32_t const clamped_source_index = static_cast<uint32_t>(std::min(std::max(source_index, 0), static_cast<int32_t>(source_size) - 1));
+                weights[weight_offset + (clamped_source_index - first)] += internal_lanczos(static_cast<float>(center - static_cast<double>(source_index)));
+            }
+        }
+
+        uint32_t const count = last - first + 1U;
+
+        // normalize (the area weights may NOT exactly sum to one due to the precision and the Lanczos weights never sum to one)
+        float weight_sum = 0.0F;
+        for (uint32_t contribution_index = 0U; contribution_index < count; ++contribution_index)
+        {
+            weight_sum += weights[weight_offset + contribution_index];
+        }
+        assert(std::abs(weight_sum) > 1E-6F);
+        for (uint32_t contribution_index = 0U; contribution_index < count; ++contribution_index)
+        {
+            weights[weight_offset + contribution_index] /= weight_sum;
+        }
+
+        contributions[target_index].first = first;
+        contributions[target_index].count = count;
+        contributions[target_index].weight_offset = weight_offset;
+
+        max_contribution_count = std::max(max_contribution_count, count);
+    }
+
+    return max_contribution_count;
+}
+
+static inline void internal_load_row(uint32_t const *source_row, uint32_t width, bool srgb, DirectX::XMVECTOR *row)
+{
+    for (uint32_t x = 0U; x < width; ++x)
+    {
+        DirectX::XMVECTOR texel = DirectX::PackedVector::XMLoadUByteN4(reinterpret_cast<DirectX::PackedVector::XMUBYTEN4 const *>(source_row + x));
+        if (srgb)
+        {
+            texel = DirectX::XMColorSRGBToRGB(texel);
+        }
+
+        // premultiply the color channels by the alpha channel
+        DirectX::XMVECTOR const alpha = DirectX::XMVectorSplatW(texel);
+        row[x] = DirectX::XMVectorSelect(alpha, DirectX::XMVectorMultiply(texel, alpha), DirectX::g_XMSelect1110);
+    }
+}
+
+static inline void internal_store_row(DirectX::XMVECTOR const *row, uint32_t width, bool srgb, uint32_t *target_row)
+{
+    for (uint32_t x = 0U; x < width; ++x)
+    {
+        // the Lanczos filter has the negative lobes and the result may be out of [0, 1]
+        DirectX::XMVECTOR texel = row[x];
+
+        float const alpha = std::min(std::max(DirectX::XMVectorGetW(texel), 0.0F), 1.0F);
+        if (alpha > k_min_unpremultiply_alpha)
+        {
+            texel = DirectX::XMVectorDivide(texel, DirectX::XMVectorReplicate(alpha));
+        }
+        texel = DirectX::XMVectorSaturate(DirectX::XMVectorSetW(texel, alpha));
+
+        if (srgb)
+        {
+            texel = DirectX::XMColorRGBToSRGB(texel);
+        }
+        DirectX::PackedVector::XMStoreUByteN4(reinterpret_cast<DirectX::PackedVector::XMUBYTEN4 *>(target_row + x), texel);
+    }
+}
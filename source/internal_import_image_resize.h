@@ -0,0 +1,29 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _INTERNAL_IMPORT_IMAGE_RESIZE_H_
+#define _INTERNAL_IMPORT_IMAGE_RESIZE_H_ 1
+
+#include <cstddef>
+#include <cstdint>
+
+// resample the RGBA8 image to the target size and write the result directly into the "target_rgba_data_base" (e.g. the staging upload buffer) with the "target_row_pitch"
+// each dimension is filtered independently: the area filter is used when downsampling and the Lanczos filter (a = 4) is used when upsampling
+// the color channels are premultiplied by the alpha channel during filtering (the transparent texels do NOT bleed) and the filtering is performed in the linear space when "srgb" is true
+extern void internal_import_image_resize(uint32_t const *source_rgba_data, uint32_t source_width, uint32_t source_height, bool srgb, void *target_rgba_data_base, size_t target_row_pitch, uint32_t target_width, uint32_t target_height);
+
+#endif
@@ -0,0 +1,327 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "internal_import_image_subresource.h"
+#include <assert.h>
+#include <cstring>
+#include <atomic>
+#include "../../McRT-Malloc/include/mcrt_vector.h"
+
+static inline bool internal_validate_subresource_layouts(import_asset_input_stream *input_stream, size_t image_asset_data_offset, size_t subresource_count, IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT const *subresource_layouts, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests, size_t selected_subresource_count, uint32_t const *selected_subresource_indices, size_t *input_data_size);
+
+struct internal_parallel_copy_task
+{
+    uint32_t subresource_index;
+    uint32_t slice_index;
+};
+
+struct internal_parallel_copy_context
+{
+    import_asset_input_stream *input_stream;
+    size_t image_asset_data_offset;
+    void const *input_mapping_base;
+    void *staging_upload_buffer_base;
+    IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT const *subresource_layouts;
+    BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests;
+    internal_parallel_copy_task const *copy_tasks;
+    std::atomic_bool failed;
+};
+
+static void internal_parallel_copy_task_function(uint32_t task_index, void *user_data);
+
+extern bool internal_import_image_subresources_from_input_stream(import_asset_input_stream *input_stream, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT const *subresource_layouts, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests, size_t selected_subresource_count, uint32_t const *selected_subresource_indices)
+{
+    size_t input_data_size;
+    if (!internal_validate_subresource_layouts(input_stream, image_asset_data_offset, subresource_count, subresource_layouts, subresource_memcpy_dests, selected_subresource_count, selected_subresource_indices, &input_data_size))
+    {
+        return false;
+    }
+
+    // memcpy directly from the mapping (e.g. the page cache) when the input stream supports "map_range"
+    void const *input_mapping_base = NULL;
+    if (0 != input_stream->map_range(image_asset_data_offset, input_data_size, &input_mapping_base))
+    {
+        input_mapping_base = NULL;
+    }
+
+    // otherwise, batch all reads (one request per row when the pitches differ) and submit them at once
+    mcrt_vector<IMPORT_ASSET_INPUT_STREAM_READ_REQUEST> input_read_requests;
+
+    for (size_t selected_subresource_index = 0U; selected_subresource_index < selected_subresource_count; ++selected_subresource_index)
+    {
+        uint32_t const dstSubresource = selected_subresource_indices[selected_subresource_index];
+
+        size_t const inputSkipBytes = static_cast<size_t>(subresource_layouts[dstSubresource].offset);
+        size_t const inputRowSize = subresource_layouts[dstSubresource].row_size;
+        size_t const inputNumRows = subresource_layouts[dstSubresource].row_count;
+        size_t const inputSliceSize = subresource_layouts[dstSubresource].slice_size;
+        size_t const inputNumSlices = subresource_layouts[dstSubresource].slice_count;
+
+        if (inputSliceSize == subresource_memcpy_dests[dstSubresource].output_slice_pitch && inputRowSize == subresource_memcpy_dests[dstSubresource].output_row_pitch)
+        {
+            if (NULL != input_mapping_base)
+            {
+                std::memcpy(reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(staging_upload_buffer_base) + subresource_memcpy_dests[dstSubresource].staging_upload_buffer_offset), reinterpret_cast<void const *>(reinterpret_cast<uintptr_t>(input_mapping_base) + (inputSkipBytes - image_asset_data_offset)), inputSliceSize * inputNumSlices);
+            }
+            else
+            {
+                IMPORT_ASSET_INPUT_STREAM_READ_REQUEST input_read_request;
+                input_read_request.offset = static_cast<int64_t>(inputSkipBytes);
+                input_read_request.size = inputSliceSize * inputNumSlices;
+                input_read_request.data = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(staging_upload_buffer_base) + subresource_memcpy_dests[dstSubresource].staging_upload_buffer_offset);
+                input_read_request.result = -1;
+                input_read_requests.push_back(input_read_request);
+            }
+        }
+        else if (inputRowSize == subresource_memcpy_dests[dstSubresource].output_row_pitch)
+        {
+            for (size_t z = 0; z < inputNumSlices; ++z)
+            {
+                if (NULL != input_mapping_base)
+                {
+                    std::memcpy(reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(staging_upload_buffer_base) + (subresource_memcpy_dests[dstSubresource].staging_upload_buffer_offset + subresource_memcpy_dests[dstSubresource].output_slice_pitch * z)), reinterpret_cast<void const *>(reinterpret_cast<uintptr_t>(input_mapping_base) + ((inputSkipBytes - image_asset_data_offset) + inputSliceSize * z)), inputSliceSize);
+                }
+                else
+                {
+                    IMPORT_ASSET_INPUT_STREAM_READ_REQUEST input_read_request;
+                    input_read_request.offset = static_cast<int64_t>(inputSkipBytes + inputSliceSize * z);
+                    input_read_request.size = inputSliceSize;
+                    input_read_request.data = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(staging_upload_buffer_base) + (subresource_memcpy_dests[dstSubresource].staging_upload_buffer_offset + subresource_memcpy_dests[dstSubresource].output_slice_pitch * z));
+                    input_read_request.result = -1;
+                    input_read_requests.push_back(input_read_request);
+                }
+            }
+        }
+        else
+        {
+            for (size_t z = 0; z < inputNumSlices; ++z)
+            {
+                for (size_t y = 0; y < inputNumRows; ++y)
+                {
+                    if (NULL != input_mapping_base)
+                    {
+                        std::memcpy(reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(staging_upload_buffer_base) + (subresource_memcpy_dests[dstSubresource].staging_upload_buffer_offset + subresource_memcpy_dests[dstSubresource].output_slice_pitch * z + subresource_memcpy_dests[dstSubresource].output_row_pitch * y)), reinterpret_cast<void const *>(reinterpret_cast<uintptr_t>(input_mapping_base) + ((inputSkipBytes - image_asset_data_offset) + inputSliceSize * z + inputRowSize * y)), inputRowSize);
+                    }
+                    else
+                    {
+                        IMPORT_ASSET_INPUT_STREAM_READ_REQUEST input_read_request;
+                        input_read_request.offset = static_cast<int64_t>(inputSkipBytes + inputSliceSize * z + inputRowSize * y);
+                        input_read_request.size = inputRowSize;
+                        input_read_request.data = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(staging_upload_buffer_base) + (subresource_memcpy_dests[dstSubresource].staging_upload_buffer_offset + subresource_memcpy_dests[dstSubresource].output_slice_pitch * z + subresource_memcpy_dests[dstSubresource].output_row_pitch * y));
+                        input_read_request.result = -1;
+                        input_read_requests.push_back(input_read_request);
+                    }
+                }
+            }
+        }
+    }
+
+    if (!input_read_requests.empty())
+    {
+        assert(NULL == input_mapping_base);
+
+        if ((-1 == input_stream->read_submit(input_read_requests.size(), input_read_requests.data())) || (-1 == input_stream->read_wait()))
+        {
+            return false;
+        }
+
+        for (IMPORT_ASSET_INPUT_STREAM_READ_REQUEST const &input_read_request : input_read_requests)
+        {
+            if ((-1 == input_read_request.result) || (static_cast<size_t>(input_read_request.result) < input_read_request.size))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+extern bool internal_import_image_subresources_from_input_stream_parallel(import_asset_input_stream *input_stream, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT const *subresource_layouts, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests, size_t selected_subresource_count, uint32_t const *selected_subresource_indices, import_asset_task_scheduler *task_scheduler)
+{
+    size_t input_data_size;
+    if (!internal_validate_subresource_layouts(input_stream, image_asset_data_offset, subresource_count, subresource_layouts, subresource_memcpy_dests, selected_subresource_count, selected_subresource_indices, &input_data_size))
+    {
+        return false;
+    }
+
+    // one task per slice (the 3D image has more than one slice per subresource)
+    mcrt_vector<internal_parallel_copy_task> copy_tasks;
+
+    for (size_t selected_subresource_index = 0U; selected_subresource_index < selected_subresource_count; ++selected_subresource_index)
+    {
+        uint32_t const subresource_index = selected_subresource_indices[selected_subresource_index];
+
+        for (uint32_t slice_index = 0U; slice_index < subresource_layouts[subresource_index].slice_count; ++slice_index)
+        {
+            internal_parallel_copy_task copy_task;
+            copy_task.subresource_index = subresource_index;
+            copy_task.slice_index = slice_index;
+            copy_tasks.push_back(copy_task);
+        }
+    }
+
+    if (copy_tasks.size() > static_cast<size_t>(UINT32_MAX))
+    {
+        return false;
+    }
+
+    internal_parallel_copy_context context;
+    context.input_stream = input_stream;
+    context.image_asset_data_offset = image_asset_data_offset;
+    // memcpy directly from the mapping (e.g. the page cache) when the input stream supports "map_range"
+    if (0 != input_stream->map_range(image_asset_data_offset, input_data_size, &context.input_mapping_base))
+    {
+        context.input_mapping_base = NULL;
+    }
+    context.staging_upload_buffer_base = staging_upload_buffer_base;
+    context.subresource_layouts = subresource_layouts;
+    context.subresource_memcpy_dests = subresource_memcpy_dests;
+    context.copy_tasks = copy_tasks.data();
+    context.failed.store(false, std::memory_order_relaxed);
+
+    // fall back to the serial copy on the calling thread if "read_at" of the input stream is NOT safe to be called concurrently
+    if ((NULL != task_scheduler) && input_stream->is_read_at_thread_safe())
+    {
+        task_scheduler->parallel_for(static_cast<uint32_t>(copy_tasks.size()), internal_parallel_copy_task_function, &context);
+    }
+    else
+    {
+        for (uint32_t copy_task_index = 0U; copy_task_index < static_cast<uint32_t>(copy_tasks.size()); ++copy_task_index)
+        {
+            internal_parallel_copy_task_function(copy_task_index, &context);
+        }
+    }
+
+    return (!context.failed.load(std::memory_order_relaxed));
+}
+
+extern bool internal_import_image_select_mip_range(IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, uint32_t first_mip_level, uint32_t mip_level_count, size_t subresource_count, mcrt_vector<uint32_t> *selected_subresource_indices)
+{
+    if ((0U == mip_level_count) || (first_mip_level >= image_asset_header->mip_levels) || (mip_level_count > (image_asset_header->mip_levels - first_mip_level)))
+    {
+        return false;
+    }
+
+    uint32_t const array_layers = (IMPORT_ASSET_IMAGE_TYPE_3D == image_asset_header->type) ? 1U : image_asset_header->array_layers;
+
+    selected_subresource_indices->clear();
+    selected_subresource_indices->reserve(static_cast<size_t>(array_layers) * mip_level_count);
+
+    // TODO: support more than one plane
+    for (uint32_t array_layer = 0U; array_layer < array_layers; ++array_layer)
+    {
+        for (uint32_t mip_level = first_mip_level; mip_level < (first_mip_level + mip_level_count); ++mip_level)
+        {
+            uint32_t const subresource_index = brx_sampled_asset_image_import_calculate_subresource_index(mip_level, array_layer, 0U, image_asset_header->mip_levels, image_asset_header->array_layers);
+            if (subresource_index >= subresource_count)
+            {
+                return false;
+            }
+
+            selected_subresource_indices->push_back(subresource_index);
+        }
+    }
+
+    return true;
+}
+
+static inline bool internal_validate_subresource_layouts(import_asset_input_stream *input_stream, size_t image_asset_data_offset, size_t subresource_count, IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT const *subresource_layouts, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests, size_t selected_subresource_count, uint32_t const *selected_subresource_indices, size_t *input_data_size)
+{
+    int64_t input_stream_size;
+    if ((-1 == input_stream->stat_size(&input_stream_size)) || (input_stream_size < static_cast<int64_t>(image_asset_data_offset)))
+    {
+        return false;
+    }
+
+    for (size_t selected_subresource_index = 0U; selected_subresource_index < selected_subresource_count; ++selected_subresource_index)
+    {
+        uint32_t const subresource_index = selected_subresource_indices[selected_subresource_index];
+        if (subresource_index >= subresource_count)
+        {
+            return false;
+        }
+
+        assert(subresource_layouts[subresource_index].slice_count == subresource_memcpy_dests[subresource_index].output_slice_count);
+        assert(subresource_layouts[subresource_index].row_count == subresource_memcpy_dests[subresource_index].output_row_count);
+        assert(subresource_layouts[subresource_index].row_size == subresource_memcpy_dests[subresource_index].output_row_size);
+        assert(subresource_layouts[subresource_index].slice_size <= subresource_memcpy_dests[subresource_index].output_slice_pitch);
+        assert(subresource_layouts[subresource_index].row_size <= subresource_memcpy_dests[subresource_index].output_row_pitch);
+
+        if ((subresource_layouts[subresource_index].offset < image_asset_data_offset) || ((subresource_layouts[subresource_index].offset + static_cast<uint64_t>(subresource_layouts[subresource_index].slice_size) * subresource_layouts[subresource_index].slice_count) > static_cast<uint64_t>(input_stream_size)))
+        {
+            return false;
+        }
+    }
+
+    (*input_data_size) = static_cast<size_t>(input_stream_size - static_cast<int64_t>(image_asset_data_offset));
+    return true;
+}
+
+static void internal_parallel_copy_task_function(uint32_t task_index, void *user_data)
+{
+    internal_parallel_copy_context *const context = static_cast<internal_parallel_copy_context *>(user_data);
+
+    if (context->failed.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    internal_parallel_copy_task const &copy_task = context->copy_tasks[task_index];
+    IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT const &subresource_layout = context->subresource_layouts[copy_task.subresource_index];
+    BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const &subresource_memcpy_dest = context->subresource_memcpy_dests[copy_task.subresource_index];
+
+    size_t const input_offset = static_cast<size_t>(subresource_layout.offset) + static_cast<size_t>(subresource_layout.slice_size) * copy_task.slice_index;
+    void *const output = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(context->staging_upload_buffer_base) + (subresource_memcpy_dest.staging_upload_buffer_offset + subresource_memcpy_dest.output_slice_pitch * copy_task.slice_index));
+
+    if (subresource_layout.row_size == subresource_memcpy_dest.output_row_pitch)
+    {
+        if (NULL != context->input_mapping_base)
+        {
+            std::memcpy(output, reinterpret_cast<void const *>(reinterpret_cast<uintptr_t>(context->input_mapping_base) + (input_offset - context->image_asset_data_offset)), subresource_layout.slice_size);
+        }
+        else if (static_cast<intptr_t>(subresource_layout.slice_size) != context->input_stream->read_at(static_cast<int64_t>(input_offset), output, subresource_layout.slice_size))
+        {
+            context->failed.store(true, std::memory_order_relaxed);
+        }
+    }
+    else
+    {
+        if (NULL != context->input_mapping_base)
+        {
+            for (size_t y = 0; y < subresource_layout.row_count; ++y)
+            {
+                std::memcpy(reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(output) + subresource_memcpy_dest.output_row_pitch * y), reinterpret_cast<void const *>(reinterpret_cast<uintptr_t>(context->input_mapping_base) + ((input_offset - context->image_asset_data_offset) + subresource_layout.row_size * y)), subresource_layout.row_size);
+            }
+        }
+        else
+        {
+            // one positional read per slice (instead of per row) into the private memory and then the rows are copied to the output row pitch (the staging upload buffer is usually the write-combined memory which is very slow to read)
+            mcrt_vector<uint8_t> input_slice(subresource_layout.slice_size);
+            if (static_cast<intptr_t>(subresource_layout.slice_size) != context->input_stream->read_at(static_cast<int64_t>(input_offset), input_slice.data(), subresource_layout.slice_size))
+            {
+                context->failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+
+            for (size_t y = 0; y < subresource_layout.row_count; ++y)
+            {
+                std::memcpy(reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(output) + subresource_memcpy_dest.output_row_pitch * y), input_slice.data() + subresource_layout.row_size * y, subresource_layout.row_size);
+            }
+        }
+    }
+}
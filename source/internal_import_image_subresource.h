@@ -0,0 +1,35 @@
+//
+// Copyright (C) YuqiaoZhang(HanetakaChou)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef _INTERNAL_IMPORT_IMAGE_SUBRESOURCE_H_
+#define _INTERNAL_IMPORT_IMAGE_SUBRESOURCE_H_ 1
+
+#include "../include/import_image_asset.h"
+#include "../../McRT-Malloc/include/mcrt_vector.h"
+#include <cstddef>
+#include <cstdint>
+
+// copy the selected subresources (described by the layouts which are shared by the DDS and PVR) from the input stream into the staging upload buffer
+// both the layouts and the memcpy dests are indexed by the subresource index (the entries which are NOT selected are ignored)
+extern bool internal_import_image_subresources_from_input_stream(import_asset_input_stream *input_stream, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT const *subresource_layouts, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests, size_t selected_subresource_count, uint32_t const *selected_subresource_indices);
+
+extern bool internal_import_image_subresources_from_input_stream_parallel(import_asset_input_stream *input_stream, size_t image_asset_data_offset, void *staging_upload_buffer_base, size_t subresource_count, IMPORT_ASSET_IMAGE_SUBRESOURCE_LAYOUT const *subresource_layouts, BRX_SAMPLED_ASSET_IMAGE_IMPORT_SUBRESOURCE_MEMCPY_DEST const *subresource_memcpy_dests, size_t selected_subresource_count, uint32_t const *selected_subresource_indices, import_asset_task_scheduler *task_scheduler);
+
+// the subresource indices of the mip levels [first_mip_level, first_mip_level + mip_level_count) of all array layers
+extern bool internal_import_image_select_mip_range(IMPORT_ASSET_IMAGE_HEADER const *image_asset_header, uint32_t first_mip_level, uint32_t mip_level_count, size_t subresource_count, mcrt_vector<uint32_t> *selected_subresource_indices);
+
+#endif
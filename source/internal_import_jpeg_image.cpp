@@ -17,14 +17,213 @@
 
 #include "internal_import_jpeg_image.h"
 #include "internal_import_image_config.h"
+#include <cassert>
+#include <cstring>
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include "../../McRT-Malloc/include/mcrt_malloc.h"
 #include "../thirdparty/libjpeg/jpeglib.h"
 
+// the stripe is NOT smaller than this height (the overlapped rows of the adjacent stripes are decoded twice)
+static constexpr uint32_t const k_jpeg_stripe_min_height = 512U;
+
+// the entropy coded data of the single scan split by the restart markers
+struct _internal_jpeg_restart_layout
+{
+    size_t sof_offset;
+    size_t scan_offset;
+    size_t eoi_offset;
+    uint32_t image_height;
+    mcrt_vector<size_t> restart_marker_offsets;
+    uint32_t restart_interval_count;
+    // the group is the restart intervals which start and end at the MCU row boundary
+    uint32_t intervals_per_group;
+    uint32_t group_height;
+    uint32_t group_count;
+};
+
+struct _internal_jpeg_stripe_decode_context
+{
+    uint8_t const *data_base;
+    _internal_jpeg_restart_layout const *restart_layout;
+    uint32_t scale_num;
+    uint32_t scaled_width;
+    uint32_t scaled_height;
+    uint32_t groups_per_stripe;
+    uint8_t *out_rgba_data_base;
+    size_t out_row_pitch;
+    uint8_t *stripe_status;
+};
+
 static void _internal_libjpeg_error_exit_callback(j_common_ptr cinfo);
 
+static inline uint32_t _internal_jpeg_scaled_size(uint32_t size, uint32_t scale_num);
+
+static bool _internal_libjpeg_decode_rows(void const *data_base, size_t data_size, uint32_t scale_num, uint32_t width, uint32_t height, uint32_t first_output_row, uint32_t output_row_count, void *out_rgba_data_base, size_t out_row_pitch);
+
+static bool _internal_jpeg_parse_restart_layout(void const *data_base, size_t data_size, _internal_jpeg_restart_layout *restart_layout);
+
+static void _internal_jpeg_stripe_decode_task_function(uint32_t task_index, void *user_data);
+
+extern bool internal_import_jpeg_image_header(void const *data_base, size_t data_size, uint32_t *out_width, uint32_t *out_height, uint32_t *out_channel_count)
+{
+    // only the markers before the SOS marker are read by the "jpeg_read_header" (NO scan is decoded)
+
+    jpeg_decompress_struct cinfo = {};
+    bool has_error = false;
+    try
+    {
+        jpeg_error_mgr err = {};
+        jpeg_std_error(&err);
+        err.error_exit = _internal_libjpeg_error_exit_callback;
+
+        cinfo.err = &err;
+        jpeg_create_decompress(&cinfo);
+
+        jpeg_mem_src(&cinfo, reinterpret_cast<unsigned char const *>(data_base), static_cast<unsigned long>(data_size));
+
+        int const status_jpeg_read_header = jpeg_read_header(&cinfo, TRUE);
+        if (JPEG_HEADER_OK != status_jpeg_read_header)
+        {
+            throw std::runtime_error{"jpeg read header"};
+        }
+
+        JDIMENSION const width = cinfo.image_width;
+        JDIMENSION const height = cinfo.image_height;
+
+        if ((width > k_max_width_or_height) || (height > k_max_width_or_height))
+        {
+            throw std::runtime_error("Size Overflow");
+        }
+
+        if ((0U == width) || (0U == height))
+        {
+            throw std::runtime_error("Size Zero");
+        }
+
+        // the CMYK and YCCK are converted into RGB
+        (*out_width) = width;
+        (*out_height) = height;
+        (*out_channel_count) = (1 == cinfo.num_components) ? 1U : 3U;
+    }
+    catch (std::runtime_error exception)
+    {
+        std::cout << exception.what() << std::endl;
+
+        has_error = true;
+    }
+
+    jpeg_destroy_decompress(&cinfo);
+
+    return (!has_error);
+}
+
 extern bool internal_import_jpeg_image(void const *data_base, size_t data_size, mcrt_vector<uint32_t> &out_rgba_data, uint32_t *out_width, uint32_t *out_height)
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t channel_count;
+    if (!internal_import_jpeg_image_header(data_base, data_size, &width, &height, &channel_count))
+    {
+        return false;
+    }
+
+    out_rgba_data.resize(static_cast<size_t>(width) * static_cast<size_t>(height));
+
+    if (!internal_import_jpeg_image_into(data_base, data_size, width, height, out_rgba_data.data(), sizeof(uint32_t) * static_cast<size_t>(width)))
+    {
+        return false;
+    }
+
+    (*out_width) = width;
+    (*out_height) = height;
+    return true;
+}
+
+extern bool internal_import_jpeg_image_into(void const *data_base, size_t data_size, uint32_t width, uint32_t height, void *out_rgba_data_base, size_t out_row_pitch)
+{
+    return _internal_libjpeg_decode_rows(data_base, data_size, DCTSIZE, width, height, 0U, height, out_rgba_data_base, out_row_pitch);
+}
+
+extern bool internal_import_jpeg_image_into_parallel(void const *data_base, size_t data_size, uint32_t width, uint32_t height, void *out_rgba_data_base, size_t out_row_pitch, import_asset_task_scheduler *task_scheduler)
+{
+    return internal_import_jpeg_image_scaled_into_parallel(data_base, data_size, DCTSIZE, width, height, out_rgba_data_base, out_row_pitch, task_scheduler);
+}
+
+extern void internal_import_jpeg_image_scaled_size(uint32_t width, uint32_t height, uint32_t scale_num, uint32_t *out_scaled_width, uint32_t *out_scaled_height)
+{
+    (*out_scaled_width) = _internal_jpeg_scaled_size(width, scale_num);
+    (*out_scaled_height) = _internal_jpeg_scaled_size(height, scale_num);
+}
+
+extern bool internal_import_jpeg_image_scaled_into_parallel(void const *data_base, size_t data_size, uint32_t scale_num, uint32_t scaled_width, uint32_t scaled_height, void *out_rgba_data_base, size_t out_row_pitch, import_asset_task_scheduler *task_scheduler)
+{
+    // libjpeg-turbo: tjdecompress (the multithreaded decoding is NOT supported)
+    // the entropy coded data is split at the restart markers and each stripe is decoded as the independent JPEG whose header is the same except for the height
+
+    if ((scale_num < 1U) || (scale_num > DCTSIZE))
+    {
+        return false;
+    }
+
+    if (NULL == task_scheduler)
+    {
+        return _internal_libjpeg_decode_rows(data_base, data_size, scale_num, scaled_width, scaled_height, 0U, scaled_height, out_rgba_data_base, out_row_pitch);
+    }
+
+    _internal_jpeg_restart_layout restart_layout;
+    if ((!_internal_jpeg_parse_restart_layout(data_base, data_size, &restart_layout)) || (restart_layout.group_height > restart_layout.image_height))
+    {
+        return _internal_libjpeg_decode_rows(data_base, data_size, scale_num, scaled_width, scaled_height, 0U, scaled_height, out_rgba_data_base, out_row_pitch);
+    }
+
+    // the group height is the multiple of the MCU height and is always scaled exactly
+    uint32_t const scaled_group_height = _internal_jpeg_scaled_size(restart_layout.group_height, scale_num);
+    uint32_t const groups_per_stripe = (k_jpeg_stripe_min_height + (scaled_group_height - 1U)) / scaled_group_height;
+    uint32_t const stripe_count = (restart_layout.group_count + (groups_per_stripe - 1U)) / groups_per_stripe;
+    if (stripe_count < 2U)
+    {
+        return _internal_libjpeg_decode_rows(data_base, data_size, scale_num, scaled_width, scaled_height, 0U, scaled_height, out_rgba_data_base, out_row_pitch);
+    }
+
+    mcrt_vector<uint8_t> stripe_status(stripe_count, 0U);
+
+    _internal_jpeg_stripe_decode_context context;
+    context.data_base = static_cast<uint8_t const *>(data_base);
+    context.restart_layout = &restart_layout;
+    context.scale_num = scale_num;
+    context.scaled_width = scaled_width;
+    context.scaled_height = scaled_height;
+    context.groups_per_stripe = groups_per_stripe;
+    context.out_rgba_data_base = static_cast<uint8_t *>(out_rgba_data_base);
+    context.out_row_pitch = out_row_pitch;
+    context.stripe_status = stripe_status.data();
+
+    // the tasks are independent of each other since each task writes the different rows
+    task_scheduler->parallel_for(stripe_count, _internal_jpeg_stripe_decode_task_function, &context);
+
+    for (uint32_t stripe_index = 0U; stripe_index < stripe_count; ++stripe_index)
+    {
+        if (0U == stripe_status[stripe_index])
+        {
+            // e.g. the corrupted restart markers which may still be tolerated by the serial decoding
+            return _internal_libjpeg_decode_rows(data_base, data_size, scale_num, scaled_width, scaled_height, 0U, scaled_height, out_rgba_data_base, out_row_pitch);
+        }
+    }
+
+    return true;
+}
+
+static void _internal_libjpeg_error_exit_callback(j_common_ptr cinfo)
+{
+    char buffer[JMSG_LENGTH_MAX];
+    cinfo->err->format_message(cinfo, buffer);
+
+    throw std::runtime_error{buffer};
+}
+
+static bool _internal_libjpeg_decode_rows(void const *data_base, size_t data_size, uint32_t scale_num, uint32_t width, uint32_t height, uint32_t first_output_row, uint32_t output_row_count, void *out_rgba_data_base, size_t out_row_pitch)
 {
     // https://chromium.googlesource.com/webm/libwebp/+/refs/heads/main/imageio/jpegdec.c
     // https://github.com/microsoft/DirectXTex/blob/main/Auxiliary/DirectXTexJPEG.cpp
@@ -52,23 +251,20 @@ extern bool internal_import_jpeg_image(void const *data_base, size_t data_size,
         cinfo.out_color_space = JCS_EXT_RGBA;
         cinfo.do_fancy_upsampling = TRUE;
 
+        // jdmaster.c: jpeg_core_output_dimensions
+        // the IDCT outputs "scale_num" pixels (instead of 8 pixels) for each block
+        cinfo.scale_num = scale_num;
+        cinfo.scale_denom = DCTSIZE;
+
         boolean const status_jpeg_start_decompress = jpeg_start_decompress(&cinfo);
         if (TRUE != status_jpeg_start_decompress)
         {
             throw std::runtime_error{"jpeg start decompress"};
         }
 
-        JDIMENSION const width = cinfo.output_width;
-        JDIMENSION const height = cinfo.output_height;
-
-        if ((width > k_max_width_or_height) || (height > k_max_width_or_height))
-        {
-            throw std::runtime_error("Size Overflow");
-        }
-
-        if ((0U == width) || (0U == height))
+        if ((cinfo.output_width != width) || (cinfo.output_height != height))
         {
-            throw std::runtime_error("Size Zero");
+            throw std::runtime_error("Size Mismatch");
         }
 
         if (!((JCS_EXT_RGBA == cinfo.out_color_space) && (k_num_channels == cinfo.out_color_components) && (k_num_channels == cinfo.output_components)))
@@ -76,36 +272,48 @@ extern bool internal_import_jpeg_image(void const *data_base, size_t data_size,
             throw std::runtime_error("NOT RGBA8 Format");
         }
 
-        uint64_t const _uint64_stride = static_cast<uint64_t>(k_channel_size) * static_cast<uint64_t>(k_num_channels) * static_cast<uint64_t>(width);
-        uint64_t const _uint64_num_pixels = static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
-
-        uintptr_t const stride = static_cast<uintptr_t>(_uint64_stride);
-        size_t const num_pixels = static_cast<size_t>(_uint64_num_pixels);
-
-        if (!((stride == _uint64_stride) && (num_pixels == _uint64_num_pixels)))
+        if (out_row_pitch < (static_cast<size_t>(k_channel_size) * static_cast<size_t>(k_num_channels) * static_cast<size_t>(width)))
         {
-            throw std::runtime_error("Size Overflow");
+            throw std::runtime_error("Row Pitch Underflow");
         }
 
-        out_rgba_data.resize(num_pixels);
+        if ((first_output_row > height) || (output_row_count > (height - first_output_row)))
+        {
+            throw std::runtime_error("Output Rows Overflow");
+        }
 
         JDIMENSION const batch_height = cinfo.rec_outbuf_height;
 
         mcrt_vector<JSAMPROW> rows(static_cast<size_t>(batch_height));
 
+        mcrt_vector<uint8_t> discarded_row((0U != first_output_row) || (height != output_row_count) ? (static_cast<size_t>(k_channel_size) * static_cast<size_t>(k_num_channels) * static_cast<size_t>(width)) : 0U);
+
         JDIMENSION height_index = 0;
         while ((height_index < height) && (cinfo.output_scanline < cinfo.output_height))
         {
-            for (JDIMENSION batch_height_index = 0; batch_height_index < batch_height; ++batch_height_index)
+            // the row pointers never exceed the output
+            JDIMENSION const num_rows_to_read = std::min(batch_height, height - height_index);
+
+            for (JDIMENSION batch_height_index = 0; batch_height_index < num_rows_to_read; ++batch_height_index)
             {
-                rows[batch_height_index] = reinterpret_cast<JSAMPROW>(reinterpret_cast<uintptr_t>(out_rgba_data.data()) + stride * (height_index + batch_height_index));
+                JDIMENSION const row_index = height_index + batch_height_index;
+                if ((row_index >= first_output_row) && ((row_index - first_output_row) < output_row_count))
+                {
+                    // the rows are written directly into the output (e.g. the staging upload buffer)
+                    rows[batch_height_index] = reinterpret_cast<JSAMPROW>(reinterpret_cast<uintptr_t>(out_rgba_data_base) + out_row_pitch * (row_index - first_output_row));
+                }
+                else
+                {
+                    // the rows out of the output are discarded
+                    rows[batch_height_index] = reinterpret_cast<JSAMPROW>(discarded_row.data());
+                }
             }
 
-            JDIMENSION const num_rows_read = jpeg_read_scanlines(&cinfo, rows.data(), batch_height);
+            JDIMENSION const num_rows_read = jpeg_read_scanlines(&cinfo, rows.data(), num_rows_to_read);
 
-            if (batch_height != num_rows_read)
+            if (num_rows_to_read != num_rows_read)
             {
-                if (!((num_rows_read >= 1) && (num_rows_read < batch_height)))
+                if (!((num_rows_read >= 1) && (num_rows_read < num_rows_to_read)))
                 {
                     throw std::runtime_error("jpeg read scanlines");
                 }
@@ -118,9 +326,6 @@ extern bool internal_import_jpeg_image(void const *data_base, size_t data_size,
         {
             throw std::runtime_error("jpeg finish decompress");
         }
-
-        (*out_width) = width;
-        (*out_height) = height;
     }
     catch (std::runtime_error exception)
     {
@@ -134,10 +339,261 @@ extern bool internal_import_jpeg_image(void const *data_base, size_t data_size,
     return (!has_error);
 }
 
-static void _internal_libjpeg_error_exit_callback(j_common_ptr cinfo)
+static bool _internal_jpeg_parse_restart_layout(void const *data_base, size_t data_size, _internal_jpeg_restart_layout *restart_layout)
 {
-    char buffer[JMSG_LENGTH_MAX];
-    cinfo->err->format_message(cinfo, buffer);
+    uint8_t const *const data = static_cast<uint8_t const *>(data_base);
 
-    throw std::runtime_error{buffer};
+    uint32_t width;
+    uint32_t height;
+    uint32_t mcu_width;
+    uint32_t mcu_height;
+    uint32_t restart_interval;
+    {
+        jpeg_decompress_struct cinfo = {};
+        bool has_error = false;
+        try
+        {
+            jpeg_error_mgr err = {};
+            jpeg_std_error(&err);
+            err.error_exit = _internal_libjpeg_error_exit_callback;
+
+            cinfo.err = &err;
+            jpeg_create_decompress(&cinfo);
+
+            jpeg_mem_src(&cinfo, reinterpret_cast<unsigned char const *>(data_base), static_cast<unsigned long>(data_size));
+
+            int const status_jpeg_read_header = jpeg_read_header(&cinfo, TRUE);
+            if (JPEG_HEADER_OK != status_jpeg_read_header)
+            {
+                throw std::runtime_error{"jpeg read header"};
+            }
+
+            // the "jpeg_read_header" stops right after the SOS segment of the first scan
+            restart_layout->scan_offset = static_cast<size_t>(cinfo.src->next_input_byte - data);
+            restart_layout->image_height = cinfo.image_height;
+
+            width = cinfo.image_width;
+            height = cinfo.image_height;
+            restart_interval = cinfo.restart_interval;
+
+            // only the baseline (or the extended sequential) Huffman JPEG whose first scan contains all components can be split
+            if (cinfo.progressive_mode || cinfo.arith_code || (0U == cinfo.restart_interval) || (cinfo.comps_in_scan != cinfo.num_components))
+            {
+                has_error = true;
+            }
+            else if (1 == cinfo.num_components)
+            {
+                // the MCU of the non-interleaved scan is one block
+                mcu_width = DCTSIZE;
+                mcu_height = DCTSIZE;
+            }
+            else
+            {
+                int max_h_samp_factor = 1;
+                int max_v_samp_factor = 1;
+                for (int component_index = 0; component_index < cinfo.num_components; ++component_index)
+                {
+                    max_h_samp_factor = std::max(max_h_samp_factor, cinfo.comp_info[component_index].h_samp_factor);
+                    max_v_samp_factor = std::max(max_v_samp_factor, cinfo.comp_info[component_index].v_samp_factor);
+                }
+                mcu_width = DCTSIZE * static_cast<uint32_t>(max_h_samp_factor);
+                mcu_height = DCTSIZE * static_cast<uint32_t>(max_v_samp_factor);
+            }
+        }
+        catch (std::runtime_error exception)
+        {
+            has_error = true;
+        }
+
+        jpeg_destroy_decompress(&cinfo);
+
+        if (has_error)
+        {
+            return false;
+        }
+    }
+
+    // jdmarker.c: next_marker
+    // the SOF0 (baseline) or SOF1 (extended sequential) segment before the first scan
+    {
+        bool found_sof = false;
+        size_t offset = 2U;
+        while ((offset + 4U) <= restart_layout->scan_offset)
+        {
+            if (0XFFU != data[offset])
+            {
+                return false;
+            }
+
+            uint8_t const marker = data[offset + 1U];
+            if (0XFFU == marker)
+            {
+                // fill byte
+                ++offset;
+                continue;
+            }
+
+            if ((0XC0U == marker) || (0XC1U == marker))
+            {
+                restart_layout->sof_offset = offset;
+                found_sof = true;
+                break;
+            }
+
+            size_t const segment_length = (static_cast<size_t>(data[offset + 2U]) << 8U) | static_cast<size_t>(data[offset + 3U]);
+            offset += (2U + segment_length);
+        }
+
+        // the height is at the offset 5 of the SOF segment
+        if ((!found_sof) || ((restart_layout->sof_offset + 7U) > restart_layout->scan_offset))
+        {
+            return false;
+        }
+    }
+
+    // jdmarker.c: next_marker
+    // only the RST markers are allowed in the entropy coded data and the scan is followed by the EOI marker (NO more scan and NO DNL)
+    restart_layout->restart_marker_offsets.clear();
+    {
+        size_t offset = restart_layout->scan_offset;
+        bool found_eoi = false;
+        while (offset < data_size)
+        {
+            uint8_t const *const marker_prefix = static_cast<uint8_t const *>(std::memchr(data + offset, 0XFF, data_size - offset));
+            if (NULL == marker_prefix)
+            {
+                break;
+            }
+
+            offset = static_cast<size_t>(marker_prefix - data);
+            if ((offset + 1U) >= data_size)
+            {
+                break;
+            }
+
+            uint8_t const marker = data[offset + 1U];
+            if (0X00U == marker)
+            {
+                // stuffed zero byte
+                offset += 2U;
+            }
+            else if (0XFFU == marker)
+            {
+                // fill byte
+                ++offset;
+            }
+            else if ((marker >= 0XD0U) && (marker <= 0XD7U))
+            {
+                restart_layout->restart_marker_offsets.push_back(offset);
+                offset += 2U;
+            }
+            else if (0XD9U == marker)
+            {
+                restart_layout->eoi_offset = offset;
+                found_eoi = true;
+                break;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        if (!found_eoi)
+        {
+            return false;
+        }
+    }
+
+    uint32_t const mcus_per_row = (width + (mcu_width - 1U)) / mcu_width;
+    uint32_t const mcu_rows = (height + (mcu_height - 1U)) / mcu_height;
+    uint64_t const mcu_count = static_cast<uint64_t>(mcus_per_row) * static_cast<uint64_t>(mcu_rows);
+
+    restart_layout->restart_interval_count = static_cast<uint32_t>((mcu_count + (restart_interval - 1U)) / restart_interval);
+    if (restart_layout->restart_marker_offsets.size() != (static_cast<size_t>(restart_layout->restart_interval_count) - 1U))
+    {
+        return false;
+    }
+
+    uint32_t mcu_rows_per_group;
+    if (0U == (restart_interval % mcus_per_row))
+    {
+        // each restart interval contains the whole MCU rows
+        restart_layout->intervals_per_group = 1U;
+        mcu_rows_per_group = restart_interval / mcus_per_row;
+    }
+    else if (0U == (mcus_per_row % restart_interval))
+    {
+        // each MCU row contains the whole restart intervals
+        restart_layout->intervals_per_group = mcus_per_row / restart_interval;
+        mcu_rows_per_group = 1U;
+    }
+    else
+    {
+        // the restart interval does NOT start at the MCU row boundary
+        return false;
+    }
+
+    restart_layout->group_height = mcu_height * mcu_rows_per_group;
+    restart_layout->group_count = (mcu_rows + (mcu_rows_per_group - 1U)) / mcu_rows_per_group;
+    return true;
+}
+
+static void _internal_jpeg_stripe_decode_task_function(uint32_t task_index, void *user_data)
+{
+    _internal_jpeg_stripe_decode_context const *const context = static_cast<_internal_jpeg_stripe_decode_context const *>(user_data);
+    _internal_jpeg_restart_layout const *const restart_layout = context->restart_layout;
+    uint8_t const *const data = context->data_base;
+
+    uint32_t const output_group_begin = context->groups_per_stripe * task_index;
+    uint32_t const output_group_end = std::min(output_group_begin + context->groups_per_stripe, restart_layout->group_count);
+
+    // one more group on each side is decoded (and discarded) since the fancy upsampling of the chroma uses the adjacent rows
+    uint32_t const decode_group_begin = (output_group_begin > 0U) ? (output_group_begin - 1U) : 0U;
+    uint32_t const decode_group_end = std::min(output_group_end + 1U, restart_layout->group_count);
+
+    // the SOF height of the stripe is NOT scaled
+    uint32_t const decode_row_begin = restart_layout->group_height * decode_group_begin;
+    uint32_t const decode_row_end = std::min(restart_layout->group_height * decode_group_end, restart_layout->image_height);
+    uint32_t const decode_height = decode_row_end - decode_row_begin;
+
+    // the rows of the output are scaled
+    uint32_t const scaled_group_height = _internal_jpeg_scaled_size(restart_layout->group_height, context->scale_num);
+    uint32_t const scaled_output_row_begin = scaled_group_height * output_group_begin;
+    uint32_t const scaled_output_row_end = std::min(scaled_group_height * output_group_end, context->scaled_height);
+    uint32_t const scaled_decode_row_begin = scaled_group_height * decode_group_begin;
+    uint32_t const scaled_decode_height = _internal_jpeg_scaled_size(decode_height, context->scale_num);
+
+    uint32_t const interval_begin = restart_layout->intervals_per_group * decode_group_begin;
+    uint32_t const interval_end = std::min(restart_layout->intervals_per_group * decode_group_end, restart_layout->restart_interval_count);
+
+    size_t const entropy_begin = (interval_begin > 0U) ? (restart_layout->restart_marker_offsets[interval_begin - 1U] + 2U) : restart_layout->scan_offset;
+    size_t const entropy_end = (interval_end < restart_layout->restart_interval_count) ? restart_layout->restart_marker_offsets[interval_end - 1U] : restart_layout->eoi_offset;
+
+    // header (with the height of the stripe) + entropy coded data of the restart intervals + EOI
+    mcrt_vector<uint8_t> stripe_data(restart_layout->scan_offset + (entropy_end - entropy_begin) + 2U);
+    std::memcpy(stripe_data.data(), data, restart_layout->scan_offset);
+    stripe_data[restart_layout->sof_offset + 5U] = static_cast<uint8_t>((decode_height >> 8U) & 0XFFU);
+    stripe_data[restart_layout->sof_offset + 6U] = static_cast<uint8_t>(decode_height & 0XFFU);
+    std::memcpy(stripe_data.data() + restart_layout->scan_offset, data + entropy_begin, entropy_end - entropy_begin);
+    stripe_data[stripe_data.size() - 2U] = 0XFFU;
+    stripe_data[stripe_data.size() - 1U] = 0XD9U;
+
+    // the RST markers are renumbered since the libjpeg expects the first RST marker of the stripe to be RST0
+    for (uint32_t interval_index = interval_begin; (interval_index + 1U) < interval_end; ++interval_index)
+    {
+        size_t const restart_marker_offset = restart_layout->restart_marker_offsets[interval_index] - entropy_begin + restart_layout->scan_offset;
+        assert(0XFFU == stripe_data[restart_marker_offset]);
+        stripe_data[restart_marker_offset + 1U] = static_cast<uint8_t>(0XD0U + ((interval_index - interval_begin) & 7U));
+    }
+
+    bool const status_decode_rows = _internal_libjpeg_decode_rows(stripe_data.data(), stripe_data.size(), context->scale_num, context->scaled_width, scaled_decode_height, scaled_output_row_begin - scaled_decode_row_begin, scaled_output_row_end - scaled_output_row_begin, context->out_rgba_data_base + context->out_row_pitch * scaled_output_row_begin, context->out_row_pitch);
+
+    context->stripe_status[task_index] = status_decode_rows ? 1U : 0U;
+}
+
+static inline uint32_t _internal_jpeg_scaled_size(uint32_t size, uint32_t scale_num)
+{
+    // jutils.c: jdiv_round_up
+    return static_cast<uint32_t>((static_cast<uint64_t>(size) * static_cast<uint64_t>(scale_num) + (DCTSIZE - 1U)) / DCTSIZE);
 }
@@ -18,10 +18,30 @@
 #ifndef _INTERNAL_IMPORT_JPEG_IMAGE_H_
 #define _INTERNAL_IMPORT_JPEG_IMAGE_H_ 1
 
+#include "../include/import_asset_task_scheduler.h"
 #include "../../McRT-Malloc/include/mcrt_vector.h"
 #include <cstddef>
 #include <cstdint>
 
+// read the header only and NO pixel is decoded
+// the channel count is the count of the channels stored in the file (the decoded image is always RGBA8)
+extern bool internal_import_jpeg_image_header(void const *data_base, size_t data_size, uint32_t *out_width, uint32_t *out_height, uint32_t *out_channel_count);
+
 extern bool internal_import_jpeg_image(void const *data_base, size_t data_size, mcrt_vector<uint32_t> &out_rgba_data, uint32_t *out_width, uint32_t *out_height);
 
+// decode the RGBA8 pixels directly into the caller provided memory (e.g. the staging upload buffer) and NO intermediate image is allocated
+// the "width" and "height" should be the same as the header (e.g. returned by the "internal_import_jpeg_image_header")
+extern bool internal_import_jpeg_image_into(void const *data_base, size_t data_size, uint32_t width, uint32_t height, void *out_rgba_data_base, size_t out_row_pitch);
+
+// the baseline JPEG with the restart markers (aligned with the MCU rows) is split into the stripes which are decoded in parallel on the "task_scheduler"
+// fall back to the serial decoding if the JPEG can NOT be split (e.g. progressive or without the restart markers) or the "task_scheduler" is NULL
+extern bool internal_import_jpeg_image_into_parallel(void const *data_base, size_t data_size, uint32_t width, uint32_t height, void *out_rgba_data_base, size_t out_row_pitch, import_asset_task_scheduler *task_scheduler);
+
+// the size of the image decoded at the reduced resolution "scale_num / 8" (the "scale_num" is from 1 to 8)
+extern void internal_import_jpeg_image_scaled_size(uint32_t width, uint32_t height, uint32_t scale_num, uint32_t *out_scaled_width, uint32_t *out_scaled_height);
+
+// the IDCT of the libjpeg outputs the reduced resolution directly (e.g. when the image is to be downsampled anyway) which is much faster than decoding at the full resolution
+// the "scaled_width" and "scaled_height" should be the same as returned by the "internal_import_jpeg_image_scaled_size"
+extern bool internal_import_jpeg_image_scaled_into_parallel(void const *data_base, size_t data_size, uint32_t scale_num, uint32_t scaled_width, uint32_t scaled_height, void *out_rgba_data_base, size_t out_row_pitch, import_asset_task_scheduler *task_scheduler);
+
 #endif
\ No newline at end of file
@@ -38,7 +38,111 @@ struct _internal_libpng_read_data_context
 
 static void PNGCBAPI _internal_libpng_read_data_callback(png_structp png_ptr, png_bytep data, size_t length);
 
+extern bool internal_import_png_image_header(void const *data_base, size_t data_size, uint32_t *out_width, uint32_t *out_height, uint32_t *out_channel_count)
+{
+    // only the chunks before the IDAT chunk are read by the "png_read_info" (NO pixel is decoded)
+
+    png_structp png_ptr = NULL;
+    png_infop header_info_ptr = NULL;
+    bool has_error = false;
+    try
+    {
+        png_ptr = png_create_read_struct_2(PNG_LIBPNG_VER_STRING, NULL, _internal_libpng_error_callback, NULL, NULL, _internal_libpng_malloc_callback, _internal_libpng_free_ptr);
+
+        if ((png_get_chunk_malloc_max(png_ptr) < data_size) && (data_size < (1U << 24)))
+        {
+            png_set_chunk_malloc_max(png_ptr, data_size);
+        }
+
+        _internal_libpng_read_data_context read_data_context = {data_base, data_size, 0};
+
+        png_set_read_fn(png_ptr, &read_data_context, _internal_libpng_read_data_callback);
+
+        header_info_ptr = png_create_info_struct(png_ptr);
+        png_read_info(png_ptr, header_info_ptr);
+
+        png_uint_32 width;
+        png_uint_32 height;
+        int bit_depth;
+        int color_type;
+        int interlaced;
+
+        if (!png_get_IHDR(png_ptr, header_info_ptr, &width, &height, &bit_depth, &color_type, &interlaced, NULL, NULL))
+        {
+            throw std::runtime_error("png get IHDR");
+        }
+
+        if ((width > k_max_width_or_height) || (height > k_max_width_or_height))
+        {
+            throw std::runtime_error("Size Overflow");
+        }
+
+        if ((0U == width) || (0U == height))
+        {
+            throw std::runtime_error("Size Zero");
+        }
+
+        // the tRNS chunk is expanded into the alpha channel by the "internal_import_png_image"
+        uint32_t channel_count;
+        if (PNG_COLOR_TYPE_GRAY == color_type)
+        {
+            channel_count = png_get_valid(png_ptr, header_info_ptr, PNG_INFO_tRNS) ? 2U : 1U;
+        }
+        else if (PNG_COLOR_TYPE_GRAY_ALPHA == color_type)
+        {
+            channel_count = 2U;
+        }
+        else if ((PNG_COLOR_TYPE_PALETTE == color_type) || (PNG_COLOR_TYPE_RGB == color_type))
+        {
+            channel_count = png_get_valid(png_ptr, header_info_ptr, PNG_INFO_tRNS) ? 4U : 3U;
+        }
+        else
+        {
+            assert(PNG_COLOR_TYPE_RGB_ALPHA == color_type);
+            channel_count = 4U;
+        }
+
+        (*out_width) = width;
+        (*out_height) = height;
+        (*out_channel_count) = channel_count;
+    }
+    catch (std::runtime_error exception)
+    {
+        std::cout << exception.what() << std::endl;
+
+        has_error = true;
+    }
+
+    png_destroy_info_struct(png_ptr, &header_info_ptr);
+
+    png_destroy_read_struct(&png_ptr, &header_info_ptr, NULL);
+
+    return (!has_error);
+}
+
 extern bool internal_import_png_image(void const *data_base, size_t data_size, mcrt_vector<uint32_t> &out_rgba_data, uint32_t *out_width, uint32_t *out_height)
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t channel_count;
+    if (!internal_import_png_image_header(data_base, data_size, &width, &height, &channel_count))
+    {
+        return false;
+    }
+
+    out_rgba_data.resize(static_cast<size_t>(width) * static_cast<size_t>(height));
+
+    if (!internal_import_png_image_into(data_base, data_size, width, height, out_rgba_data.data(), sizeof(uint32_t) * static_cast<size_t>(width)))
+    {
+        return false;
+    }
+
+    (*out_width) = width;
+    (*out_height) = height;
+    return true;
+}
+
+extern bool internal_import_png_image_into(void const *data_base, size_t data_size, uint32_t width, uint32_t height, void *out_rgba_data_base, size_t out_row_pitch)
 {
     // http://www.libpng.org/pub/png/spec/1.2/PNG-Chunks.html
     // https://github.com/pnggroup/libpng/blob/libpng16/libpng-manual.txt
@@ -65,13 +169,13 @@ extern bool internal_import_png_image(void const *data_base, size_t data_size, m
         header_info_ptr = png_create_info_struct(png_ptr);
         png_read_info(png_ptr, header_info_ptr);
 
-        png_uint_32 width;
-        png_uint_32 height;
+        png_uint_32 image_width;
+        png_uint_32 image_height;
         int bit_depth;
         int color_type;
         int interlaced;
 
-        if (!png_get_IHDR(png_ptr, header_info_ptr, &width, &height, &bit_depth, &color_type, &interlaced, NULL, NULL))
+        if (!png_get_IHDR(png_ptr, header_info_ptr, &image_width, &image_height, &bit_depth, &color_type, &interlaced, NULL, NULL))
         {
             throw std::runtime_error("png get IHDR");
         }
@@ -154,19 +258,14 @@ extern bool internal_import_png_image(void const *data_base, size_t data_size, m
         // perform all transforms
         png_read_update_info(png_ptr, header_info_ptr);
 
-        if (!png_get_IHDR(png_ptr, header_info_ptr, &width, &height, &bit_depth, &color_type, &interlaced, NULL, NULL))
+        if (!png_get_IHDR(png_ptr, header_info_ptr, &image_width, &image_height, &bit_depth, &color_type, &interlaced, NULL, NULL))
         {
             throw std::runtime_error("png_get_IHDR");
         }
 
-        if ((width > k_max_width_or_height) || (height > k_max_width_or_height))
-        {
-            throw std::runtime_error("Size Overflow");
-        }
-
-        if ((0U == width) || (0U == height))
+        if ((image_width != width) || (image_height != height))
         {
-            throw std::runtime_error("Size Zero");
+            throw std::runtime_error("Size Mismatch");
         }
 
         if (!((PNG_COLOR_TYPE_RGB_ALPHA == color_type) && (k_num_channels == png_get_channels(png_ptr, header_info_ptr)) && ((8 * k_channel_size) == bit_depth)))
@@ -174,24 +273,18 @@ extern bool internal_import_png_image(void const *data_base, size_t data_size, m
             throw std::runtime_error("NOT RGBA8 Format");
         }
 
-        uint64_t const _uint64_stride = static_cast<uint64_t>(k_channel_size) * static_cast<uint64_t>(k_num_channels) * static_cast<uint64_t>(width);
-        uint64_t const _uint64_num_pixels = static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
-
-        uintptr_t const stride = static_cast<uintptr_t>(_uint64_stride);
-        size_t const num_pixels = static_cast<size_t>(_uint64_num_pixels);
-
-        if (!((stride == _uint64_stride) && (num_pixels == _uint64_num_pixels)))
+        if (out_row_pitch < (static_cast<size_t>(k_channel_size) * static_cast<size_t>(k_num_channels) * static_cast<size_t>(width)))
         {
-            throw std::runtime_error("Size Arguments Overflow");
+            throw std::runtime_error("Row Pitch Underflow");
         }
 
-        out_rgba_data.resize(num_pixels);
-
+        // the rows are written directly into the output (e.g. the staging upload buffer)
+        // the interlaced image is combined in place by the following passes
         for (int pass_index = 0; pass_index < num_passes; ++pass_index)
         {
             for (png_uint_32 height_index = 0U; height_index < height; ++height_index)
             {
-                png_bytep row = reinterpret_cast<png_bytep>(reinterpret_cast<uintptr_t>(out_rgba_data.data()) + stride * height_index);
+                png_bytep row = reinterpret_cast<png_bytep>(reinterpret_cast<uintptr_t>(out_rgba_data_base) + out_row_pitch * height_index);
                 png_read_rows(png_ptr, &row, NULL, 1);
             }
         }
@@ -199,9 +292,6 @@ extern bool internal_import_png_image(void const *data_base, size_t data_size, m
         // we only need the header info
         // we do NOT need the end info
         // png_read_end(st, end_info);
-
-        (*out_width) = width;
-        (*out_height) = height;
     }
     catch (std::runtime_error exception)
     {
@@ -22,6 +22,14 @@
 #include <cstddef>
 #include <cstdint>
 
+// read the header only and NO pixel is decoded
+// the channel count is the count of the channels stored in the file (the decoded image is always RGBA8)
+extern bool internal_import_png_image_header(void const* data_base, size_t data_size, uint32_t* out_width, uint32_t* out_height, uint32_t* out_channel_count);
+
 extern bool internal_import_png_image(void const* data_base, size_t data_size, mcrt_vector<uint32_t>& out_rgba_data, uint32_t* out_width, uint32_t* out_height);
 
+// decode the RGBA8 pixels directly into the caller provided memory (e.g. the staging upload buffer) and NO intermediate image is allocated
+// the "width" and "height" should be the same as the header (e.g. returned by the "internal_import_png_image_header")
+extern bool internal_import_png_image_into(void const* data_base, size_t data_size, uint32_t width, uint32_t height, void* out_rgba_data_base, size_t out_row_pitch);
+
 #endif
\ No newline at end of file
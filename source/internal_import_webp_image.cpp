@@ -15,33 +15,30 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 //
 
-#include "internal_import_png_image.h"
+#include "internal_import_webp_image.h"
 #include "internal_import_image_config.h"
 #include <cassert>
+#include <climits>
 #include <iostream>
 #include <stdexcept>
 #include "../../McRT-Malloc/include/mcrt_malloc.h"
 #include "../thirdparty/libwebp/src/webp/decode.h"
 
-extern bool internal_import_webp_image(void const *data_base, size_t data_size, mcrt_vector<uint32_t> &out_rgba_data, uint32_t *out_width, uint32_t *out_height)
+extern bool internal_import_webp_image_header(void const *data_base, size_t data_size, uint32_t *out_width, uint32_t *out_height, uint32_t *out_channel_count)
 {
-	int width = -1;
-	int height = -1;
-	uint8_t *rgba_data = WebPDecodeRGBA(static_cast<uint8_t const *>(data_base), data_size, &width, &height);
-	if (NULL != rgba_data)
+	// only the RIFF header and the VP8X / VP8 / VP8L chunk header are parsed by the "WebPGetFeatures" (NO pixel is decoded)
+	WebPBitstreamFeatures features;
+	if (VP8_STATUS_OK == WebPGetFeatures(static_cast<uint8_t const *>(data_base), data_size, &features))
 	{
-		if ((width > 0) && (width <= k_max_width_or_height) && (height > 0) && (height < k_max_width_or_height))
+		if ((features.width > 0) && (features.width <= k_max_width_or_height) && (features.height > 0) && (features.height <= k_max_width_or_height))
 		{
-			out_rgba_data.resize(static_cast<size_t>(width) * static_cast<size_t>(height));
-			std::memcpy(out_rgba_data.data(), rgba_data, sizeof(uint32_t) * static_cast<size_t>(width) * static_cast<size_t>(height));
-			WebPFree(rgba_data);
-			(*out_width) = width;
-			(*out_height) = height;
+			(*out_width) = features.width;
+			(*out_height) = features.height;
+			(*out_channel_count) = features.has_alpha ? 4U : 3U;
 			return true;
 		}
 		else
 		{
-			WebPFree(rgba_data);
 			return false;
 		}
 	}
@@ -49,4 +46,45 @@ extern bool internal_import_webp_image(void const *data_base, size_t data_size,
 	{
 		return false;
 	}
-}
\ No newline at end of file
+}
+
+extern bool internal_import_webp_image(void const *data_base, size_t data_size, mcrt_vector<uint32_t> &out_rgba_data, uint32_t *out_width, uint32_t *out_height)
+{
+	uint32_t width;
+	uint32_t height;
+	uint32_t channel_count;
+	if (!internal_import_webp_image_header(data_base, data_size, &width, &height, &channel_count))
+	{
+		return false;
+	}
+
+	out_rgba_data.resize(static_cast<size_t>(width) * static_cast<size_t>(height));
+
+	if (!internal_import_webp_image_into(data_base, data_size, width, height, out_rgba_data.data(), sizeof(uint32_t) * static_cast<size_t>(width)))
+	{
+		return false;
+	}
+
+	(*out_width) = width;
+	(*out_height) = height;
+	return true;
+}
+
+extern bool internal_import_webp_image_into(void const *data_base, size_t data_size, uint32_t width, uint32_t height, void *out_rgba_data_base, size_t out_row_pitch)
+{
+	int image_width = -1;
+	int image_height = -1;
+	if (!WebPGetInfo(static_cast<uint8_t const *>(data_base), data_size, &image_width, &image_height))
+	{
+		return false;
+	}
+
+	if ((static_cast<uint32_t>(image_width) != width) || (static_cast<uint32_t>(image_height) != height) || (out_row_pitch < (sizeof(uint32_t) * static_cast<size_t>(width))) || (out_row_pitch > static_cast<size_t>(INT_MAX)))
+	{
+		return false;
+	}
+
+	// the pixels are written directly into the output (e.g. the staging upload buffer) instead of the buffer allocated by the libwebp
+	size_t const output_buffer_size = out_row_pitch * (static_cast<size_t>(height) - 1U) + sizeof(uint32_t) * static_cast<size_t>(width);
+	return (NULL != WebPDecodeRGBAInto(static_cast<uint8_t const *>(data_base), data_size, static_cast<uint8_t *>(out_rgba_data_base), output_buffer_size, static_cast<int>(out_row_pitch)));
+}